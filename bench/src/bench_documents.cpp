@@ -0,0 +1,111 @@
+#include "bench_documents.hpp"
+
+// Benchmark documents - deterministic text builders for each input shape
+
+namespace yamlbench {
+
+namespace {
+// Appends one scalar value, cycling through the scalar types the parser knows
+void appendScalar(std::string &out, size_t i) {
+  switch (i % 4) {
+  case 0:
+    out += std::to_string(i * 7);
+    break;
+  case 1:
+    out += std::to_string(i) + ".25";
+    break;
+  case 2:
+    out += "value_" + std::to_string(i);
+    break;
+  default:
+    out += (i % 8 == 3) ? "true" : "false";
+    break;
+  }
+}
+
+void appendNested(std::string &out, size_t level, size_t depth, size_t width, const std::string &indent) {
+  for (size_t w = 0; w < width; ++w) {
+    out += indent + "k" + std::to_string(level) + "_" + std::to_string(w) + ":";
+    if (level + 1 < depth) {
+      out += "\n";
+      appendNested(out, level + 1, depth, width, indent + "  ");
+    } else {
+      out += " ";
+      appendScalar(out, level * width + w);
+      out += "\n";
+    }
+  }
+}
+} // anonymous namespace
+
+/**
+ * @brief A single wide mapping of scalar values
+ * @param keys Number of keys
+ * @return YAML text
+ */
+std::string flatMap(size_t keys) {
+  std::string out;
+  for (size_t i = 0; i < keys; ++i) {
+    out += "key_" + std::to_string(i) + ": ";
+    appendScalar(out, i);
+    out += "\n";
+  }
+  return out;
+}
+
+/**
+ * @brief Nested mappings, width^depth leaves
+ * @param depth Number of mapping levels
+ * @param width Keys per mapping
+ * @return YAML text
+ */
+std::string deepNesting(size_t depth, size_t width) {
+  std::string out;
+  appendNested(out, 0, depth, width, "");
+  return out;
+}
+
+/**
+ * @brief A long sequence alternating scalars and small mappings
+ * @param items Number of sequence items
+ * @return YAML text
+ */
+std::string longSequence(size_t items) {
+  std::string out = "items:\n";
+  for (size_t i = 0; i < items; ++i) {
+    if (i % 2 == 0) {
+      out += "  - ";
+      appendScalar(out, i);
+      out += "\n";
+    } else {
+      out += "  - id: " + std::to_string(i) + "\n    name: item_" + std::to_string(i) + "\n";
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Anchored templates reused through merge keys and aliases
+ * @param anchors Number of anchored mappings
+ * @param users Number of mappings that merge or alias them
+ * @return YAML text
+ */
+std::string aliasHeavy(size_t anchors, size_t users) {
+  std::string out;
+  for (size_t a = 0; a < anchors; ++a) {
+    std::string n = std::to_string(a);
+    out += "base_" + n + ": &base_" + n + "\n  timeout: " + std::to_string(10 + a) +
+           "\n  retries: 3\n  region: region_" + n + "\n";
+  }
+  for (size_t u = 0; u < users; ++u) {
+    std::string n = std::to_string(u);
+    std::string a = std::to_string(anchors ? u % anchors : 0);
+    if (u % 2 == 0)
+      out += "service_" + n + ":\n  <<: *base_" + a + "\n  name: service_" + n + "\n";
+    else
+      out += "ref_" + n + ": *base_" + a + "\n";
+  }
+  return out;
+}
+
+} // namespace yamlbench
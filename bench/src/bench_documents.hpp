@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @file bench_documents.hpp
+ * @brief YAML documents of known shape used by the benchmarks
+ *
+ * Every builder produces text that the parser supports and whose size
+ * grows linearly with its arguments.
+ */
+
+namespace yamlbench {
+
+std::string flatMap(size_t keys);
+
+std::string deepNesting(size_t depth, size_t width);
+
+std::string longSequence(size_t items);
+
+std::string aliasHeavy(size_t anchors, size_t users);
+
+} // namespace yamlbench
@@ -0,0 +1,200 @@
+#include "bench_support.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Benchmark support - allocation counting, RSS and JSON output
+// Key features:
+// - Global operator new/delete are replaced for the whole benchmark binary;
+//   each block carries a small header with its size so that frees can be
+//   subtracted from the live byte count
+// - Counters are atomics so that multi-threaded workloads stay correct
+
+namespace yamlbench {
+
+volatile size_t g_sink = 0;
+
+namespace {
+// Header size keeps the returned pointer aligned for any fundamental type
+const size_t HEADER_SIZE = 16;
+
+std::atomic<size_t> g_count(0);
+std::atomic<size_t> g_bytes(0);
+std::atomic<size_t> g_live(0);
+std::atomic<size_t> g_peak(0);
+
+void *countedAlloc(size_t size) {
+  void *block = std::malloc(size + HEADER_SIZE);
+  if (!block)
+    return nullptr;
+  *static_cast<size_t *>(block) = size;
+  g_count.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  size_t live = g_live.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = g_peak.load(std::memory_order_relaxed);
+  while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+  return static_cast<char *>(block) + HEADER_SIZE;
+}
+
+void countedFree(void *ptr) {
+  if (!ptr)
+    return;
+  void *block = static_cast<char *>(ptr) - HEADER_SIZE;
+  g_live.fetch_sub(*static_cast<size_t *>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+void *throwingAlloc(size_t size) {
+  void *ptr = countedAlloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+} // anonymous namespace
+
+/**
+ * @brief Resets the allocation counters; the peak restarts at the live byte count
+ */
+void resetAllocStats() {
+  g_count.store(0);
+  g_bytes.store(0);
+  g_peak.store(g_live.load());
+}
+
+/**
+ * @brief Get the allocation counters
+ * @return Allocations since the last reset (peakLive excludes memory live at reset)
+ */
+AllocStats allocStats() {
+  AllocStats stats;
+  stats.count    = g_count.load();
+  stats.bytes    = g_bytes.load();
+  size_t peak    = g_peak.load();
+  size_t live    = g_live.load();
+  stats.peakLive = peak > live ? peak - live : 0;
+  return stats;
+}
+
+/**
+ * @brief Get the peak resident set size of the process
+ * @return Peak RSS in KiB, or 0 where it cannot be measured
+ */
+long peakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return static_cast<long>(usage.ru_maxrss / 1024); // bytes on macOS
+#else
+  return static_cast<long>(usage.ru_maxrss);
+#endif
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Writes a JSON string literal
+ * @param os Output stream
+ * @param s Text to quote; only '"' and '\\' are escaped, which is enough for benchmark names
+ */
+void writeString(std::ostream &os, const std::string &s) {
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  os << '"';
+}
+
+/**
+ * @brief Writes a JSON number with six significant digits
+ * @param os Output stream
+ * @param value Number to write
+ */
+void writeNumber(std::ostream &os, double value) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.6g", value);
+  os << buf;
+}
+
+/**
+ * @brief Writes benchmark results as a JSON document
+ * @param results Results to write
+ * @param os Output stream
+ * @details Rates are derived from the fastest iteration: mb_per_s when bytes
+ *          are set, ns_per_op when operations are set.
+ */
+void writeJson(const std::vector<BenchResult> &results, std::ostream &os) {
+  os << "{\n  \"peak_rss_kb\": " << peakRssKb() << ",\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult &r = results[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    writeString(os, r.name);
+    os << ", \"iterations\": " << r.iterations << ", \"best_s\": ";
+    writeNumber(os, r.bestSeconds);
+    os << ", \"mean_s\": ";
+    writeNumber(os, r.meanSeconds);
+    if (r.bytes > 0) {
+      os << ", \"bytes\": " << r.bytes << ", \"mb_per_s\": ";
+      writeNumber(os, r.bestSeconds > 0 ? static_cast<double>(r.bytes) / r.bestSeconds / 1e6 : 0);
+    }
+    if (r.operations > 0) {
+      os << ", \"operations\": " << r.operations << ", \"ns_per_op\": ";
+      writeNumber(os, r.bestSeconds * 1e9 / static_cast<double>(r.operations));
+    }
+    os << ", \"allocations\": " << r.allocs.count << ", \"allocated_bytes\": " << r.allocs.bytes
+       << ", \"peak_live_bytes\": " << r.allocs.peakLive << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+} // namespace yamlbench
+
+void *operator new(size_t size) {
+  return yamlbench::throwingAlloc(size);
+}
+
+void *operator new[](size_t size) {
+  return yamlbench::throwingAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return yamlbench::countedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return yamlbench::countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  yamlbench::countedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  yamlbench::countedFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  yamlbench::countedFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  yamlbench::countedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  yamlbench::countedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  yamlbench::countedFree(ptr);
+}
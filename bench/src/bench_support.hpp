@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file bench_support.hpp
+ * @brief Measurement helpers for the benchmark suite
+ *
+ * Provides functionality to:
+ * - Count heap allocations made through global operator new
+ * - Read the peak resident set size of the process
+ * - Time a workload over several iterations
+ * - Write the collected results as JSON
+ */
+
+namespace yamlbench {
+
+/**
+ * @brief Heap allocation counters since the last resetAllocStats()
+ */
+struct AllocStats {
+  /** @brief Number of allocations */
+  size_t count = 0;
+  /** @brief Total bytes requested */
+  size_t bytes = 0;
+  /** @brief Highest number of bytes live at the same time */
+  size_t peakLive = 0;
+};
+
+void resetAllocStats();
+
+AllocStats allocStats();
+
+long peakRssKb();
+
+/**
+ * @brief Result of one benchmark
+ */
+struct BenchResult {
+  /** @brief Benchmark name, e.g. "parse/flat_map" */
+  std::string name;
+  /** @brief Number of timed iterations */
+  size_t iterations = 0;
+  /** @brief Input or output bytes processed per iteration (0 if not meaningful) */
+  size_t bytes = 0;
+  /** @brief Operations per iteration (0 if not meaningful) */
+  size_t operations = 0;
+  /** @brief Fastest iteration in seconds */
+  double bestSeconds = 0;
+  /** @brief Mean iteration time in seconds */
+  double meanSeconds = 0;
+  /** @brief Allocations made by one iteration */
+  AllocStats allocs;
+};
+
+/**
+ * @brief Runs a workload and records its timing and allocations
+ * @param name Benchmark name
+ * @param iterations Number of timed iterations (at least 1)
+ * @param bytes Bytes processed per iteration
+ * @param operations Operations per iteration
+ * @param fn Workload to run once per iteration
+ * @return The measured result (allocations are those of the last iteration)
+ */
+template <typename Fn>
+BenchResult measure(const std::string &name, size_t iterations, size_t bytes, size_t operations, Fn fn) {
+  BenchResult result;
+  result.name       = name;
+  result.iterations = iterations < 1 ? 1 : iterations;
+  result.bytes      = bytes;
+  result.operations = operations;
+  double total      = 0;
+  for (size_t i = 0; i < result.iterations; ++i) {
+    resetAllocStats();
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.allocs                         = allocStats();
+    total += elapsed.count();
+    if (i == 0 || elapsed.count() < result.bestSeconds)
+      result.bestSeconds = elapsed.count();
+  }
+  result.meanSeconds = total / static_cast<double>(result.iterations);
+  return result;
+}
+
+void writeString(std::ostream &os, const std::string &s);
+
+void writeNumber(std::ostream &os, double value);
+
+void writeJson(const std::vector<BenchResult> &results, std::ostream &os);
+
+/** @brief Sink that keeps the compiler from discarding benchmark work */
+extern volatile size_t g_sink;
+
+} // namespace yamlbench
@@ -0,0 +1,305 @@
+#include "corpus_generator.hpp"
+#include <sstream>
+
+// Corpus generator - seeded synthetic YAML documents
+// Key features:
+// - Own xorshift64* generator and integer-only value formatting, so the
+//   output does not depend on the standard library's distributions or locale
+// - Output is buffered and streamed, sized by top-level sections
+// - Aliases only refer to anchors whose mapping is complete, never to an
+//   enclosing one
+
+namespace yamlbench {
+
+namespace {
+const size_t FLUSH_SIZE = 1 << 20;
+
+const char *const WORDS[] = {"server",  "client",   "timeout", "retries", "region",  "cache",  "limit",    "buffer",
+                             "replica", "endpoint", "token",   "policy",  "metrics", "worker", "queue",    "route",
+                             "storage", "backup",   "schema",  "index",   "shard",   "level",  "format",   "target",
+                             "source",  "window",   "channel", "session", "tenant",  "quota",  "priority", "label"};
+
+const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+} // anonymous namespace
+
+/**
+ * @brief Constructs a generator for a shape
+ * @param shape Document shape; fanOut and sequenceLength below 1 are treated as 1
+ */
+CorpusGenerator::CorpusGenerator(const CorpusShape &shape) : m_shape(shape) {
+  if (m_shape.fanOut == 0)
+    m_shape.fanOut = 1;
+  if (m_shape.sequenceLength == 0)
+    m_shape.sequenceLength = 1;
+}
+
+/**
+ * @brief Writes one document
+ * @param os Output stream
+ * @return Number of bytes written
+ * @details Restarts from the seed, so repeated calls write the same document.
+ */
+std::uint64_t CorpusGenerator::generate(std::ostream &os) {
+  // splitmix64 step so that small seeds still give a well mixed state
+  std::uint64_t z = m_shape.seed + 0x9E3779B97F4A7C15ull;
+  z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z               = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  m_state         = (z ^ (z >> 31)) | 1;
+  m_buffer.clear();
+  m_out         = &os;
+  m_written     = 0;
+  m_anchorCount = 0;
+  m_anchors.clear();
+
+  for (size_t section = 0; section == 0 || m_written + m_buffer.size() < m_shape.targetBytes; ++section) {
+    m_buffer += "section_" + std::to_string(section) + ":\n";
+    appendMap(2, m_shape.depth);
+    flush(false);
+  }
+  flush(true);
+  m_out = nullptr;
+  return m_written;
+}
+
+/**
+ * @brief Generates one document into a string
+ * @return YAML text
+ */
+std::string CorpusGenerator::generate() {
+  std::ostringstream os;
+  generate(os);
+  return os.str();
+}
+
+/**
+ * @brief Advances the xorshift64* generator
+ * @return Next 64-bit value
+ */
+std::uint64_t CorpusGenerator::next() {
+  m_state ^= m_state >> 12;
+  m_state ^= m_state << 25;
+  m_state ^= m_state >> 27;
+  return m_state * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Uniform value in [0, bound)
+ * @param bound Exclusive upper bound (must be positive)
+ * @return Random value
+ */
+size_t CorpusGenerator::below(size_t bound) {
+  return static_cast<size_t>(next() % bound);
+}
+
+/**
+ * @brief Bernoulli trial
+ * @param probability Chance of returning true
+ * @return true with the given probability
+ */
+bool CorpusGenerator::chance(double probability) {
+  return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
+/**
+ * @brief Uniform value in [1, 2 * mean - 1], averaging mean
+ * @param mean Average value (at least 1)
+ * @return Random value
+ */
+size_t CorpusGenerator::around(size_t mean) {
+  return 1 + below(2 * mean - 1);
+}
+
+/**
+ * @brief Writes the buffer to the stream once it is large enough
+ * @param force Write whatever is buffered
+ */
+void CorpusGenerator::flush(bool force) {
+  if (!force && m_buffer.size() < FLUSH_SIZE)
+    return;
+  m_out->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_written += m_buffer.size();
+  m_buffer.clear();
+}
+
+void CorpusGenerator::appendIndent(size_t indent) {
+  m_buffer.append(indent, ' ');
+}
+
+void CorpusGenerator::appendWords(size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0)
+      m_buffer += ' ';
+    m_buffer += WORDS[below(WORD_COUNT)];
+  }
+}
+
+/**
+ * @brief Appends " <scalar>" chosen by the scalar mix
+ * @param allowNull Whether an empty (null) value may be chosen; nothing is appended for it
+ */
+void CorpusGenerator::appendScalar(bool allowNull) {
+  const ScalarMix &mix   = m_shape.mix;
+  unsigned         nulls = allowNull ? mix.nulls : 0;
+  size_t           total = size_t(mix.ints) + mix.floats + mix.bools + mix.strings + mix.quoted + nulls;
+  if (total == 0) {
+    m_buffer += " 0";
+    return;
+  }
+
+  size_t pick = below(total);
+  if (pick < mix.ints) {
+    m_buffer += below(10) == 0 ? " -" : " ";
+    m_buffer += std::to_string(below(100000));
+    return;
+  }
+  pick -= mix.ints;
+  if (pick < mix.floats) {
+    m_buffer += " " + std::to_string(below(100000)) + "." + std::to_string(below(1000));
+    return;
+  }
+  pick -= mix.floats;
+  if (pick < mix.bools) {
+    m_buffer += below(2) ? " true" : " false";
+    return;
+  }
+  pick -= mix.bools;
+  if (pick < mix.strings) {
+    m_buffer += ' ';
+    appendWords(1 + below(4));
+    return;
+  }
+  pick -= mix.strings;
+  if (pick < mix.quoted) {
+    // Quoted strings may carry characters that would end a plain scalar
+    char quote = below(2) ? '"' : '\'';
+    m_buffer += ' ';
+    m_buffer += quote;
+    appendWords(1 + below(3));
+    if (below(4) == 0)
+      m_buffer += ": #" + std::to_string(below(100));
+    m_buffer += quote;
+  }
+  // remaining weight is the null case, which appends nothing
+}
+
+/**
+ * @brief Appends one item of a flow sequence: an integer, a word or a quoted word
+ */
+void CorpusGenerator::appendFlowScalar() {
+  switch (below(3)) {
+  case 0:
+    m_buffer += std::to_string(below(1000));
+    break;
+  case 1:
+    m_buffer += WORDS[below(WORD_COUNT)];
+    break;
+  default:
+    m_buffer += '"';
+    m_buffer += WORDS[below(WORD_COUNT)];
+    m_buffer += '"';
+    break;
+  }
+}
+
+/**
+ * @brief Appends " |" or " >" and the indented lines of a block scalar
+ * @param indent Indentation of the owning key
+ */
+void CorpusGenerator::appendBlockText(size_t indent) {
+  m_buffer += below(2) ? " |\n" : " >\n";
+  size_t lines = 2 + below(4);
+  for (size_t i = 0; i < lines; ++i) {
+    appendIndent(indent + 2);
+    appendWords(3 + below(6));
+    m_buffer += '\n';
+  }
+}
+
+/**
+ * @brief Appends the value of a mapping key, after the ':'
+ * @param indent Indentation of the key
+ * @param depth Remaining mapping levels allowed below the key
+ */
+void CorpusGenerator::appendValue(size_t indent, size_t depth) {
+  size_t kind = depth > 0 ? below(100) : 100;
+  if (kind < 35) {
+    if (!m_anchors.empty() && chance(m_shape.aliasDensity)) {
+      m_buffer += " *" + m_anchors[below(m_anchors.size())] + "\n";
+    } else if (depth <= 2 && chance(m_shape.aliasDensity)) {
+      std::string name = "a" + std::to_string(m_anchorCount++);
+      m_buffer += " &" + name + "\n";
+      appendMap(indent + 2, depth - 1);
+      // Only the most recent anchors are reused, which keeps references local
+      if (m_anchors.size() < 256)
+        m_anchors.push_back(name);
+      else
+        m_anchors[below(m_anchors.size())] = name;
+    } else {
+      m_buffer += '\n';
+      appendMap(indent + 2, depth - 1);
+    }
+  } else if (kind < 50) {
+    if (below(3) == 0) {
+      m_buffer += " [";
+      size_t items = around(m_shape.sequenceLength);
+      for (size_t i = 0; i < items; ++i) {
+        if (i > 0)
+          m_buffer += ", ";
+        appendFlowScalar();
+      }
+      m_buffer += "]\n";
+    } else {
+      m_buffer += '\n';
+      appendSeq(indent + 2, depth);
+    }
+  } else if (chance(m_shape.literalFrequency)) {
+    appendBlockText(indent);
+  } else {
+    appendScalar(true);
+    m_buffer += '\n';
+  }
+}
+
+/**
+ * @brief Appends a block mapping
+ * @param indent Indentation of its keys
+ * @param depth Remaining mapping levels allowed below its keys
+ */
+void CorpusGenerator::appendMap(size_t indent, size_t depth) {
+  if (!m_anchors.empty() && chance(m_shape.aliasDensity)) {
+    appendIndent(indent);
+    m_buffer += "<<: *" + m_anchors[below(m_anchors.size())] + "\n";
+  }
+  size_t keys = around(m_shape.fanOut);
+  for (size_t i = 0; i < keys; ++i) {
+    appendIndent(indent);
+    m_buffer += WORDS[below(WORD_COUNT)];
+    m_buffer += "_" + std::to_string(i) + ":";
+    appendValue(indent, depth);
+  }
+}
+
+/**
+ * @brief Appends a block sequence of scalars, or of mappings when depth allows
+ * @param indent Indentation of the '-' markers
+ * @param depth Remaining mapping levels allowed for mapping items
+ */
+void CorpusGenerator::appendSeq(size_t indent, size_t depth) {
+  size_t items = around(m_shape.sequenceLength);
+  // Mapping items start with a scalar "id" key and always continue on the
+  // following lines; a lone "- key: value" line would be read as a string
+  bool mappings = depth > 0 && below(2) == 0;
+  for (size_t i = 0; i < items; ++i) {
+    appendIndent(indent);
+    if (mappings) {
+      m_buffer += "- id: " + std::to_string(i) + "\n";
+      appendMap(indent + 2, depth - 1);
+    } else {
+      m_buffer += '-';
+      appendScalar(false);
+      m_buffer += '\n';
+    }
+  }
+}
+
+} // namespace yamlbench
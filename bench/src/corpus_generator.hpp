@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file corpus_generator.hpp
+ * @brief Seeded generator for large synthetic YAML documents
+ *
+ * Produces documents of configurable shape that only use constructs the
+ * parser supports (the ones covered by tests/test_cases/): nested block
+ * mappings, block and flow sequences, sequences of mappings, plain and
+ * quoted scalars, literal (|) and folded (>) blocks, anchors on mappings,
+ * aliases and merge keys. The same shape and seed always produce the same
+ * bytes, on every platform, so large inputs never need to be checked in.
+ *
+ * Usage example:
+ * @code
+ *   CorpusShape shape;
+ *   shape.seed        = 7;
+ *   shape.targetBytes = 64ull << 20;
+ *   CorpusGenerator generator(shape);
+ *   std::ofstream out("corpus.yaml");
+ *   generator.generate(out);
+ * @endcode
+ */
+
+namespace yamlbench {
+
+/**
+ * @brief Relative weights of the scalar types used for leaf values
+ *
+ * A weight of zero disables that type. Quoted strings alternate between
+ * double and single quotes; nulls are written as an empty value.
+ */
+struct ScalarMix {
+  unsigned ints    = 4;
+  unsigned floats  = 2;
+  unsigned bools   = 1;
+  unsigned strings = 4;
+  unsigned quoted  = 2;
+  unsigned nulls   = 1;
+};
+
+/**
+ * @brief Shape of a generated document
+ */
+struct CorpusShape {
+  /** @brief Seed of the random sequence; equal shapes with equal seeds give equal output */
+  std::uint64_t seed = 1;
+  /** @brief Maximum mapping nesting below each top-level section */
+  size_t depth = 4;
+  /** @brief Average number of keys per mapping */
+  size_t fanOut = 5;
+  /** @brief Average number of items per sequence */
+  size_t sequenceLength = 6;
+  /** @brief Scalar type weights */
+  ScalarMix mix;
+  /** @brief Probability that a small mapping is anchored, and that a value reuses an anchor */
+  double aliasDensity = 0.05;
+  /** @brief Probability that a string value is written as a literal or folded block */
+  double literalFrequency = 0.05;
+  /** @brief Output stops at the first top-level section boundary at or past this size */
+  std::uint64_t targetBytes = 1u << 20;
+};
+
+/**
+ * @brief Writes documents of a given CorpusShape
+ *
+ * The document is a mapping of top-level sections ("section_<n>"), each a
+ * random tree bounded by the shape. Output is streamed through a fixed-size
+ * buffer, so documents of several GB need no more memory than one section.
+ * Only mappings at most two levels deep are anchored, which keeps alias
+ * expansion in the parsed tree proportional to the text size.
+ */
+class CorpusGenerator {
+public:
+  explicit CorpusGenerator(const CorpusShape &shape);
+
+  std::uint64_t generate(std::ostream &os);
+
+  std::string generate();
+
+private:
+  std::uint64_t next();
+
+  size_t below(size_t bound);
+
+  bool chance(double probability);
+
+  size_t around(size_t mean);
+
+  void flush(bool force);
+
+  void appendWords(size_t count);
+
+  void appendScalar(bool allowNull);
+
+  void appendFlowScalar();
+
+  void appendBlockText(size_t indent);
+
+  void appendValue(size_t indent, size_t depth);
+
+  void appendMap(size_t indent, size_t depth);
+
+  void appendSeq(size_t indent, size_t depth);
+
+  void appendIndent(size_t indent);
+
+  /** @brief Requested shape */
+  CorpusShape m_shape;
+  /** @brief xorshift64* state */
+  std::uint64_t m_state = 0;
+  /** @brief Pending output */
+  std::string m_buffer;
+  /** @brief Destination of generate(std::ostream &) (null while generating to a string) */
+  std::ostream *m_out = nullptr;
+  /** @brief Bytes produced so far */
+  std::uint64_t m_written = 0;
+  /** @brief Number of anchors defined so far, used for unique names */
+  size_t m_anchorCount = 0;
+  /** @brief Most recent completed anchors that aliases may refer to */
+  std::vector<std::string> m_anchors;
+};
+
+} // namespace yamlbench
@@ -0,0 +1,242 @@
+#include "bench_documents.hpp"
+#include "bench_support.hpp"
+#include "corpus_generator.hpp"
+#include "YamlNumberFormat.hpp"
+#include "YamlParser.hpp"
+#include "YamlPrinter.hpp"
+#include "YamlJsonPrinter.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// yamlparser_bench - throughput, latency and memory benchmarks
+//
+// Usage: yamlparser_bench [--scale N] [--iterations N] [--filter TEXT] [--output FILE]
+//   --scale       multiplies every document size (default 1, about 1 MB per parse input)
+//   --iterations  timed runs per benchmark (default 5); the fastest one is reported
+//   --filter      only run benchmarks whose name contains TEXT
+//   --output      write the JSON report to FILE instead of stdout
+
+using namespace yamlparser;
+using namespace yamlbench;
+
+namespace {
+
+struct Options {
+  size_t      scale      = 1;
+  size_t      iterations = 5;
+  std::string filter;
+  std::string output;
+};
+
+void usage() {
+  std::cerr << "usage: yamlparser_bench [--scale N] [--iterations N] [--filter TEXT] [--output FILE]\n";
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      usage();
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--scale")
+      opts.scale = std::strtoul(value.c_str(), nullptr, 10);
+    else if (arg == "--iterations")
+      opts.iterations = std::strtoul(value.c_str(), nullptr, 10);
+    else if (arg == "--filter")
+      opts.filter = value;
+    else if (arg == "--output")
+      opts.output = value;
+    else {
+      usage();
+      return false;
+    }
+  }
+  if (opts.scale == 0 || opts.iterations == 0) {
+    usage();
+    return false;
+  }
+  return true;
+}
+
+class Suite {
+public:
+  explicit Suite(const Options &opts) : m_opts(opts) {}
+
+  bool enabled(const std::string &name) const {
+    return m_opts.filter.empty() || name.find(m_opts.filter) != std::string::npos;
+  }
+
+  // Lets a group skip its setup work when none of its benchmarks will run
+  bool anyEnabled(std::initializer_list<const char *> names) const {
+    for (const char *name : names) {
+      if (enabled(name))
+        return true;
+    }
+    return false;
+  }
+
+  template <typename Fn> void run(const std::string &name, size_t bytes, size_t operations, Fn fn) {
+    if (!enabled(name))
+      return;
+    std::cerr << "running " << name << "...\n";
+    m_results.push_back(measure(name, m_opts.iterations, bytes, operations, fn));
+  }
+
+  void parse(const std::string &name, const std::string &text) {
+    run(name, text.size(), 0, [&text]() {
+      YamlParser parser;
+      parser.parseString(text);
+      g_sink = g_sink + parser.root().size();
+    });
+  }
+
+  const std::vector<BenchResult> &results() const {
+    return m_results;
+  }
+
+private:
+  const Options           &m_opts;
+  std::vector<BenchResult> m_results;
+};
+
+void runParseBenchmarks(Suite &suite, size_t scale) {
+  if (suite.enabled("parse/flat_map"))
+    suite.parse("parse/flat_map", flatMap(50000 * scale));
+  if (suite.enabled("parse/deep_nesting"))
+    suite.parse("parse/deep_nesting", deepNesting(8, 4 + scale / 4)); // 4^8 leaves at scale 1
+  if (suite.enabled("parse/long_sequence"))
+    suite.parse("parse/long_sequence", longSequence(50000 * scale));
+  if (suite.enabled("parse/alias_heavy"))
+    suite.parse("parse/alias_heavy", aliasHeavy(100, 20000 * scale));
+  if (suite.enabled("parse/corpus_mixed")) {
+    // Mixed realistic shape from the corpus generator; fixed seed keeps runs comparable
+    CorpusShape shape;
+    shape.seed        = 42;
+    shape.targetBytes = (1u << 20) * scale;
+    suite.parse("parse/corpus_mixed", CorpusGenerator(shape).generate());
+  }
+}
+
+void runPrintBenchmarks(Suite &suite, size_t scale) {
+  if (!suite.anyEnabled({"print/yaml", "print/json"}))
+    return;
+  YamlParser parser;
+  parser.parseString(flatMap(50000 * scale) + longSequence(20000 * scale));
+  const YamlMap &root = parser.root();
+  size_t         yaml = YamlPrinter::toString(root).size();
+  size_t         json = YamlJsonPrinter::toString(root).size();
+
+  suite.run("print/yaml", yaml, 0, [&root]() { g_sink = g_sink + YamlPrinter::toString(root).size(); });
+  suite.run("print/json", json, 0, [&root]() { g_sink = g_sink + YamlJsonPrinter::toString(root).size(); });
+}
+
+void runLookupBenchmarks(Suite &suite, size_t scale) {
+  if (!suite.anyEnabled({"lookup/parser_get", "lookup/element_at_path6"}))
+    return;
+  const size_t keys = 50000 * scale;
+  YamlParser   flat;
+  flat.parseString(flatMap(keys));
+  YamlParser deep;
+  deep.parseString(deepNesting(6, 4));
+
+  // Lookup keys are prepared up front so that only the lookups are timed
+  const size_t             lookups = 200000;
+  std::vector<std::string> names;
+  names.reserve(lookups);
+  for (size_t i = 0; i < lookups; ++i)
+    names.push_back("key_" + std::to_string((i * 7919) % keys));
+  const char *path[] = {"k0_1", "k1_2", "k2_3", "k3_0", "k4_1", "k5_2"};
+
+  suite.run("lookup/parser_get", 0, lookups, [&]() {
+    for (const auto &name : names)
+      g_sink = g_sink + static_cast<size_t>(flat.get(name).value.type);
+  });
+  suite.run("lookup/element_at_path6", 0, lookups, [&]() {
+    for (size_t i = 0; i < lookups; ++i) {
+      const YamlItem *item = &YamlElement::at(deep.root(), path[0]);
+      for (size_t d = 1; d < 6; ++d)
+        item = &YamlElement::at(item->value.asMap(), path[d]);
+      g_sink = g_sink + static_cast<size_t>(item->value.type);
+    }
+  });
+}
+
+void runNumberBenchmarks(Suite &suite, size_t scale) {
+  if (!suite.anyEnabled({"number/format_double_short", "number/format_double_full", "number/snprintf_17g_baseline",
+                         "number/format_int"}))
+    return;
+  // Short decimals are typical for configs; full-precision values need 17 digits
+  const size_t        count = 200000 * scale;
+  std::vector<double> shortValues;
+  std::vector<double> fullValues;
+  shortValues.reserve(count);
+  fullValues.reserve(count);
+  unsigned long long state = 88172645463325252ULL;
+  for (size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    shortValues.push_back(static_cast<double>(state % 100000) / 100.0);
+    fullValues.push_back(static_cast<double>(state % 10000000) / 997.0);
+  }
+
+  suite.run("number/format_double_short", 0, count, [&shortValues]() {
+    char buf[YamlNumberFormat::BUFFER_SIZE];
+    for (double v : shortValues)
+      g_sink = g_sink + YamlNumberFormat::formatDouble(v, buf);
+  });
+  suite.run("number/format_double_full", 0, count, [&fullValues]() {
+    char buf[YamlNumberFormat::BUFFER_SIZE];
+    for (double v : fullValues)
+      g_sink = g_sink + YamlNumberFormat::formatDouble(v, buf);
+  });
+  suite.run("number/snprintf_17g_baseline", 0, count, [&fullValues]() {
+    char buf[32];
+    for (double v : fullValues)
+      g_sink = g_sink + static_cast<size_t>(std::snprintf(buf, sizeof(buf), "%.17g", v));
+  });
+  suite.run("number/format_int", 0, count, [&fullValues]() {
+    char buf[YamlNumberFormat::BUFFER_SIZE];
+    for (double v : fullValues)
+      g_sink = g_sink + YamlNumberFormat::formatInt(static_cast<int>(v * 100), buf);
+  });
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts))
+    return 2;
+
+  Suite suite(opts);
+  try {
+    runParseBenchmarks(suite, opts.scale);
+    runPrintBenchmarks(suite, opts.scale);
+    runLookupBenchmarks(suite, opts.scale);
+    runNumberBenchmarks(suite, opts.scale);
+  } catch (const YamlException &e) {
+    std::cerr << "benchmark failed: " << e.what() << "\n";
+    return 1;
+  }
+
+  if (opts.output.empty()) {
+    writeJson(suite.results(), std::cout);
+  } else {
+    std::ofstream file(opts.output);
+    writeJson(suite.results(), file);
+    if (!file) {
+      std::cerr << "cannot write " << opts.output << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "corpus_generator.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// yamlparser_corpus_gen - writes a seeded synthetic YAML document
+//
+// Usage: yamlparser_corpus_gen [options] [--output FILE]
+//   --seed N               random seed (default 1)
+//   --size N[K|M|G]        approximate output size (default 1M)
+//   --depth N              mapping levels below each top-level section (default 4)
+//   --fan-out N            average keys per mapping (default 5)
+//   --seq-length N         average items per sequence (default 6)
+//   --mix I:F:B:S:Q:N      weights of ints, floats, bools, strings, quoted strings, nulls (default 4:2:1:4:2:1)
+//   --alias-density P      probability of anchors and aliases, 0..1 (default 0.05)
+//   --literal-frequency P  probability of literal/folded blocks for leaf values, 0..1 (default 0.05)
+//   --output FILE          write to FILE instead of stdout
+
+using namespace yamlbench;
+
+namespace {
+
+void usage() {
+  std::cerr << "usage: yamlparser_corpus_gen [--seed N] [--size N[K|M|G]] [--depth N] [--fan-out N] [--seq-length N]\n"
+               "                             [--mix I:F:B:S:Q:N] [--alias-density P] [--literal-frequency P]\n"
+               "                             [--output FILE]\n";
+}
+
+bool parseCount(const std::string &text, std::uint64_t &out) {
+  char              *end   = nullptr;
+  unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+  if (end == text.c_str())
+    return false;
+  std::string suffix(end);
+  if (suffix == "K" || suffix == "k")
+    value <<= 10;
+  else if (suffix == "M" || suffix == "m")
+    value <<= 20;
+  else if (suffix == "G" || suffix == "g")
+    value <<= 30;
+  else if (!suffix.empty())
+    return false;
+  out = value;
+  return true;
+}
+
+bool parseProbability(const std::string &text, double &out) {
+  char  *end   = nullptr;
+  double value = std::strtod(text.c_str(), &end);
+  if (end == text.c_str() || *end != '\0' || value < 0.0 || value > 1.0)
+    return false;
+  out = value;
+  return true;
+}
+
+bool parseMix(const std::string &text, ScalarMix &mix) {
+  unsigned   *fields[] = {&mix.ints, &mix.floats, &mix.bools, &mix.strings, &mix.quoted, &mix.nulls};
+  const char *p        = text.c_str();
+  for (size_t i = 0; i < 6; ++i) {
+    char         *end   = nullptr;
+    unsigned long value = std::strtoul(p, &end, 10);
+    if (end == p || (i < 5 && *end != ':') || (i == 5 && *end != '\0'))
+      return false;
+    *fields[i] = static_cast<unsigned>(value);
+    p          = end + 1;
+  }
+  return true;
+}
+
+bool parseArgs(int argc, char **argv, CorpusShape &shape, std::string &output) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc)
+      return false;
+    std::string   value = argv[++i];
+    std::uint64_t count = 0;
+    bool          ok    = true;
+    if (arg == "--seed")
+      ok = parseCount(value, shape.seed);
+    else if (arg == "--size")
+      ok = parseCount(value, shape.targetBytes);
+    else if (arg == "--depth" || arg == "--fan-out" || arg == "--seq-length") {
+      ok = parseCount(value, count);
+      size_t &field = arg == "--depth" ? shape.depth : arg == "--fan-out" ? shape.fanOut : shape.sequenceLength;
+      field         = static_cast<size_t>(count);
+    } else if (arg == "--mix")
+      ok = parseMix(value, shape.mix);
+    else if (arg == "--alias-density")
+      ok = parseProbability(value, shape.aliasDensity);
+    else if (arg == "--literal-frequency")
+      ok = parseProbability(value, shape.literalFrequency);
+    else if (arg == "--output")
+      output = value;
+    else
+      ok = false;
+    if (!ok)
+      return false;
+  }
+  return shape.fanOut > 0 && shape.sequenceLength > 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  CorpusShape shape;
+  std::string output;
+  if (!parseArgs(argc, argv, shape, output)) {
+    usage();
+    return 2;
+  }
+
+  CorpusGenerator generator(shape);
+  if (output.empty()) {
+    generator.generate(std::cout);
+    std::cout.flush();
+    return std::cout ? 0 : 1;
+  }
+
+  std::ofstream file(output, std::ios::binary);
+  generator.generate(file);
+  file.close();
+  if (!file) {
+    std::cerr << "cannot write " << output << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,376 @@
+#include "bench_support.hpp"
+#include "corpus_generator.hpp"
+#include "YamlEmitter.hpp"
+#include "YamlParser.hpp"
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// yamlparser_perf_gate - fixed benchmark workload compared against a committed baseline
+//
+// Usage: yamlparser_perf_gate --baseline FILE [options] [CASE.yaml...]
+//   --baseline FILE               baseline YAML to compare against (or to write with --update)
+//   --update                      measure and write the baseline instead of comparing
+//   --iterations N                timed runs per workload (default 5); the fastest one is used
+//   --throughput-tolerance F      allowed throughput loss, as a fraction of the baseline
+//   --allocation-tolerance F      allowed increase of the allocation count
+//   --peak-tolerance F            allowed increase of the peak live bytes
+//   CASE.yaml                     documents of the "test_cases" workload
+//
+// Tolerances given on the command line override the ones stored in the
+// baseline. Exit status: 0 within tolerance, 1 regression, 2 usage or I/O error.
+
+using namespace yamlparser;
+using namespace yamlbench;
+
+namespace {
+
+// Used when neither the baseline nor the command line sets a tolerance
+const double DEFAULT_THROUGHPUT_TOLERANCE = 0.50;
+const double DEFAULT_ALLOCATION_TOLERANCE = 0.0;
+const double DEFAULT_PEAK_TOLERANCE       = 0.02;
+
+#ifndef YAMLBENCH_BUILD_TYPE
+#define YAMLBENCH_BUILD_TYPE ""
+#endif
+#ifndef YAMLBENCH_COMPILER
+#define YAMLBENCH_COMPILER ""
+#endif
+
+struct Tolerances {
+  double throughput  = -1; // negative: not set
+  double allocations = -1;
+  double peak        = -1;
+};
+
+struct Options {
+  std::string              baseline;
+  bool                     update     = false;
+  size_t                   iterations = 5;
+  Tolerances               tolerances;
+  std::vector<std::string> cases;
+};
+
+void usage() {
+  std::cerr << "usage: yamlparser_perf_gate --baseline FILE [--update] [--iterations N]\n"
+               "                            [--throughput-tolerance F] [--allocation-tolerance F]\n"
+               "                            [--peak-tolerance F] [CASE.yaml...]\n";
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--update") {
+      opts.update = true;
+      continue;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      opts.cases.push_back(arg);
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--baseline")
+      opts.baseline = value;
+    else if (arg == "--iterations")
+      opts.iterations = std::strtoul(value.c_str(), nullptr, 10);
+    else if (arg == "--throughput-tolerance")
+      opts.tolerances.throughput = std::strtod(value.c_str(), nullptr);
+    else if (arg == "--allocation-tolerance")
+      opts.tolerances.allocations = std::strtod(value.c_str(), nullptr);
+    else if (arg == "--peak-tolerance")
+      opts.tolerances.peak = std::strtod(value.c_str(), nullptr);
+    else {
+      usage();
+      return false;
+    }
+  }
+  if (opts.baseline.empty() || opts.iterations == 0) {
+    usage();
+    return false;
+  }
+  return true;
+}
+
+bool readFile(const std::string &path, std::string &content) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+// Documents parsed together, 'repeat' times, in each iteration of one workload
+struct Workload {
+  std::string              name;
+  std::vector<std::string> documents;
+  size_t                   repeat = 1;
+  size_t                   bytes  = 0;
+};
+
+Workload corpusWorkload(const std::string &name, const CorpusShape &shape) {
+  Workload workload;
+  workload.name = name;
+  workload.documents.push_back(CorpusGenerator(shape).generate());
+  workload.bytes = workload.documents.back().size();
+  return workload;
+}
+
+std::vector<Workload> buildWorkloads(const std::vector<std::string> &cases) {
+  // Fixed seeds and sizes: the workload must not change between runs
+  std::vector<Workload> workloads;
+  CorpusShape           mixed;
+  mixed.seed        = 42;
+  mixed.targetBytes = 256u << 10;
+  workloads.push_back(corpusWorkload("corpus/mixed", mixed));
+
+  CorpusShape aliases;
+  aliases.seed         = 43;
+  aliases.targetBytes  = 256u << 10;
+  aliases.aliasDensity = 0.3;
+  workloads.push_back(corpusWorkload("corpus/alias_heavy", aliases));
+
+  if (!cases.empty()) {
+    // The test cases are small; repeating them gives timings well above the clock resolution
+    Workload testCases;
+    testCases.name   = "test_cases";
+    testCases.repeat = 64;
+    for (const std::string &path : cases) {
+      std::string content;
+      if (!readFile(path, content))
+        throw FileException(path);
+      testCases.bytes += content.size() * testCases.repeat;
+      testCases.documents.push_back(content);
+    }
+    workloads.push_back(testCases);
+  }
+  return workloads;
+}
+
+BenchResult run(const Workload &workload, size_t iterations) {
+  std::cerr << "running " << workload.name << "...\n";
+  auto parseAll = [&workload]() {
+    for (size_t i = 0; i < workload.repeat; ++i) {
+      for (const std::string &document : workload.documents) {
+        YamlParser parser;
+        try {
+          parser.parseString(document);
+          g_sink = g_sink + parser.root().size();
+        } catch (const YamlException &) {
+          // Error paths are part of the workload; they fail the same way every run
+          g_sink = g_sink + 1;
+        }
+      }
+    }
+  };
+  // Untimed warm-up: one-time initialization (function-local statics) must not depend on the iteration count
+  parseAll();
+  return measure(workload.name, iterations, workload.bytes, 0, parseAll);
+}
+
+double throughput(const BenchResult &result) {
+  return result.bestSeconds > 0 ? static_cast<double>(result.bytes) / result.bestSeconds / 1e6 : 0;
+}
+
+// Reads a number from a mapping; the parser types whole numbers as ints
+bool lookupNumber(const YamlMap &map, const char *key, double &out) {
+  auto it = map.find(key);
+  if (it == map.end())
+    return false;
+  const YamlElement &value = it->second.value;
+  if (value.isDouble())
+    out = value.asDouble();
+  else if (value.isInt())
+    out = value.asInt();
+  else
+    return false;
+  return true;
+}
+
+// Command-line value, else the baseline's, else the default
+double tolerance(double option, const YamlMap *stored, const char *key, double fallback) {
+  double value = fallback;
+  if (option >= 0)
+    return option;
+  if (stored)
+    lookupNumber(*stored, key, value);
+  return value;
+}
+
+// Counts are written as ints while they fit, so the file reads naturally
+void writeCount(YamlEmitter &emitter, size_t count) {
+  if (count <= static_cast<size_t>(INT_MAX))
+    emitter.value(static_cast<int>(count));
+  else
+    emitter.value(static_cast<double>(count));
+}
+
+void writeBaseline(std::ostream &os, const std::vector<BenchResult> &results, double throughputTolerance,
+                   double allocationTolerance, double peakTolerance) {
+  YamlEmitter emitter(os);
+  emitter.beginMap();
+  emitter.key("build_type").value(YAMLBENCH_BUILD_TYPE);
+  emitter.key("compiler").value(YAMLBENCH_COMPILER);
+  emitter.key("tolerances").beginMap();
+  emitter.key("throughput").value(throughputTolerance);
+  emitter.key("allocations").value(allocationTolerance);
+  emitter.key("peak_live_bytes").value(peakTolerance);
+  emitter.end();
+  emitter.key("workloads").beginSeq();
+  for (const BenchResult &r : results) {
+    emitter.beginMap();
+    emitter.key("name").value(r.name);
+    emitter.key("bytes");
+    writeCount(emitter, r.bytes);
+    emitter.key("mb_per_s").value(throughput(r));
+    emitter.key("allocations");
+    writeCount(emitter, r.allocs.count);
+    emitter.key("peak_live_bytes");
+    writeCount(emitter, r.allocs.peakLive);
+    emitter.end();
+  }
+  emitter.end();
+  emitter.end();
+  emitter.flush();
+}
+
+const YamlMap *findWorkload(const YamlMap &baseline, const std::string &name) {
+  auto it = baseline.find("workloads");
+  if (it == baseline.end() || !it->second.value.isSeq())
+    return nullptr;
+  for (const YamlItem &item : it->second.value.asSeq()) {
+    if (!item.value.isMap())
+      continue;
+    const YamlMap &workload = item.value.asMap();
+    auto           nameIt   = workload.find("name");
+    if (nameIt != workload.end() && nameIt->second.value.isString() && nameIt->second.value.asString() == name)
+      return &workload;
+  }
+  return nullptr;
+}
+
+double number(const YamlMap &map, const char *key) {
+  double value = 0;
+  lookupNumber(map, key, value);
+  return value;
+}
+
+std::string text(const YamlMap &map, const char *key) {
+  auto it = map.find(key);
+  return it != map.end() && it->second.value.isString() ? it->second.value.asString() : std::string();
+}
+
+// Prints one comparison line; returns false if 'measured' is outside the allowed range
+bool check(const std::string &workload, const char *metric, double measured, double base, double limit,
+           bool higherIsBetter) {
+  bool ok = higherIsBetter ? measured >= limit : measured <= limit;
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-4s %-20s %-16s %14.10g  baseline %14.10g  limit %14.10g\n", ok ? "ok" : "FAIL",
+                workload.c_str(), metric, measured, base, limit);
+  std::cout << line;
+  return ok;
+}
+
+int compare(const std::vector<BenchResult> &results, const YamlMap &baseline, const Tolerances &options) {
+  const YamlMap *stored = nullptr;
+  auto           it     = baseline.find("tolerances");
+  if (it != baseline.end() && it->second.value.isMap())
+    stored = &it->second.value.asMap();
+  double throughputTolerance = tolerance(options.throughput, stored, "throughput", DEFAULT_THROUGHPUT_TOLERANCE);
+  double allocationTolerance = tolerance(options.allocations, stored, "allocations", DEFAULT_ALLOCATION_TOLERANCE);
+  double peakTolerance       = tolerance(options.peak, stored, "peak_live_bytes", DEFAULT_PEAK_TOLERANCE);
+
+  // Timings are only comparable between builds of the same type; counts are deterministic
+  std::string buildType       = text(baseline, "build_type");
+  bool        checkThroughput = buildType == YAMLBENCH_BUILD_TYPE;
+  if (!checkThroughput)
+    std::cout << "note: baseline build type '" << buildType << "' differs from '" << YAMLBENCH_BUILD_TYPE
+              << "'; throughput is not gated\n";
+  if (text(baseline, "compiler") != YAMLBENCH_COMPILER)
+    std::cout << "note: baseline compiler '" << text(baseline, "compiler") << "' differs from '" << YAMLBENCH_COMPILER
+              << "'; allocation counts may differ, regenerate the baseline with --update\n";
+
+  bool passed = true;
+  for (const BenchResult &r : results) {
+    const YamlMap *base = findWorkload(baseline, r.name);
+    if (!base) {
+      std::cout << "new  " << r.name << " is not in the baseline; not gated\n";
+      continue;
+    }
+    double allocations = number(*base, "allocations");
+    double peak        = number(*base, "peak_live_bytes");
+    double mbPerS      = number(*base, "mb_per_s");
+    passed &= check(r.name, "allocations", static_cast<double>(r.allocs.count), allocations,
+                    std::floor(allocations * (1 + allocationTolerance)), false);
+    passed &= check(r.name, "peak_live_bytes", static_cast<double>(r.allocs.peakLive), peak,
+                    std::floor(peak * (1 + peakTolerance)), false);
+    if (checkThroughput)
+      passed &= check(r.name, "mb_per_s", throughput(r), mbPerS, mbPerS * (1 - throughputTolerance), true);
+    if (static_cast<double>(r.allocs.count) < allocations)
+      std::cout << "note: " << r.name << " allocates less than the baseline; consider --update\n";
+  }
+  std::cout << (passed ? "perf gate passed\n" : "perf gate FAILED\n");
+  return passed ? 0 : 1;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts))
+    return 2;
+
+  try {
+    // A missing baseline is only acceptable when creating it
+    std::string content;
+    YamlMap     baseline;
+    if (readFile(opts.baseline, content)) {
+      YamlParser parser;
+      parser.parseString(content);
+      if (parser.isSequenceRoot())
+        throw StructureException("baseline must be a mapping");
+      baseline = parser.root();
+    } else if (!opts.update) {
+      std::cerr << "cannot read baseline " << opts.baseline << "\n";
+      return 2;
+    }
+
+    std::vector<Workload>    workloads = buildWorkloads(opts.cases);
+    std::vector<BenchResult> results;
+    for (const Workload &workload : workloads)
+      results.push_back(run(workload, opts.iterations));
+
+    if (opts.update) {
+      const YamlMap *stored = nullptr;
+      auto           it     = baseline.find("tolerances");
+      if (it != baseline.end() && it->second.value.isMap())
+        stored = &it->second.value.asMap();
+      std::ofstream file(opts.baseline);
+      writeBaseline(file,
+                    results,
+                    tolerance(opts.tolerances.throughput, stored, "throughput", DEFAULT_THROUGHPUT_TOLERANCE),
+                    tolerance(opts.tolerances.allocations, stored, "allocations", DEFAULT_ALLOCATION_TOLERANCE),
+                    tolerance(opts.tolerances.peak, stored, "peak_live_bytes", DEFAULT_PEAK_TOLERANCE));
+      if (!file) {
+        std::cerr << "cannot write " << opts.baseline << "\n";
+        return 2;
+      }
+      std::cerr << "baseline written to " << opts.baseline << "\n";
+      return 0;
+    }
+    return compare(results, baseline, opts.tolerances);
+  } catch (const YamlException &e) {
+    std::cerr << "perf gate failed: " << e.what() << "\n";
+    return 2;
+  }
+}
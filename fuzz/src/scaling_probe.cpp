@@ -0,0 +1,187 @@
+#include "scaling_probe.hpp"
+#include "YamlException.hpp"
+#include "YamlParseStats.hpp"
+#include "YamlParser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+// scaling_probe - super-linear work detection for the fuzz harness
+// Key features:
+// - The work measure is the number of bytes allocated during the parse (the
+//   harness links yamlparser_heap_tally), which includes every subtree copy
+//   made while building the tree and does not depend on timing noise
+// - Prefixes end at line boundaries so each one is a document in its own right
+// - The smallest exponent over all consecutive prefix pairs is judged, so one
+//   unusually heavy section (a large literal block, a wide mapping) does not
+//   look like super-linear growth; only work that keeps growing faster than
+//   the input does
+
+namespace yamlfuzz {
+
+namespace {
+
+// Prefixes at 1/8, 1/4, 1/2 and all of the input
+const size_t PREFIX_COUNT = 4;
+
+double growthExponent(double smallWork, double largeWork, double smallBytes, double largeBytes) {
+  if (smallWork <= 0 || largeWork <= 0 || smallBytes <= 0 || largeBytes <= smallBytes)
+    return 0;
+  return std::log(largeWork / smallWork) / std::log(largeBytes / smallBytes);
+}
+
+double envDouble(const char *name, double fallback) {
+  const char *text = std::getenv(name);
+  if (!text || !*text)
+    return fallback;
+  char  *end   = nullptr;
+  double value = std::strtod(text, &end);
+  return (end && *end == '\0' && value > 0) ? value : fallback;
+}
+
+std::string fixed(double value) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.2f", value);
+  return buf;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Formats the report for a crash log
+ * @return Multi-line text: the verdict, the exponents and one line per prefix
+ */
+std::string ScalingReport::toString() const {
+  std::ostringstream os;
+  os << (superLinear ? "SUPER-LINEAR: " + reason : std::string("ok")) << "\n";
+  os << "  work exponent " << fixed(workExponent) << ", time exponent " << fixed(timeExponent)
+     << ", amplification " << fixed(amplification) << " allocated bytes per input byte\n";
+  for (const auto &sample : samples) {
+    os << "  " << sample.bytes << " bytes, " << sample.lines << " lines: " << sample.allocations << " allocations, "
+       << sample.allocatedBytes << " allocated bytes, " << sample.nodes << " nodes, " << sample.seconds * 1e3 << " ms"
+       << (sample.failed ? " (rejected)" : "") << "\n";
+  }
+  return os.str();
+}
+
+/**
+ * @brief Parses an input once and records the work done
+ * @param input YAML text
+ * @param parseLimits Limits of the parser; inputs exceeding them count as rejected
+ * @return Counters of the parse; inputs the parser rejects report the work up to the error
+ * @details Only YamlException is caught: any other exception escaping the
+ *          parser is a bug the fuzzer should report.
+ */
+ParseWork measureParse(const std::string &input, const yamlparser::ParseLimits &parseLimits) {
+  ParseWork              work;
+  yamlparser::ParseStats stats;
+  yamlparser::YamlParser parser(parseLimits);
+  auto                   start = std::chrono::steady_clock::now();
+  try {
+    parser.parseString(input, stats);
+  } catch (const yamlparser::YamlException &) {
+    work.failed = true;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  work.bytes = input.size();
+  work.lines = static_cast<size_t>(std::count(input.begin(), input.end(), '\n'));
+  if (!input.empty() && input.back() != '\n')
+    work.lines++;
+  work.allocations    = stats.allocations;
+  work.allocatedBytes = stats.allocatedBytes;
+  work.nodes          = stats.totalNodes();
+  work.seconds        = elapsed.count();
+  return work;
+}
+
+/**
+ * @brief Picks prefix lengths that end at line boundaries
+ * @param input Text to cut
+ * @param count Number of prefixes; the i-th of them is about input.size() / 2^(count - i) bytes long
+ * @return Strictly increasing lengths, the last of which is input.size()
+ */
+std::vector<size_t> prefixLengths(const std::string &input, size_t count) {
+  std::vector<size_t> lengths;
+  for (size_t i = 1; i < count; ++i) {
+    size_t target = input.size() >> (count - i);
+    size_t cut    = input.find('\n', target);
+    if (cut == std::string::npos)
+      break;
+    cut++;
+    if (cut < input.size() && (lengths.empty() || cut > lengths.back()))
+      lengths.push_back(cut);
+  }
+  lengths.push_back(input.size());
+  return lengths;
+}
+
+/**
+ * @brief Measures an input and judges how its parse work grows
+ * @param input YAML text
+ * @param limits Thresholds; see ScalingLimits
+ * @return The report; superLinear is set when a limit is exceeded
+ * @details The amplification limit applies to every input, since alias and
+ *          merge expansion can blow up on a handful of lines. The exponent
+ *          limit applies once the input has limits.minLines lines and its
+ *          parse allocates at least limits.minWorkBytes bytes.
+ */
+ScalingReport probeScaling(const std::string &input, const ScalingLimits &limits) {
+  ScalingReport report;
+  ParseWork     full = measureParse(input, limits.parseLimits);
+  if (full.bytes > 0)
+    report.amplification = static_cast<double>(full.allocatedBytes) / static_cast<double>(full.bytes);
+
+  if (full.lines >= limits.minLines) {
+    std::vector<size_t> lengths = prefixLengths(input, PREFIX_COUNT);
+    for (size_t i = 0; i + 1 < lengths.size(); ++i)
+      report.samples.push_back(measureParse(input.substr(0, lengths[i]), limits.parseLimits));
+  }
+  report.samples.push_back(full);
+
+  if (report.samples.size() > 1) {
+    report.workExponent = HUGE_VAL;
+    for (size_t i = 1; i < report.samples.size(); ++i) {
+      const ParseWork &small = report.samples[i - 1];
+      const ParseWork &large = report.samples[i];
+      double           exponent =
+          growthExponent(static_cast<double>(small.allocatedBytes), static_cast<double>(large.allocatedBytes),
+                         static_cast<double>(small.bytes), static_cast<double>(large.bytes));
+      report.workExponent = std::min(report.workExponent, exponent);
+    }
+    const ParseWork &half = report.samples[report.samples.size() - 2];
+    report.timeExponent   = growthExponent(half.seconds, full.seconds, static_cast<double>(half.bytes),
+                                           static_cast<double>(full.bytes));
+  }
+
+  if (report.amplification > limits.maxAmplification) {
+    report.superLinear = true;
+    report.reason      = "allocated " + fixed(report.amplification) + " bytes per input byte (limit " +
+                    fixed(limits.maxAmplification) + ")";
+  } else if (full.allocatedBytes >= limits.minWorkBytes && report.workExponent > limits.maxExponent) {
+    report.superLinear = true;
+    report.reason      = "work grows with exponent " + fixed(report.workExponent) + " of the input size (limit " +
+                    fixed(limits.maxExponent) + ")";
+  }
+  return report;
+}
+
+/**
+ * @brief Reads the limits from the environment
+ * @return Defaults overridden by YAMLFUZZ_MAX_EXPONENT and YAMLFUZZ_MAX_AMPLIFICATION when set to
+ *         positive numbers; YAMLFUZZ_UNTRUSTED=1 parses with ParseLimits::untrusted()
+ */
+ScalingLimits limitsFromEnvironment() {
+  ScalingLimits limits;
+  limits.maxExponent      = envDouble("YAMLFUZZ_MAX_EXPONENT", limits.maxExponent);
+  limits.maxAmplification = envDouble("YAMLFUZZ_MAX_AMPLIFICATION", limits.maxAmplification);
+  const char *untrusted   = std::getenv("YAMLFUZZ_UNTRUSTED");
+  if (untrusted && std::string(untrusted) == "1")
+    limits.parseLimits = yamlparser::ParseLimits::untrusted();
+  return limits;
+}
+
+} // namespace yamlfuzz
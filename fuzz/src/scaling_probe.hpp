@@ -0,0 +1,94 @@
+#pragma once
+#include "YamlParseLimits.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file scaling_probe.hpp
+ * @brief Measures how parse work grows with input size
+ *
+ * Provides functionality to:
+ * - Parse an input and record deterministic work counters (heap allocations,
+ *   allocated bytes, nodes) next to the wall time
+ * - Parse line-aligned prefixes of growing length and estimate the growth
+ *   exponent of the work between consecutive prefixes
+ * - Flag inputs whose work grows quadratically or worse, or whose work per
+ *   input byte exceeds a fixed budget
+ *
+ * Work counters come from ParseStats, so they do not depend on the machine
+ * and an input that is flagged once is flagged on every replay. Parsing with
+ * ParseLimits shows whether the limits contain an input's blowup.
+ */
+
+namespace yamlfuzz {
+
+/**
+ * @brief Work done by one parse
+ */
+struct ParseWork {
+  /** @brief Input bytes */
+  size_t bytes = 0;
+  /** @brief Input lines */
+  size_t lines = 0;
+  /** @brief Heap allocations made during the parse, including copies freed again */
+  size_t allocations = 0;
+  /** @brief Bytes of those allocations */
+  size_t allocatedBytes = 0;
+  /** @brief Nodes in the resulting tree (zero if parsing failed) */
+  size_t nodes = 0;
+  /** @brief Wall time in seconds */
+  double seconds = 0;
+  /** @brief The parser rejected the input; the counters cover the work up to the error */
+  bool failed = false;
+};
+
+/**
+ * @brief Thresholds of the scaling check
+ *
+ * The defaults leave ample room for the ordinary per-byte cost of the parser
+ * (about 5 to 35 allocated bytes per input byte on typical documents).
+ */
+struct ScalingLimits {
+  /** @brief Largest accepted growth exponent of the work (1 = linear, 2 = quadratic) */
+  double maxExponent = 1.5;
+  /** @brief Largest accepted number of allocated bytes per input byte */
+  double maxAmplification = 1024;
+  /** @brief Inputs with fewer lines are parsed once but not probed */
+  size_t minLines = 32;
+  /** @brief Exponents are only judged once the full input allocates at least this many bytes */
+  size_t minWorkBytes = 256 * 1024;
+  /** @brief Limits of the parser under test; unlimited by default */
+  yamlparser::ParseLimits parseLimits;
+};
+
+/**
+ * @brief Outcome of probing one input
+ */
+struct ScalingReport {
+  /** @brief One entry per parsed prefix, shortest first; the last one is the whole input */
+  std::vector<ParseWork> samples;
+  /** @brief Smallest growth exponent of allocated bytes between consecutive prefixes */
+  double workExponent = 0;
+  /** @brief Growth exponent of the wall time between the two longest prefixes (informational) */
+  double timeExponent = 0;
+  /** @brief Allocated bytes per input byte of the whole input */
+  double amplification = 0;
+  /** @brief The input exceeds one of the limits */
+  bool superLinear = false;
+  /** @brief Which limit was exceeded, empty otherwise */
+  std::string reason;
+
+  std::string toString() const;
+};
+
+ParseWork measureParse(const std::string                &input,
+                       const yamlparser::ParseLimits &parseLimits = yamlparser::ParseLimits());
+
+std::vector<size_t> prefixLengths(const std::string &input, size_t count);
+
+ScalingReport probeScaling(const std::string &input, const ScalingLimits &limits = ScalingLimits());
+
+ScalingLimits limitsFromEnvironment();
+
+} // namespace yamlfuzz
@@ -0,0 +1,75 @@
+#include "scaling_probe.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// yamlparser_fuzz_replay - runs the fuzz target without libFuzzer
+//
+// Usage: yamlparser_fuzz_replay [--report] [FILE...]
+//   FILE       inputs to run; stdin when none are given (AFL: pass @@ or nothing)
+//   --report   print the scaling report of every input instead of aborting on
+//              the first super-linear one; exit status 1 if any was flagged
+//
+// Without --report each input goes through LLVMFuzzerTestOneInput exactly as
+// under libFuzzer, which makes this the driver for AFL builds
+// (CXX=afl-clang-fast++) and for replaying crash files with a plain compiler.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace {
+
+bool readInput(const std::string &name, std::string &content) {
+  std::ostringstream buffer;
+  if (name.empty()) {
+    buffer << std::cin.rdbuf();
+  } else {
+    std::ifstream file(name, std::ios::binary);
+    if (!file.is_open())
+      return false;
+    buffer << file.rdbuf();
+  }
+  content = buffer.str();
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  bool                     reportOnly = false;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--report") == 0) {
+      reportOnly = true;
+    } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+      std::cout << "usage: yamlparser_fuzz_replay [--report] [FILE...]\n";
+      return 0;
+    } else {
+      inputs.push_back(argv[i]);
+    }
+  }
+  if (inputs.empty())
+    inputs.push_back(""); // stdin
+
+  const yamlfuzz::ScalingLimits limits  = yamlfuzz::limitsFromEnvironment();
+  int                           flagged = 0;
+  for (const auto &name : inputs) {
+    std::string content;
+    if (!readInput(name, content)) {
+      std::cerr << "yamlparser_fuzz_replay: cannot read " << name << "\n";
+      return 2;
+    }
+    if (!reportOnly) {
+      LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(content.data()), content.size());
+      continue;
+    }
+    yamlfuzz::ScalingReport report = yamlfuzz::probeScaling(content, limits);
+    std::cout << (name.empty() ? std::string("<stdin>") : name) << ": " << report.toString();
+    flagged += report.superLinear;
+  }
+  return flagged > 0 ? 1 : 0;
+}
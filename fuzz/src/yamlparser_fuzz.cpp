@@ -0,0 +1,27 @@
+#include "scaling_probe.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// yamlparser_fuzz - libFuzzer/AFL entry point
+//
+// Every input is parsed at several prefix lengths (see scaling_probe.hpp).
+// Exceptions other than YamlException propagate and crash the target, and
+// inputs whose parse work grows super-linearly abort with a report on stderr,
+// so the fuzzer saves them like any other crash.
+//
+// Limits can be changed with YAMLFUZZ_MAX_EXPONENT and YAMLFUZZ_MAX_AMPLIFICATION;
+// YAMLFUZZ_UNTRUSTED=1 fuzzes the parser configured with ParseLimits::untrusted().
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  static const yamlfuzz::ScalingLimits limits = yamlfuzz::limitsFromEnvironment();
+
+  std::string             input(reinterpret_cast<const char *>(data), size);
+  yamlfuzz::ScalingReport report = yamlfuzz::probeScaling(input, limits);
+  if (report.superLinear) {
+    std::fprintf(stderr, "yamlparser_fuzz: %s", report.toString().c_str());
+    std::abort();
+  }
+  return 0;
+}
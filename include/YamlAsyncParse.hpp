@@ -0,0 +1,133 @@
+#pragma once
+#include "YamlParser.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file YamlAsyncParse.hpp
+ * @brief Parsing off the calling thread, with cancellation and progress reporting
+ *
+ * Provides functionality to:
+ * - Parse a file or a buffer on an executor and receive the parser through
+ *   a std::future, so event loops never block on a large document
+ * - Run on a shared, library-managed thread pool, or on any executor the
+ *   application already has (a function that takes a task)
+ * - Cancel a parse cooperatively: the flag is checked before the parse
+ *   starts and between top-level entries
+ * - Report progress in bytes consumed, between top-level entries
+ *
+ * Errors, cancellation included (CancelledException), are rethrown by
+ * std::future::get(). The progress handler runs on the parsing thread.
+ *
+ * The tracer (YamlTraceScope) current on the calling thread when the parse
+ * is started is made current on the parsing thread while it runs, and must
+ * outlive the parse.
+ *
+ * Usage example:
+ * @code
+ *   AsyncParseOptions options;
+ *   options.limits     = ParseLimits::untrusted();
+ *   options.onProgress = [](size_t done, size_t total) { updateBar(done, total); };
+ *   YamlCancellation cancel = options.cancellation;
+ *
+ *   std::future<YamlParser> pending = parseStringAsync(std::move(upload), options);
+ *   // ... later, e.g. when the client disconnects
+ *   cancel.cancel();
+ *   // ... or when the future is ready
+ *   YamlParser parser = pending.get();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Runs a task, now or later, on any thread
+ */
+using YamlExecutor = std::function<void(std::function<void()> task)>;
+
+/**
+ * @brief Shared cancellation flag
+ *
+ * Copies refer to the same flag, so the application keeps one copy and
+ * hands another to the parse.
+ */
+class YamlCancellation {
+public:
+  YamlCancellation();
+
+  void cancel();
+
+  bool cancelled() const;
+
+  void throwIfCancelled() const;
+
+private:
+  std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+/**
+ * @brief Fixed-size pool of worker threads with a FIFO task queue
+ *
+ * Tasks should not throw; an exception that escapes a task is dropped. The
+ * destructor runs the tasks still queued, then joins the workers.
+ */
+class YamlThreadPool {
+public:
+  explicit YamlThreadPool(size_t threads = 0);
+
+  ~YamlThreadPool();
+
+  YamlThreadPool(const YamlThreadPool &)            = delete;
+  YamlThreadPool &operator=(const YamlThreadPool &) = delete;
+
+  void submit(std::function<void()> task);
+
+  YamlExecutor executor();
+
+  size_t size() const;
+
+  static YamlThreadPool &shared();
+
+private:
+  void run();
+
+  /** @brief Guards m_tasks and m_stopping */
+  std::mutex m_mutex;
+  /** @brief Signalled when a task is queued or the pool stops */
+  std::condition_variable m_ready;
+  /** @brief Tasks waiting for a worker */
+  std::deque<std::function<void()>> m_tasks;
+  /** @brief Set by the destructor */
+  bool m_stopping = false;
+  /** @brief Worker threads */
+  std::vector<std::thread> m_threads;
+};
+
+/**
+ * @brief How an asynchronous parse runs
+ */
+struct AsyncParseOptions {
+  /** @brief Limits of the parser that runs the parse */
+  ParseLimits limits;
+  /** @brief Where the parse runs; empty for YamlThreadPool::shared() */
+  YamlExecutor executor;
+  /** @brief Checked before the parse starts and between top-level entries */
+  YamlCancellation cancellation;
+  /** @brief Called between top-level entries with the bytes consumed so far (optional) */
+  YamlProgressHandler onProgress;
+};
+
+std::future<YamlParser> parseAsync(const std::string &filename, const AsyncParseOptions &options = AsyncParseOptions());
+
+std::future<YamlParser> parseStringAsync(std::string content, const AsyncParseOptions &options = AsyncParseOptions());
+
+} // namespace yamlparser
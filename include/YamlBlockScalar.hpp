@@ -0,0 +1,95 @@
+#pragma once
+#include "YamlScanner.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlBlockScalar.hpp
+ * @brief Literal ('|') and folded ('>') block scalars
+ *
+ * Provides functionality to:
+ * - Read the block header: style, chomping indicator ('-' strip, '+' keep,
+ *   none for clip) and indentation indicator ('1'..'9'), in either order,
+ *   optionally followed by a comment
+ * - Find the end of the block and the exact size of its content before
+ *   copying anything, so the string is allocated once and size limits can
+ *   be checked first
+ * - Keep the indentation of lines relative to the block, and blank lines
+ *   inside it
+ *
+ * Without an indentation indicator, the block is indented like its first
+ * non-blank line. The block ends at the first non-blank line indented less.
+ * Folded blocks join adjacent lines with a space, except around blank and
+ * more-indented lines, whose line breaks are kept.
+ *
+ * Without a chomping indicator, literal and folded blocks both end with
+ * exactly one line break (clip).
+ *
+ * Usage example:
+ * @code
+ *   std::string text = "script: |-\n  set -e\n    make all\n";
+ *   YamlScanner tokens(text);
+ *   YamlBlockScalar block(tokens, 0, 0, "|-");
+ *   std::string script = block.str(); // "set -e\n  make all"
+ *   size_t next = block.end();        // first line after the block
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Trailing line break handling of a block scalar
+ */
+enum class YamlChomping : unsigned char {
+  Clip,  ///< No indicator: one final line break
+  Strip, ///< '-': no final line break
+  Keep   ///< '+': the final line break and all trailing blank lines
+};
+
+/**
+ * @brief Measured block scalar; the content is copied out by str()
+ */
+class YamlBlockScalar {
+public:
+  YamlBlockScalar(const YamlScanner &tokens, size_t headerIdx, size_t parentIndent, const std::string &header);
+
+  char style() const;
+
+  YamlChomping chomping() const;
+
+  size_t indent() const;
+
+  size_t end() const;
+
+  size_t size() const;
+
+  std::string str() const;
+
+private:
+  bool parseHeader(const std::string &header);
+
+  void measure(size_t headerIdx, size_t parentIndent);
+
+  template <typename Sink> void emit(Sink &sink) const;
+
+  /** @brief Tokens of the document */
+  const YamlScanner &m_tokens;
+  /** @brief '|' or '>' */
+  char m_style = '|';
+  /** @brief Chomping indicator */
+  YamlChomping m_chomping = YamlChomping::Clip;
+  /** @brief Indentation indicator (0 if none) */
+  size_t m_indicator = 0;
+  /** @brief Indentation of the content lines */
+  size_t m_indent = 0;
+  /** @brief First line of the block */
+  size_t m_begin = 0;
+  /** @brief Line after the last non-blank line of the block (m_begin if there is none) */
+  size_t m_contentEnd = 0;
+  /** @brief Line after the block, trailing blank lines included */
+  size_t m_end = 0;
+  /** @brief Content size in bytes */
+  size_t m_size = 0;
+};
+
+} // namespace yamlparser
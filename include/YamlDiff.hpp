@@ -0,0 +1,97 @@
+#pragma once
+#include "YamlElement.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlDiff.hpp
+ * @brief Content hashing and structural diff of YAML trees
+ *
+ * Provides functionality to:
+ * - Compute a Merkle-style content hash for every node of a parsed tree
+ * - Compare two trees and report the paths that were added, removed or changed
+ * - Skip identical subtrees in O(1) by comparing their hashes
+ *
+ * Usage example:
+ * @code
+ *   YamlHashTree before(oldParser.root());
+ *   YamlHashTree after(newParser.root());
+ *   for (const auto &change : diff(before, after)) {
+ *     std::cout << change.path << "\n";   // e.g. "server.port" or "hosts[2]"
+ *   }
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Bottom-up content hashes for a YAML tree
+ *
+ * The hash tree mirrors the shape of the YAML tree it was built from:
+ * - Map nodes hold one child per entry, in the map's (sorted) key order
+ * - Sequence nodes hold one child per element, in index order
+ * - Scalar nodes have no children
+ *
+ * Each node's hash covers its type, its value and (for collections) the keys
+ * and hashes of all its children, so two subtrees with equal hashes are
+ * treated as identical. The hash tree keeps pointers into the source tree,
+ * which must outlive it and must not be modified while it is in use.
+ */
+class YamlHashTree {
+public:
+  /** @brief One hashed node, mirroring a YamlElement (or the root container) */
+  struct Node {
+    /** @brief Content hash of the whole subtree rooted at this node */
+    std::uint64_t hash = 0;
+    /** @brief Type of the hashed value */
+    YamlElement::ElementType type = YamlElement::ElementType::NONE;
+    /** @brief Source mapping (valid when type == MAP) */
+    const YamlMap *map = nullptr;
+    /** @brief Source sequence (valid when type == SEQ) */
+    const YamlSeq *seq = nullptr;
+    /** @brief Source element (null for a root container) */
+    const YamlElement *element = nullptr;
+    /** @brief Hashed children in map key order or sequence index order */
+    std::vector<Node> children;
+  };
+
+  explicit YamlHashTree(const YamlMap &map);
+
+  explicit YamlHashTree(const YamlSeq &seq);
+
+  explicit YamlHashTree(const YamlItem &item);
+
+  explicit YamlHashTree(const YamlElement &element);
+
+  std::uint64_t hash() const;
+
+  const Node &root() const;
+
+  static std::uint64_t hashOf(const YamlItem &item);
+
+private:
+  /** @brief Root of the hashed tree */
+  Node m_root;
+};
+
+/**
+ * @brief A single difference reported by diff()
+ */
+struct YamlDiffEntry {
+  /** @brief Kind of change found at a path */
+  enum class Kind {
+    ADDED,   ///< Path exists only in the second tree
+    REMOVED, ///< Path exists only in the first tree
+    CHANGED  ///< Path exists in both trees with a different value or type
+  };
+  Kind kind;
+  /** @brief Location of the change: keys joined with '.', sequence indices as "[i]" */
+  std::string path;
+};
+
+std::vector<YamlDiffEntry> diff(const YamlHashTree &a, const YamlHashTree &b);
+
+std::vector<YamlDiffEntry> diff(const YamlMap &a, const YamlMap &b);
+
+} // namespace yamlparser
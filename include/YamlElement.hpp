@@ -19,6 +19,7 @@ namespace yamlparser {
 
 class YamlElement;
 class YamlItem;
+struct YamlMemoryUsage;
 /**
  * @brief YAML sequence type (ordered list of values)
  * Implemented as a vector for:
@@ -100,6 +101,10 @@ public:
   explicit YamlElement(const YamlSeq &seq);
   /** @brief Create a mapping value */
   explicit YamlElement(const YamlMap &map);
+  /** @brief Create a sequence value, taking over the items */
+  explicit YamlElement(YamlSeq &&seq);
+  /** @brief Create a mapping value, taking over the entries */
+  explicit YamlElement(YamlMap &&map);
   /** @} */
 
   /**
@@ -159,6 +164,8 @@ public:
   bool isScalar() const;
   /** @} */
 
+  YamlMemoryUsage memoryUsage(size_t largestCount = 0) const;
+
   /**
    * @name Static Utility Methods
    * Safe access methods for collections
@@ -189,6 +196,11 @@ public:
    * @param element The YAML element to wrap
    */
   YamlItem(const YamlElement &element) : value(element) {}
+
+  /** @brief Create an item taking over the given element
+   * @param element The YAML element to move from
+   */
+  YamlItem(YamlElement &&element) noexcept : value(std::move(element)) {}
 };
 
 } // namespace yamlparser
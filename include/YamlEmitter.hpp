@@ -0,0 +1,120 @@
+#pragma once
+#include "YamlElement.hpp"
+#include "YamlOutputBuffer.hpp"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlEmitter.hpp
+ * @brief Streaming YAML writer that does not build a tree
+ *
+ * Provides functionality to:
+ * - Write mappings and sequences incrementally with begin/end calls
+ * - Produce the same text as YamlPrinter for the equivalent tree
+ * - Keep memory use bounded by nesting depth, not by document size
+ *
+ * Usage example:
+ * @code
+ *   std::ofstream file("export.yaml");
+ *   YamlEmitter   emitter(file);
+ *   emitter.beginMap();
+ *   emitter.key("name").value("export");
+ *   emitter.key("rows").beginSeq();
+ *   while (cursor.next()) {
+ *     emitter.beginMap();
+ *     emitter.key("id").value(cursor.id());
+ *     emitter.end();
+ *   }
+ *   emitter.end(); // rows
+ *   emitter.end(); // root
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Incremental YAML writer
+ *
+ * Calls must describe a well-formed document:
+ * - The root is a single mapping or sequence opened with beginMap()/beginSeq()
+ * - Inside a mapping, every value or nested collection is preceded by key()
+ * - Every begin call is closed by a matching end()
+ *
+ * Violations throw StructureException. Scalars are quoted with the same rules
+ * as YamlPrinter, and empty strings inside a mapping are written as null.
+ */
+class YamlEmitter {
+public:
+  explicit YamlEmitter(std::ostream &os);
+
+  explicit YamlEmitter(YamlOutputBuffer &out);
+
+  ~YamlEmitter();
+
+  YamlEmitter(const YamlEmitter &)            = delete;
+  YamlEmitter &operator=(const YamlEmitter &) = delete;
+
+  /**
+   * @name Structure Methods
+   * @{
+   */
+  YamlEmitter &beginMap();
+
+  YamlEmitter &beginSeq();
+
+  YamlEmitter &key(const std::string &key);
+
+  YamlEmitter &end();
+  /** @} */
+
+  /**
+   * @name Value Methods
+   * @{
+   */
+  YamlEmitter &value(const std::string &s);
+
+  YamlEmitter &value(const char *s);
+
+  YamlEmitter &value(int i);
+
+  YamlEmitter &value(double d);
+
+  YamlEmitter &value(bool b);
+
+  YamlEmitter &value(const YamlItem &item);
+
+  YamlEmitter &null();
+  /** @} */
+
+  size_t depth() const;
+
+  bool complete() const;
+
+  void flush();
+
+private:
+  enum class FrameType { MAP, SEQ };
+
+  struct Frame {
+    FrameType type;
+    int       indent;
+    bool      keyPending;
+  };
+
+  void beginValue(const char *what);
+
+  void beginCollection(FrameType type);
+
+  /** @brief Buffer owned by the emitter when writing to a stream */
+  std::unique_ptr<YamlOutputBuffer> m_ownedBuffer;
+  /** @brief Destination buffer (owned or caller-supplied) */
+  YamlOutputBuffer *m_out;
+  /** @brief Currently open collections, innermost last */
+  std::vector<Frame> m_stack;
+  /** @brief Set once the root collection has been opened */
+  bool m_started = false;
+};
+
+} // namespace yamlparser
@@ -55,10 +55,68 @@ public:
  */
 class SyntaxException : public YamlException {
 public:
-  explicit SyntaxException(const std::string &message) : YamlException("YAML syntax error: " + message) {}
+  explicit SyntaxException(const std::string &message)
+      : YamlException("YAML syntax error: " + message), m_detail(message) {}
 
   SyntaxException(const std::string &message, size_t line)
-      : YamlException("YAML syntax error at line " + std::to_string(line) + ": " + message) {}
+      : YamlException("YAML syntax error at line " + std::to_string(line) + ": " + message), m_line(line),
+        m_detail(message) {}
+
+  /**
+   * @brief Get the line of the error
+   * @return 1-based line number, or 0 if it is not known
+   */
+  size_t line() const noexcept {
+    return m_line;
+  }
+
+  /**
+   * @brief Get the error without the "YAML syntax error at line N" prefix
+   * @return e.g. "Empty key in key-value pair"
+   */
+  const std::string &detail() const noexcept {
+    return m_detail;
+  }
+
+private:
+  size_t      m_line = 0;
+  std::string m_detail;
+};
+
+/**
+ * @brief Exception thrown when the input is not valid UTF-8
+ *
+ * This exception is thrown when:
+ * - A byte sequence is not well-formed UTF-8 (stray continuation bytes,
+ *   truncated or overlong sequences, surrogates, code points above U+10FFFF)
+ * - The input starts with a UTF-16 or UTF-32 byte order mark
+ */
+class EncodingException : public YamlException {
+public:
+  EncodingException(const std::string &message, size_t line, size_t offset)
+      : YamlException("Encoding error at line " + std::to_string(line) + " (byte " + std::to_string(offset) +
+                      "): " + message),
+        m_line(line), m_offset(offset) {}
+
+  /**
+   * @brief Get the line of the error
+   * @return 1-based line number of the first invalid byte
+   */
+  size_t line() const noexcept {
+    return m_line;
+  }
+
+  /**
+   * @brief Get the position of the error
+   * @return 0-based byte offset of the first invalid byte in the input
+   */
+  size_t offset() const noexcept {
+    return m_offset;
+  }
+
+private:
+  size_t m_line;
+  size_t m_offset;
 };
 
 /**
@@ -128,4 +186,68 @@ public:
   explicit StructureException(const std::string &message) : YamlException("Structure error: " + message) {}
 };
 
+/**
+ * @brief Exception thrown when serialized output cannot be written
+ *
+ * This exception is thrown when:
+ * - A caller-supplied fixed output buffer is too small
+ * - The destination stream reports a write error
+ */
+class OutputException : public YamlException {
+public:
+  explicit OutputException(const std::string &message) : YamlException("Output error: " + message) {}
+};
+
+/**
+ * @brief Exception thrown when a binary snapshot image is invalid
+ *
+ * This exception is thrown when:
+ * - The image header has a wrong magic, version or byte order
+ * - A node or string reference points outside the image
+ * - The image is truncated or misaligned
+ */
+class SnapshotException : public YamlException {
+public:
+  explicit SnapshotException(const std::string &message) : YamlException("Snapshot error: " + message) {}
+};
+
+/**
+ * @brief Exception thrown when a document exceeds a parse limit
+ *
+ * This exception is thrown when:
+ * - The input is larger than ParseLimits::maxInputBytes
+ * - Nesting, node count or scalar length exceed their limits
+ * - Aliases and merge keys would copy more nodes than allowed
+ */
+class LimitException : public YamlException {
+public:
+  LimitException(const std::string &limit, size_t maximum, size_t line = 0)
+      : YamlException("Parse limit exceeded: " + limit + " (maximum " + std::to_string(maximum) + ")" +
+                      (line > 0 ? " at line " + std::to_string(line) : std::string())),
+        m_limit(limit) {}
+
+  /**
+   * @brief Get the name of the exceeded limit
+   * @return e.g. "nesting depth" or "alias expansion nodes"
+   */
+  const std::string &limit() const noexcept {
+    return m_limit;
+  }
+
+private:
+  std::string m_limit;
+};
+
+/**
+ * @brief Exception thrown when a parse is cancelled
+ *
+ * This exception is thrown when:
+ * - YamlCancellation::cancel() was called before or during an asynchronous
+ *   parse (see YamlAsyncParse.hpp); the parse stops at the next top-level entry
+ */
+class CancelledException : public YamlException {
+public:
+  CancelledException() : YamlException("Parse cancelled") {}
+};
+
 } // namespace yamlparser
@@ -0,0 +1,84 @@
+#pragma once
+#include "YamlElement.hpp"
+#include "YamlException.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlFlowParser.hpp
+ * @brief Recursive-descent parser for flow collections
+ *
+ * Provides functionality to:
+ * - Parse flow sequences ("[1, 2, [3, 4]]") and flow mappings
+ *   ("{name: api, ports: [80, 443]}"), nested in any combination
+ * - Build the elements in a single pass over the characters, without
+ *   splitting the text into item strings first
+ * - Bound the nesting depth, so hostile input cannot exhaust the stack
+ *
+ * Scalars are typed like block scalars (see YamlParser::parseScalar()).
+ * Items are separated by ',' and a trailing ',' before the closing bracket
+ * is allowed; an empty item ("[a, , b]") is an empty string. A quoted item
+ * may contain ',', ':' and brackets. Flow mapping keys end at the first ':'
+ * and must be scalars; a key without ':' has an empty value.
+ *
+ * Usage example:
+ * @code
+ *   YamlFlowParser flow;
+ *   YamlItem item = flow.parse("{hosts: [a, b], port: 80}");
+ *   int port = item.value.asMap().at("port").value.asInt();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Parses one flow collection at a time
+ */
+class YamlFlowParser {
+public:
+  /** @brief Nesting allowed when no limit is given; keeps the recursion well within the stack */
+  static const size_t DEFAULT_MAX_DEPTH = 1000;
+
+  explicit YamlFlowParser(size_t maxDepth = DEFAULT_MAX_DEPTH, size_t baseDepth = 0, size_t line = 0);
+
+  YamlItem parse(const std::string &text);
+
+  size_t nodes() const;
+
+  size_t depth() const;
+
+private:
+  YamlItem parseCollection(size_t level);
+
+  YamlSeq parseSeq(size_t level);
+
+  YamlMap parseMap(size_t level);
+
+  YamlItem parseValue(size_t level);
+
+  const char *scanScalar(bool key);
+
+  bool expectSeparator(char closer);
+
+  void skipBlanks();
+
+  SyntaxException syntaxError(const std::string &message) const;
+
+  /** @brief Maximum nesting depth, counted like ParseLimits::maxDepth */
+  size_t m_maxDepth;
+  /** @brief Depth of the block collection holding the flow collection */
+  size_t m_baseDepth;
+  /** @brief 1-based line reported in errors (0 if unknown) */
+  size_t m_line;
+
+  /** @brief Current position in the text being parsed */
+  const char *m_pos = nullptr;
+  /** @brief End of the text being parsed */
+  const char *m_end = nullptr;
+  /** @brief Nodes created by the last parse(), collections included */
+  size_t m_nodes = 0;
+  /** @brief Deepest nesting level reached by the last parse() */
+  size_t m_depth = 0;
+};
+
+} // namespace yamlparser
@@ -4,6 +4,7 @@
 #include <map>
 #include "YamlParser.hpp"
 #include "YamlPrinter.hpp"
+#include "YamlScanner.hpp"
 #include "YamlElement.hpp"
 
 /**
@@ -15,6 +16,7 @@
  * 2. Parse complex YAML structures (sequences, anchors, etc.)
  * 3. Handle string manipulation (trimming, validation)
  * 4. Support the main parser implementation
+ * 5. Format scalars for the printer and emitter (quoting, numbers)
  *
  * These functions are internal to the parser implementation
  * and should not be used directly by library users.
@@ -30,13 +32,21 @@ bool isAlias(const std::string &value);
 
 bool isInlineSeq(const std::string &value);
 
+bool isFlowCollection(const std::string &value);
+
 bool isMergeKey(const std::string &key, const std::string &value);
 
 std::string trim(const std::string &s);
 
-YamlItem parseMultilineLiteral(const std::vector<std::string> &lines, size_t &idx, int curIndent, char style);
+std::string unescapeDoubleQuoted(const char *data, size_t size);
+
+std::string unescapeSingleQuoted(const char *data, size_t size);
+
+YamlItem parseMultilineLiteral(const YamlScanner &tokens, size_t &idx, int curIndent, const std::string &header);
 
-YamlItem parseAnchor(const std::string &value, const std::vector<std::string> &lines, size_t &idx,
+YamlItem parseMultilineLiteral(const YamlScanner &tokens, size_t &idx, int curIndent, char style);
+
+YamlItem parseAnchor(const std::string &value, const YamlScanner &tokens, size_t &idx,
                      std::map<std::string, YamlItem> &anchors, YamlParser &parser);
 
 YamlItem parseAlias(const std::string &value, const std::map<std::string, YamlItem> &anchors);
@@ -46,4 +56,14 @@ YamlItem parseInlineSeq(const std::string &value);
 void parseMergeKey(const std::string &value, std::map<std::string, YamlItem> &map,
                    const std::map<std::string, YamlItem> &anchors);
 
+bool needsQuoting(const std::string &s);
+
+bool hasControlCharacter(const std::string &s);
+
+void writeQuotedIfNeeded(const std::string &s, YamlOutputBuffer &out);
+
+void writeInt(int value, YamlOutputBuffer &out);
+
+void writeDouble(double value, YamlOutputBuffer &out);
+
 } // namespace yamlparser
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlInput.hpp
+ * @brief Input stage in front of the scanner: encoding check and line break normalization
+ *
+ * Provides functionality to:
+ * - Validate that a document is UTF-8 in one pass, skipping ASCII runs
+ *   16 bytes at a time
+ * - Drop a leading UTF-8 byte order mark
+ * - Turn "\r\n" and lone "\r" line breaks into "\n", so a trailing '\r'
+ *   never reaches keys and scalars
+ *
+ * The source is used as-is when it has neither a byte order mark nor a
+ * '\r', which is the common case; otherwise the normalized text is built in
+ * one allocation. Either way text() is what the scanner should read.
+ *
+ * Usage example:
+ * @code
+ *   std::string raw = "\xEF\xBB\xBFname: api\r\nport: 80\r\n";
+ *   YamlInput input(raw);         // throws EncodingException on invalid UTF-8
+ *   YamlScanner tokens(input.text()); // "name: api\nport: 80\n"
+ * @endcode
+ */
+
+namespace yamlparser {
+
+size_t findInvalidUtf8(const char *data, size_t size);
+
+/**
+ * @brief Validated and normalized view of a document
+ *
+ * Keeps a reference to the source, which must outlive it unless a copy was
+ * made (see normalized()). Moving the input moves the copy, so text() must
+ * be called again afterwards.
+ */
+class YamlInput {
+public:
+  explicit YamlInput(const std::string &source);
+
+  YamlInput(YamlInput &&)                 = default;
+  YamlInput(const YamlInput &)            = delete;
+  YamlInput &operator=(const YamlInput &) = delete;
+
+  const std::string &text() const;
+
+  bool hasBom() const;
+
+  bool normalized() const;
+
+private:
+  void normalize();
+
+  /** @brief The document as given */
+  const std::string &m_source;
+  /** @brief Normalized copy, used when the source had a byte order mark or a '\r' */
+  std::string m_copy;
+  /** @brief True if the source started with a UTF-8 byte order mark */
+  bool m_bom = false;
+  /** @brief True if text() returns m_copy */
+  bool m_normalized = false;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,140 @@
+#pragma once
+#include "YamlElement.hpp"
+#include "YamlOutputBuffer.hpp"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlJsonPrinter.hpp
+ * @brief Serialization of YAML data structures to compact JSON
+ *
+ * Provides functionality to:
+ * - Convert parsed YAML trees to JSON text (YamlJsonPrinter)
+ * - Write JSON incrementally without building a tree (YamlJsonEmitter)
+ * - Render through YamlOutputBuffer (chunked stream writes, no flushes)
+ * - Escape strings with a vectorized scan for characters that need escaping
+ *
+ * Usage example:
+ * @code
+ *   YamlParser parser;
+ *   parser.parse("config.yaml");
+ *   std::string json = YamlJsonPrinter::toString(parser.root());
+ *   YamlJsonPrinter::print(parser.root(), std::cout);
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Static utility class for JSON serialization
+ *
+ * Output is compact (no whitespace). Type mapping:
+ * - Mappings become objects, keys in the map's sorted order
+ * - Sequences become arrays
+ * - Strings become JSON strings (empty strings stay "")
+ * - Integers, doubles and booleans become JSON literals
+ * - Null values, and non-finite doubles, become null
+ */
+class YamlJsonPrinter {
+public:
+  static void print(const YamlMap &map, std::ostream &os);
+
+  static void print(const YamlSeq &seq, std::ostream &os);
+
+  static void print(const YamlItem &item, std::ostream &os);
+
+  static void print(const YamlMap &map, YamlOutputBuffer &out);
+
+  static void print(const YamlSeq &seq, YamlOutputBuffer &out);
+
+  static void print(const YamlItem &item, YamlOutputBuffer &out);
+
+  static std::string toString(const YamlMap &map);
+
+  static std::string toString(const YamlSeq &seq);
+
+  static void writeString(const std::string &s, YamlOutputBuffer &out);
+};
+
+/**
+ * @brief Incremental JSON writer with the same call API as YamlEmitter
+ *
+ * Lets code that drives a YamlEmitter produce JSON instead by swapping the
+ * emitter type. The same structural rules apply and violations throw
+ * StructureException.
+ */
+class YamlJsonEmitter {
+public:
+  explicit YamlJsonEmitter(std::ostream &os);
+
+  explicit YamlJsonEmitter(YamlOutputBuffer &out);
+
+  ~YamlJsonEmitter();
+
+  YamlJsonEmitter(const YamlJsonEmitter &)            = delete;
+  YamlJsonEmitter &operator=(const YamlJsonEmitter &) = delete;
+
+  /**
+   * @name Structure Methods
+   * @{
+   */
+  YamlJsonEmitter &beginMap();
+
+  YamlJsonEmitter &beginSeq();
+
+  YamlJsonEmitter &key(const std::string &key);
+
+  YamlJsonEmitter &end();
+  /** @} */
+
+  /**
+   * @name Value Methods
+   * @{
+   */
+  YamlJsonEmitter &value(const std::string &s);
+
+  YamlJsonEmitter &value(const char *s);
+
+  YamlJsonEmitter &value(int i);
+
+  YamlJsonEmitter &value(double d);
+
+  YamlJsonEmitter &value(bool b);
+
+  YamlJsonEmitter &value(const YamlItem &item);
+
+  YamlJsonEmitter &null();
+  /** @} */
+
+  size_t depth() const;
+
+  bool complete() const;
+
+  void flush();
+
+private:
+  enum class FrameType { MAP, SEQ };
+
+  struct Frame {
+    FrameType type;
+    bool      empty;
+    bool      keyPending;
+  };
+
+  void beginValue(const char *what);
+
+  void beginCollection(FrameType type);
+
+  /** @brief Buffer owned by the emitter when writing to a stream */
+  std::unique_ptr<YamlOutputBuffer> m_ownedBuffer;
+  /** @brief Destination buffer (owned or caller-supplied) */
+  YamlOutputBuffer *m_out;
+  /** @brief Currently open collections, innermost last */
+  std::vector<Frame> m_stack;
+  /** @brief Set once the root collection has been opened */
+  bool m_started = false;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,140 @@
+#pragma once
+#include "YamlElement.hpp"
+#include "YamlParseLimits.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file YamlLayeredConfig.hpp
+ * @brief Merged view over a stack of configuration files
+ *
+ * Provides functionality to:
+ * - Stack mapping documents by priority (base, region, environment, host...)
+ * - Look up values through the layers without copying any of them
+ * - Share one parsed layer between any number of stacks
+ * - Flatten the stack into one ordinary YamlMap in a single pass
+ *
+ * Merge rules: layers added later take priority. Mappings present in several
+ * layers are merged key by key, recursively. Any other value (scalar or
+ * sequence) replaces the value of lower layers as a whole, and it shadows
+ * lower mappings at the same path as well: "db: none" in a host layer hides
+ * every "db.*" key of the base.
+ *
+ * Usage example:
+ * @code
+ *   auto base = YamlLayeredConfig::load("base.yaml");   // parsed once, shared
+ *   for (const auto &host : hosts) {
+ *     YamlLayeredConfig config;
+ *     config.addLayer("base", base);
+ *     config.addFile("env/" + env + ".yaml");
+ *     config.addFile("hosts/" + host + ".yaml");
+ *     int port = config.get("server").at("port").asInt();
+ *     std::string from = config.layerName(config.get("server").at("port").layer());
+ *   }
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Read-only handle to one node of a layered configuration
+ *
+ * A mapping node refers to the mappings of every layer that has one at its
+ * path; any other node refers to the single value that wins. Handles point
+ * into the layers and stay valid as long as the YamlLayeredConfig they came
+ * from is neither destroyed nor given new layers.
+ */
+class YamlLayeredNode {
+public:
+  bool isMap() const;
+
+  size_t layer() const;
+
+  /**
+   * @name Mapping Access Methods
+   * @{
+   */
+  YamlLayeredNode at(const std::string &key) const;
+
+  bool contains(const std::string &key) const;
+
+  std::vector<std::string> keys() const;
+
+  size_t size() const;
+  /** @} */
+
+  /**
+   * @name Value Access Methods
+   * Delegate to the winning element; they throw TypeException for mappings
+   * @{
+   */
+  const YamlElement &value() const;
+
+  const std::string &asString() const;
+
+  int asInt() const;
+
+  double asDouble() const;
+
+  bool asBool() const;
+
+  const YamlSeq &asSeq() const;
+  /** @} */
+
+  YamlItem toItem() const;
+
+  /** @brief A layer's mapping at this node's path, tagged with the layer index */
+  using LayerMap = std::pair<size_t, const YamlMap *>;
+
+private:
+  friend class YamlLayeredConfig;
+
+  YamlLayeredNode() = default;
+
+  /** @brief Mappings at this path, highest priority first (empty for other values) */
+  std::vector<LayerMap> m_maps;
+  /** @brief The winning value when it is not a mapping */
+  const YamlItem *m_leaf = nullptr;
+  /** @brief Index of the layer that supplies the value (the highest one for mappings) */
+  size_t m_layer = 0;
+};
+
+/**
+ * @brief Ordered stack of mapping documents with a merged view
+ *
+ * Layers are held by shared pointer, so one parsed base can back many
+ * stacks; nothing is copied until toItem() or flatten() is called.
+ */
+class YamlLayeredConfig {
+public:
+  YamlLayeredConfig() = default;
+
+  void addLayer(const std::string &name, std::shared_ptr<const YamlMap> map);
+
+  void addFile(const std::string &filename, const ParseLimits &limits = ParseLimits());
+
+  static std::shared_ptr<const YamlMap> load(const std::string &filename, const ParseLimits &limits = ParseLimits());
+
+  size_t layerCount() const;
+
+  const std::string &layerName(size_t index) const;
+
+  const YamlMap &layer(size_t index) const;
+
+  YamlLayeredNode root() const;
+
+  YamlLayeredNode get(const std::string &key) const;
+
+  YamlMap flatten() const;
+
+private:
+  /** @brief Layer names, lowest priority first */
+  std::vector<std::string> m_names;
+  /** @brief Layer documents, in the same order */
+  std::vector<std::shared_ptr<const YamlMap>> m_layers;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,131 @@
+#pragma once
+#include "YamlFlowParser.hpp"
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlLinter.hpp
+ * @brief Validate-only mode that reports every problem of a document in one pass
+ *
+ * Provides functionality to:
+ * - Check documents with the parser's rules without building a tree
+ * - Keep going after an error: the rest of the offending entry is skipped
+ *   and checking resumes at the next line indented the same or less
+ * - Lint many files on a pool of threads and report the throughput
+ *
+ * Each diagnostic corresponds to an exception YamlParser would throw on the
+ * same document (syntax and encoding errors, malformed block headers and flow
+ * collections, invalid escapes, out-of-range numbers, undefined aliases and
+ * merge targets). Parse limits are not checked, apart from a nesting depth
+ * cap that keeps the recursion within the stack.
+ *
+ * Usage example:
+ * @code
+ *   YamlLinter linter;
+ *   YamlLintReport report = linter.lintFiles(paths);
+ *   for (const auto &diagnostic : report.diagnostics)
+ *     std::cerr << diagnostic.str() << "\n";
+ *   std::cerr << report.megabytesPerSecond() << " MB/s\n";
+ * @endcode
+ */
+
+namespace yamlparser {
+
+class YamlScanner;
+
+/**
+ * @brief One problem found in a document
+ */
+struct YamlDiagnostic {
+  /** @brief File name, or the name given to YamlLinter::lintString() */
+  std::string file;
+  /** @brief 1-based line number; 0 if the problem concerns the whole file */
+  size_t line = 0;
+  /** @brief Description of the problem */
+  std::string message;
+
+  std::string str() const;
+};
+
+/**
+ * @brief Result of linting a set of files
+ */
+struct YamlLintReport {
+  /** @brief Diagnostics of all files, in the order the files were given */
+  std::vector<YamlDiagnostic> diagnostics;
+  /** @brief Number of files checked */
+  size_t files = 0;
+  /** @brief Number of files with at least one diagnostic */
+  size_t failedFiles = 0;
+  /** @brief Total size of the files read */
+  size_t bytes = 0;
+  /** @brief Number of threads used */
+  size_t threads = 0;
+  /** @brief Wall-clock time of the whole run */
+  double seconds = 0.0;
+
+  bool ok() const;
+
+  double megabytesPerSecond() const;
+
+  double filesPerSecond() const;
+};
+
+/**
+ * @brief Checks documents and collects all their diagnostics
+ *
+ * One instance checks one document at a time; lintFiles() gives each worker
+ * thread its own instance.
+ */
+class YamlLinter {
+public:
+  explicit YamlLinter(size_t maxDepth = YamlFlowParser::DEFAULT_MAX_DEPTH);
+
+  std::vector<YamlDiagnostic> lintString(const std::string &content, const std::string &name = "<string>");
+
+  std::vector<YamlDiagnostic> lintFile(const std::string &filename);
+
+  YamlLintReport lintFiles(const std::vector<std::string> &files, size_t threads = 0) const;
+
+private:
+  /** @brief What an anchor refers to, as far as merge keys care */
+  enum class AnchorKind { Scalar, Sequence, Mapping };
+
+  std::vector<YamlDiagnostic> lintFile(const std::string &filename, size_t &bytes);
+
+  void lintMap(size_t &idx, size_t indent, size_t depth);
+
+  void lintMapEntry(size_t &idx, size_t depth, std::set<std::string> &keys);
+
+  void lintSeq(size_t &idx, size_t indent, size_t depth);
+
+  void lintSeqElement(size_t &idx, size_t depth);
+
+  void lintAnchor(const std::string &value, size_t &idx, size_t depth);
+
+  void lintFlowCollection(const std::string &value, size_t line, size_t depth) const;
+
+  AnchorKind resolveAlias(const std::string &value) const;
+
+  bool enter(size_t &idx, size_t indent, size_t depth);
+
+  void recover(size_t &idx);
+
+  void report(size_t line, const std::string &message);
+
+  /** @brief Deepest nesting checked; deeper blocks get one diagnostic and are skipped */
+  size_t m_maxDepth;
+  /** @brief Tokens of the document being checked */
+  const YamlScanner *m_tokens = nullptr;
+  /** @brief Name reported in the diagnostics of the document being checked */
+  std::string m_name;
+  /** @brief Anchors defined so far in the document */
+  std::map<std::string, AnchorKind> m_anchors;
+  /** @brief Diagnostics of the document being checked */
+  std::vector<YamlDiagnostic> m_diagnostics;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,217 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file YamlMemory.hpp
+ * @brief Memory resources, pooled trees' storage and per-thread allocation accounting
+ *
+ * Provides functionality to:
+ * - Supply memory through a YamlMemoryResource, selected per thread and per
+ *   scope with YamlMemoryScope
+ * - Keep config trees in a dedicated arena (YamlArenaResource) by copying
+ *   them into a YamlPooledTree (see YamlPooledTree.hpp)
+ * - Count allocations, bytes and the high-water mark of a resource
+ *   (CountingMemoryResource) or of everything a thread allocates while a
+ *   YamlAllocationTally is active
+ *
+ * This mirrors std::pmr, which is not available in C++14. YamlSeq, YamlMap
+ * and std::string stay standard containers on the global heap, so a parsed
+ * tree never depends on a resource; YamlPooledTree is the opt-in copy that
+ * lives entirely in one.
+ *
+ * A tally counts allocations made through any YamlMemoryResource. Programs
+ * that also link the yamlparser_heap_tally object library, which replaces
+ * global operator new and delete, have every heap allocation of the thread
+ * counted as well: tree nodes, scalar and key strings, and the parser's
+ * temporaries. ParseStats fills its allocation fields from a tally.
+ *
+ * Usage example:
+ * @code
+ *   YamlArenaResource arena;
+ *   std::unique_ptr<YamlPooledTree> tree;
+ *   {
+ *     YamlParser parser;
+ *     parser.parse("config.yaml");
+ *     tree.reset(new YamlPooledTree(parser.root(), &arena)); // one block in the arena
+ *   }                                                         // the heap tree is freed here
+ *   int port = tree->get("server").at("port").asInt();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Abstract source of memory for pooled trees
+ *
+ * Same contract as std::pmr::memory_resource: deallocate() receives the
+ * size and alignment that were passed to allocate(). allocate() throws
+ * std::bad_alloc on failure.
+ */
+class YamlMemoryResource {
+public:
+  virtual ~YamlMemoryResource() = default;
+
+  void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+  void deallocate(void *p, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+protected:
+  virtual void *doAllocate(size_t bytes, size_t alignment) = 0;
+
+  virtual void doDeallocate(void *p, size_t bytes, size_t alignment) noexcept = 0;
+};
+
+YamlMemoryResource *defaultMemoryResource() noexcept;
+
+YamlMemoryResource *currentMemoryResource() noexcept;
+
+/**
+ * @brief Makes a resource current for the calling thread until the scope ends
+ *
+ * Scopes nest; the destructor restores the previous resource. A
+ * YamlPooledTree created without an explicit resource uses the current one
+ * and keeps it after the scope ends.
+ */
+class YamlMemoryScope {
+public:
+  explicit YamlMemoryScope(YamlMemoryResource *resource) noexcept;
+
+  ~YamlMemoryScope();
+
+  YamlMemoryScope(const YamlMemoryScope &)            = delete;
+  YamlMemoryScope &operator=(const YamlMemoryScope &) = delete;
+
+private:
+  /** @brief Resource that was current before this scope */
+  YamlMemoryResource *m_previous;
+};
+
+/**
+ * @brief Resource that forwards to another one and counts what passes through
+ *
+ * Counters are atomic, so trees may be built and destroyed on any thread.
+ */
+class CountingMemoryResource : public YamlMemoryResource {
+public:
+  explicit CountingMemoryResource(YamlMemoryResource *upstream = defaultMemoryResource()) noexcept;
+
+  size_t allocations() const noexcept;
+
+  size_t allocatedBytes() const noexcept;
+
+  size_t liveBytes() const noexcept;
+
+  size_t peakBytes() const noexcept;
+
+  void resetPeak() noexcept;
+
+protected:
+  void *doAllocate(size_t bytes, size_t alignment) override;
+
+  void doDeallocate(void *p, size_t bytes, size_t alignment) noexcept override;
+
+private:
+  /** @brief Resource that provides the memory */
+  YamlMemoryResource *m_upstream;
+  /** @brief Number of allocations */
+  std::atomic<size_t> m_allocations;
+  /** @brief Total bytes allocated */
+  std::atomic<size_t> m_allocatedBytes;
+  /** @brief Bytes currently allocated */
+  std::atomic<size_t> m_liveBytes;
+  /** @brief Highest value of m_liveBytes */
+  std::atomic<size_t> m_peakBytes;
+};
+
+/**
+ * @brief Monotonic arena: carves allocations out of large chunks
+ *
+ * deallocate() is a no-op; all memory is returned at once by release() or
+ * the destructor. Allocation is a pointer bump, and a whole tree is freed
+ * without visiting its nodes. Not thread-safe; trees allocated from it must
+ * be destroyed before it.
+ */
+class YamlArenaResource : public YamlMemoryResource {
+public:
+  explicit YamlArenaResource(size_t chunkSize = 64 * 1024, YamlMemoryResource *upstream = defaultMemoryResource());
+
+  ~YamlArenaResource() override;
+
+  YamlArenaResource(const YamlArenaResource &)            = delete;
+  YamlArenaResource &operator=(const YamlArenaResource &) = delete;
+
+  void release() noexcept;
+
+  size_t reservedBytes() const noexcept;
+
+protected:
+  void *doAllocate(size_t bytes, size_t alignment) override;
+
+  void doDeallocate(void *p, size_t bytes, size_t alignment) noexcept override;
+
+private:
+  /** @brief One block obtained from the upstream resource */
+  struct Chunk {
+    void  *memory;
+    size_t size;
+  };
+
+  /** @brief Default chunk size */
+  size_t m_chunkSize;
+  /** @brief Resource that provides the chunks */
+  YamlMemoryResource *m_upstream;
+  /** @brief All chunks, the last one being filled */
+  std::vector<Chunk> m_chunks;
+  /** @brief Next free byte of the last chunk */
+  char *m_cursor = nullptr;
+  /** @brief End of the last chunk */
+  char *m_end = nullptr;
+};
+
+/**
+ * @brief Per-thread allocation counters filled while a YamlAllocationTally is active
+ *
+ * Allocations through a YamlMemoryResource are counted, and every heap
+ * allocation when the yamlparser_heap_tally library is linked. The live byte
+ * count is relative to the start of the tally and may drop below zero when
+ * older memory is freed; peakBytes is its highest value.
+ */
+struct YamlAllocationCounters {
+  /** @brief Number of allocations */
+  size_t allocations = 0;
+  /** @brief Total bytes allocated */
+  size_t allocatedBytes = 0;
+  /** @brief Bytes allocated minus bytes freed */
+  long long liveBytes = 0;
+  /** @brief Highest value of liveBytes */
+  size_t peakBytes = 0;
+};
+
+/**
+ * @brief Attributes the calling thread's allocations to a set of counters until the scope ends
+ *
+ * Works with any resource, so the memory of a single document can be
+ * measured without replacing the resource it is allocated from. Tallies
+ * nest; the inner one receives the counts while it is active.
+ */
+class YamlAllocationTally {
+public:
+  explicit YamlAllocationTally(YamlAllocationCounters &counters) noexcept;
+
+  ~YamlAllocationTally();
+
+  YamlAllocationTally(const YamlAllocationTally &)            = delete;
+  YamlAllocationTally &operator=(const YamlAllocationTally &) = delete;
+
+private:
+  /** @brief Counters that were active before this tally */
+  YamlAllocationCounters *m_previous;
+};
+
+void tallyHeapAllocation(size_t bytes) noexcept;
+
+void tallyHeapDeallocation(size_t bytes) noexcept;
+
+} // namespace yamlparser
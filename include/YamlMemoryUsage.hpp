@@ -0,0 +1,83 @@
+#pragma once
+#include "YamlElement.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlMemoryUsage.hpp
+ * @brief Heap usage breakdown of parsed YAML trees
+ *
+ * Provides functionality to:
+ * - Estimate the heap bytes held by a tree, split by category
+ * - Find bytes spent on identical subtrees, as produced by aliases and merge keys
+ * - List the largest subtrees by path
+ *
+ * Usage example:
+ * @code
+ *   YamlMemoryUsage usage = parser.memoryUsage(10);
+ *   std::cout << usage.toString();
+ *   for (const auto &subtree : usage.largest)
+ *     std::cout << subtree.path << ": " << subtree.bytes << "\n";
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Heap bytes of one subtree
+ */
+struct YamlSubtreeUsage {
+  /** @brief Location: keys joined with '.', sequence indices as "[i]" */
+  std::string path;
+  /** @brief Heap bytes of the subtree, including its own container */
+  size_t bytes = 0;
+};
+
+/**
+ * @brief Heap usage of a tree, split by category
+ *
+ * Sizes are what the containers request from their memory resource;
+ * allocator bookkeeping is not included. Map node sizes assume the usual
+ * red-black tree layout (three links and a color per node).
+ *
+ * Categories (they add up to totalBytes()):
+ * - containerBytes: the YamlMap/YamlSeq objects owned by collection elements
+ * - mapNodeBytes: one tree node per map entry, holding the key and the item
+ * - sequenceBytes: sequence storage in use
+ * - sequenceSlackBytes: sequence storage reserved beyond the size
+ * - stringBytes: heap buffers of keys and string values (short strings need none)
+ *
+ * duplicateBytes is not a separate category: it is the part of the total
+ * held by collections identical to one seen earlier in the walk.
+ */
+struct YamlMemoryUsage {
+  /** @brief Number of elements visited, not counting the root container */
+  size_t nodes = 0;
+  /** @brief Collection objects owned by elements */
+  size_t containerBytes = 0;
+  /** @brief Map entry nodes */
+  size_t mapNodeBytes = 0;
+  /** @brief Sequence storage in use */
+  size_t sequenceBytes = 0;
+  /** @brief Sequence capacity beyond size */
+  size_t sequenceSlackBytes = 0;
+  /** @brief Heap buffers of keys and string values */
+  size_t stringBytes = 0;
+  /** @brief Bytes of non-empty collections that repeat an earlier identical one */
+  size_t duplicateBytes = 0;
+  /** @brief Largest subtrees, biggest first (only filled when requested) */
+  std::vector<YamlSubtreeUsage> largest;
+
+  size_t totalBytes() const;
+
+  std::string toString() const;
+};
+
+YamlMemoryUsage memoryUsage(const YamlMap &map, size_t largestCount = 0);
+
+YamlMemoryUsage memoryUsage(const YamlSeq &seq, size_t largestCount = 0);
+
+YamlMemoryUsage memoryUsage(const YamlElement &element, size_t largestCount = 0);
+
+} // namespace yamlparser
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlNumberFormat.hpp
+ * @brief Number formatting kernel shared by all serializers
+ *
+ * Provides functionality to:
+ * - Format integers without iostreams or locale lookups
+ * - Format doubles with the shortest text that parses back to the same value
+ * - Produce text that the parser reads back with the same type
+ *
+ * Usage example:
+ * @code
+ *   char   buf[YamlNumberFormat::BUFFER_SIZE];
+ *   size_t len = YamlNumberFormat::formatDouble(0.1, buf);   // "0.1"
+ *   out.append(buf, len);
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Static utility class for locale-independent number formatting
+ *
+ * Double formatting rules:
+ * - The digits are the shortest decimal that round-trips exactly through strtod
+ * - The decimal separator is always '.', whatever the C locale says
+ * - Integral values keep a ".0" suffix so they are not read back as integers
+ * - Infinities and NaN are written as the YAML 1.2 forms .inf, -.inf and .nan
+ */
+class YamlNumberFormat {
+public:
+  /** @brief Buffer size large enough for any value formatted by this class */
+  static const size_t BUFFER_SIZE = 32;
+
+  static size_t formatInt(int value, char *buf);
+
+  static size_t formatDouble(double value, char *buf);
+
+  static std::string toString(int value);
+
+  static std::string toString(double value);
+};
+
+} // namespace yamlparser
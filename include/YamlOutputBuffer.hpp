@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * @file YamlOutputBuffer.hpp
+ * @brief Buffered output backend for YAML serialization
+ *
+ * Provides functionality to:
+ * - Render output into a growable in-memory buffer
+ * - Render output into a caller-supplied fixed-size buffer
+ * - Forward output to a std::ostream in large chunks instead of per line
+ * - Write indentation from a cached block of spaces
+ *
+ * Usage example:
+ * @code
+ *   std::ofstream file("out.yaml");
+ *   {
+ *     YamlOutputBuffer out(file);       // chunked writes to the file
+ *     YamlPrinter::print(map, out);
+ *   }                                   // remaining bytes written on destruction
+ *
+ *   YamlOutputBuffer mem;               // growable in-memory buffer
+ *   YamlPrinter::print(map, mem);
+ *   std::string text = mem.str();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Append-only character buffer with optional stream sink
+ *
+ * Operates in one of three modes, selected by the constructor:
+ * - Growable: storage is owned and grows as needed
+ * - Stream: storage is owned and grows up to one chunk, which is written to
+ *   the stream when full
+ * - Fixed: storage is supplied by the caller; overflowing it throws OutputException
+ *
+ * Owned storage starts small and is never zero-filled, so printing a tiny
+ * tree does not pay for a full chunk. The buffer never calls
+ * std::ostream::flush(); it only issues write() calls of up to one chunk at a
+ * time.
+ */
+class YamlOutputBuffer {
+public:
+  /** @brief Default chunk size used for stream mode */
+  static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+  YamlOutputBuffer();
+
+  explicit YamlOutputBuffer(std::ostream &os, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+  YamlOutputBuffer(char *buffer, size_t capacity);
+
+  ~YamlOutputBuffer();
+
+  YamlOutputBuffer(const YamlOutputBuffer &)            = delete;
+  YamlOutputBuffer &operator=(const YamlOutputBuffer &) = delete;
+
+  /**
+   * @name Append Methods
+   * @{
+   */
+  void append(const char *data, size_t size);
+
+  void append(const std::string &s);
+
+  void append(char c);
+
+  void appendIndent(int n);
+  /** @} */
+
+  void flush();
+
+  const char *data() const;
+
+  size_t size() const;
+
+  size_t capacity() const;
+
+  std::string str() const;
+
+  void clear();
+
+private:
+  enum class Mode { GROWABLE, STREAM, FIXED };
+
+  void makeRoom(size_t needed);
+
+  void grow(size_t needed, size_t limit);
+
+  /** @brief Selected output mode */
+  Mode m_mode;
+  /** @brief Owned storage (growable and stream modes), left uninitialized */
+  std::unique_ptr<char[]> m_storage;
+  /** @brief Start of the active storage (owned or caller-supplied) */
+  char *m_data = nullptr;
+  /** @brief Number of bytes currently buffered */
+  size_t m_size = 0;
+  /** @brief Capacity of the active storage */
+  size_t m_capacity = 0;
+  /** @brief Largest capacity the owned storage grows to (the chunk size in stream mode) */
+  size_t m_limit = 0;
+  /** @brief Destination stream (stream mode only) */
+  std::ostream *m_stream = nullptr;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,67 @@
+#pragma once
+#include "YamlParser.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file YamlParseCache.hpp
+ * @brief Persistent on-disk cache of parsed documents
+ *
+ * Provides functionality to:
+ * - Skip parsing when the same document content was parsed before
+ * - Store parsed trees as snapshot images keyed by a hash of the input text
+ * - Share one cache directory safely between processes
+ *
+ * Usage example:
+ * @code
+ *   YamlParseCache cache("/var/cache/myservice/yaml");
+ *   YamlParser     parser;
+ *   cache.parse(parser, "config.yaml");            // parses only on a miss
+ *
+ *   YamlSnapshotView view(cache.ensure("config.yaml")); // zero-copy access
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Opt-in cache layer in front of YamlParser::parse
+ *
+ * Entries are named after the SHA-256 digest of the document text, so a
+ * changed file simply produces a new entry, stale entries are never read and
+ * no document can be made to match another document's entry. Entries are
+ * written to a temporary file in the cache directory and renamed into place,
+ * so readers in other processes see either no entry or a complete one. An
+ * entry that fails validation is treated as a miss and rewritten.
+ */
+class YamlParseCache {
+public:
+  explicit YamlParseCache(const std::string &directory);
+
+  void parse(YamlParser &parser, const std::string &filename);
+
+  std::string ensure(const std::string &filename);
+
+  std::string entryPath(const std::string &content) const;
+
+  const std::string &directory() const;
+
+  size_t hits() const;
+
+  size_t misses() const;
+
+private:
+  bool load(YamlParser &parser, const std::string &path) const;
+
+  void store(const YamlParser &parser, const std::string &path) const;
+
+  /** @brief Directory holding the cache entries */
+  std::string m_directory;
+  /** @brief Number of documents served from the cache */
+  size_t m_hits = 0;
+  /** @brief Number of documents that had to be parsed */
+  size_t m_misses = 0;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @file YamlParseLimits.hpp
+ * @brief Resource limits for parsing untrusted input
+ *
+ * Provides functionality to:
+ * - Reject inputs larger than a byte limit before reading them
+ * - Bound the nesting depth, the number of nodes and the length of scalars
+ * - Cap the nodes copied by aliases and merge keys, which stops alias bombs
+ *   before their exponential copies are made
+ *
+ * A parse that exceeds a limit throws LimitException as soon as the limit is
+ * reached. Every limit defaults to 0, which means unlimited.
+ *
+ * Usage example:
+ * @code
+ *   YamlParser parser(ParseLimits::untrusted());
+ *   try {
+ *     parser.parseString(upload);
+ *   } catch (const LimitException &e) {
+ *     reject(e.what());
+ *   }
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Upper bounds on the work of one parse; 0 disables a limit
+ *
+ * Depth counts like ParseStats::maxDepth: the root collection is at depth 0
+ * and the values of a top-level mapping are at depth 1. Nodes are counted as
+ * the parser creates them, including alias and merge copies, so a value that
+ * is later replaced still counts.
+ */
+struct ParseLimits {
+  /** @brief Largest accepted document, in bytes */
+  size_t maxInputBytes = 0;
+  /** @brief Deepest accepted nesting level of any node, inline sequences and alias copies included */
+  size_t maxDepth = 0;
+  /** @brief Most nodes the parser may create */
+  size_t maxNodes = 0;
+  /** @brief Longest accepted scalar or key, in bytes of source text */
+  size_t maxScalarBytes = 0;
+  /** @brief Most nodes that aliases and merge keys may copy in total */
+  size_t maxAliasNodes = 0;
+
+  static ParseLimits untrusted();
+
+  bool unlimited() const;
+};
+
+} // namespace yamlparser
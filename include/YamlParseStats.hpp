@@ -0,0 +1,89 @@
+#pragma once
+#include "YamlElement.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlParseStats.hpp
+ * @brief Optional statistics and per-phase timings collected while parsing
+ *
+ * Provides functionality to:
+ * - Count lines, nodes per element type, anchors, aliases and merge keys
+ * - Record the maximum nesting depth and the amount of scalar text
+ * - Count the allocations made during the parse and their high-water mark
+ * - Split the wall time of a parse into read, scan, build and scalar-typing phases
+ *
+ * Statistics are only collected when a ParseStats object is passed to
+ * YamlParser::parse() or YamlParser::parseString(); the plain overloads skip
+ * all bookkeeping.
+ *
+ * Usage example:
+ * @code
+ *   ParseStats stats;
+ *   parser.parse("config.yaml", stats);
+ *   std::cerr << stats.toString();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Counters and timings of one parse
+ *
+ * Phases:
+ * - read:   loading the file into memory (zero for parseString)
+ * - scan:   tokenizing the text into lines (YamlScanner) and detecting the root type
+ * - build:  building the tree, excluding scalar typing
+ * - scalar: typing scalar values (bool/int/double/string) and inline sequences
+ *
+ * Depth counts the root collection as 0, so the values of a top-level
+ * mapping are at depth 1.
+ */
+struct ParseStats {
+  /** @brief Number of element types, for indexing nodes */
+  static const size_t TYPE_COUNT = 7;
+
+  /** @brief Lines in the document */
+  size_t lines = 0;
+  /** @brief Nodes in the resulting tree, indexed by ElementType (alias and merge copies included) */
+  size_t nodes[TYPE_COUNT] = {};
+  /** @brief Anchors defined */
+  size_t anchors = 0;
+  /** @brief Aliases resolved, excluding merge keys */
+  size_t aliases = 0;
+  /** @brief Merge keys (<<) applied */
+  size_t mergeKeys = 0;
+  /** @brief Deepest nesting level of any node */
+  size_t maxDepth = 0;
+  /** @brief Bytes of scalar source text, including block scalars and inline sequences */
+  size_t scalarBytes = 0;
+
+  /** @brief Allocations made by the parsing thread during the parse: heap allocations when the program links
+   *         yamlparser_heap_tally, plus any made through a YamlMemoryResource (see YamlMemory.hpp) */
+  size_t allocations = 0;
+  /** @brief Bytes of those allocations */
+  size_t allocatedBytes = 0;
+  /** @brief High-water mark of those bytes minus the ones freed during the parse */
+  size_t peakAllocatedBytes = 0;
+
+  /** @brief Seconds spent reading the file */
+  double readSeconds = 0.0;
+  /** @brief Seconds spent checking the encoding, tokenizing lines and detecting the root */
+  double scanSeconds = 0.0;
+  /** @brief Seconds spent building the tree, excluding scalarSeconds */
+  double buildSeconds = 0.0;
+  /** @brief Seconds spent typing scalar values */
+  double scalarSeconds = 0.0;
+
+  size_t nodeCount(YamlElement::ElementType type) const;
+
+  size_t totalNodes() const;
+
+  double totalSeconds() const;
+
+  void reset();
+
+  std::string toString() const;
+};
+
+} // namespace yamlparser
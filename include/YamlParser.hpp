@@ -1,6 +1,10 @@
 ﻿#pragma once
 #include "YamlElement.hpp"
 #include "YamlException.hpp"
+#include "YamlMemoryUsage.hpp"
+#include "YamlParseLimits.hpp"
+#include "YamlParseStats.hpp"
+#include <functional>
 #include <string>
 #include <map>
 #include <vector>
@@ -9,10 +13,21 @@ namespace yamlparser {
 
 // Forward declarations for friend functions
 class YamlParser;
-YamlItem parseAnchor(const std::string &value, const std::vector<std::string> &lines, size_t &idx,
+class YamlScanner;
+class YamlTracer;
+struct YamlToken;
+YamlItem parseAnchor(const std::string &value, const YamlScanner &tokens, size_t &idx,
                      std::map<std::string, YamlItem> &anchors, YamlParser &parser);
 YamlItem parseInlineSeq(const std::string &value);
 
+/**
+ * @brief Called between the top-level entries of a parse
+ * @param bytesConsumed Offset of the entry about to be parsed; equals totalBytes once the parse is done
+ * @param totalBytes Size of the document, after a byte order mark and '\r' line breaks are dropped
+ * @details Throwing from the handler stops the parse with that exception.
+ */
+using YamlProgressHandler = std::function<void(size_t bytesConsumed, size_t totalBytes)>;
+
 /**
  * @brief Main YAML parsing class
  *
@@ -21,6 +36,7 @@ YamlItem parseInlineSeq(const std::string &value);
  * - Support both sequence and mapping root elements
  * - Access parsed data through type-safe interfaces
  * - Handle YAML anchors and aliases
+ * - Enforce resource limits on untrusted input (see YamlParseLimits.hpp)
  * - Provide proper exception-based error handling
  *
  * Usage example:
@@ -42,9 +58,15 @@ YamlItem parseInlineSeq(const std::string &value);
  */
 class YamlParser {
   // Grant friend access to helper functions that need internal parsing methods
-  friend YamlItem parseAnchor(const std::string &value, const std::vector<std::string> &lines, size_t &idx,
+  friend YamlItem parseAnchor(const std::string &value, const YamlScanner &tokens, size_t &idx,
                               std::map<std::string, YamlItem> &anchors, YamlParser &parser);
   friend YamlItem parseInlineSeq(const std::string &value);
+  // The flow parser types its scalars like block scalars
+  friend class YamlFlowParser;
+  // The linter checks scalars the way the parser types them
+  friend class YamlLinter;
+  // The parse cache loads cached trees directly into the root storage
+  friend class YamlParseCache;
 
 public:
   /**
@@ -52,8 +74,22 @@ public:
    */
   YamlParser() = default;
 
+  explicit YamlParser(const ParseLimits &limits);
+
+  void setLimits(const ParseLimits &limits);
+
+  const ParseLimits &limits() const;
+
+  void setProgressHandler(YamlProgressHandler handler);
+
   void parse(const std::string &filename);
 
+  void parse(const std::string &filename, ParseStats &stats);
+
+  void parseString(const std::string &content);
+
+  void parseString(const std::string &content, ParseStats &stats);
+
   bool isSequenceRoot() const;
 
   const YamlSeq &sequenceRoot() const;
@@ -62,20 +98,18 @@ public:
 
   const YamlItem &get(const std::string &key) const;
 
-private:
-  YamlMap parseMap(const std::vector<std::string> &lines, size_t &idx, int indent);
+  YamlMemoryUsage memoryUsage(size_t largestCount = 0) const;
 
-  bool parseMapEntry(const std::vector<std::string> &lines, size_t &idx, int indent, std::string::size_type curIndent,
-                     const std::string &line, YamlMap &map);
+private:
+  YamlMap parseMap(const YamlScanner &tokens, size_t &idx, int indent);
 
-  void validateMapStructure(const std::string &line, size_t lineNumber, std::string &key, std::string &value);
+  void validateMapStructure(const YamlScanner &tokens, const YamlToken &token, std::string &key, std::string &value);
 
   void handleMapSyntaxError(const std::string &error, const std::string &context, size_t lineNumber);
 
-  YamlSeq parseSeq(const std::vector<std::string> &lines, size_t &idx, int indent);
+  YamlSeq parseSeq(const YamlScanner &tokens, size_t &idx, int indent);
 
-  bool parseSeqElement(const std::vector<std::string> &lines, size_t &idx, int indent, std::string::size_type curIndent,
-                       const std::string &line, YamlSeq &seq);
+  bool parseSeqElement(const YamlScanner &tokens, size_t &idx, int indent, YamlSeq &seq);
 
   void validateSeqStructure(const std::string &line, size_t lineNumber);
 
@@ -83,6 +117,30 @@ private:
 
   static YamlElement parseScalar(const std::string &value);
 
+  template <typename Fn> void withStats(ParseStats &stats, Fn parseFn);
+
+  YamlElement typeScalar(const std::string &value);
+
+  YamlItem typeFlowCollection(const std::string &value);
+
+  YamlItem typeBlockScalar(const YamlScanner &tokens, size_t &idx, size_t indent, const std::string &header);
+
+  void collectTreeStats() const;
+
+  YamlTracer *sectionTracer() const;
+
+  void checkInputBytes(size_t bytes) const;
+
+  void reportProgress(const YamlScanner &tokens, size_t idx) const;
+
+  void enterCollection(size_t line);
+
+  void addNodes(size_t count);
+
+  void checkScalar(size_t bytes) const;
+
+  void checkAliasExpansion(const std::string &value, const YamlMap *mergeInto);
+
   static std::string preprocessScalarValue(const std::string &value);
 
   static YamlElement tryParsePrimitive(const std::string &cleanValue);
@@ -102,6 +160,30 @@ private:
 
   /** @brief Storage for named anchors to support YAML aliases */
   std::map<std::string, YamlItem> m_anchors;
+
+  /** @brief Statistics of the parse in progress (null when not requested) */
+  ParseStats *m_stats = nullptr;
+
+  /** @brief Called between top-level entries (empty when not set) */
+  YamlProgressHandler m_progress;
+
+  /** @brief Tracer of the parse in progress (null when not tracing, see YamlTrace.hpp) */
+  YamlTracer *m_tracer = nullptr;
+
+  /** @brief Number of parseMap()/parseSeq() calls currently active */
+  size_t m_depth = 0;
+
+  /** @brief Limits applied to every parse */
+  ParseLimits m_limits;
+
+  /** @brief Nodes created by the parse in progress, counted against ParseLimits::maxNodes */
+  size_t m_nodes = 0;
+
+  /** @brief Nodes copied by aliases and merge keys in the parse in progress */
+  size_t m_aliasNodes = 0;
+
+  /** @brief 1-based line being parsed, reported when a limit is exceeded */
+  size_t m_line = 0;
 };
 
 } // namespace yamlparser
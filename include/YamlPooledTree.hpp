@@ -0,0 +1,100 @@
+#pragma once
+#include "YamlElement.hpp"
+#include "YamlMemory.hpp"
+#include "YamlSnapshot.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @file YamlPooledTree.hpp
+ * @brief Read-only copy of a parsed tree held in a single block of a memory resource
+ *
+ * Provides functionality to:
+ * - Move a configuration tree out of the global heap into an arena or any
+ *   other YamlMemoryResource, keys and strings included
+ * - Query it like a snapshot view (binary search per mapping level)
+ * - Convert any node back into an ordinary YamlItem
+ *
+ * The parser keeps building standard YamlSeq/YamlMap trees; a pooled tree is
+ * an opt-in copy for long-lived configuration that should not fragment the
+ * heap. It uses the snapshot image layout and costs exactly one allocation.
+ *
+ * Usage example:
+ * @code
+ *   YamlArenaResource arena;
+ *   YamlParser        parser;
+ *   parser.parse("config.yaml");
+ *   YamlPooledTree tree(parser.root(), &arena);
+ *   int port = tree.get("server").at("port").asInt();
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Immutable tree stored in one block obtained from a YamlMemoryResource
+ *
+ * The block is returned to the resource when the tree is destroyed, so the
+ * resource must outlive the tree. Node handles stay valid until then.
+ */
+class YamlPooledTree {
+public:
+  explicit YamlPooledTree(const YamlMap &map, YamlMemoryResource *resource = currentMemoryResource());
+
+  explicit YamlPooledTree(const YamlSeq &seq, YamlMemoryResource *resource = currentMemoryResource());
+
+  YamlPooledTree(YamlPooledTree &&other) noexcept            = default;
+  YamlPooledTree &operator=(YamlPooledTree &&other) noexcept = default;
+
+  YamlPooledTree(const YamlPooledTree &)            = delete;
+  YamlPooledTree &operator=(const YamlPooledTree &) = delete;
+
+  bool isSequenceRoot() const;
+
+  YamlSnapshotNode root() const;
+
+  YamlSnapshotNode get(const std::string &key) const;
+
+  size_t nodeCount() const;
+
+  size_t bytes() const;
+
+  YamlMemoryResource *resource() const;
+
+private:
+  /**
+   * @brief Owner of the memory block; declared before the view so it is released after it
+   */
+  class Block {
+  public:
+    Block(const std::string &image, YamlMemoryResource *from);
+
+    ~Block();
+
+    Block(Block &&other) noexcept;
+
+    Block &operator=(Block &&other) noexcept;
+
+    Block(const Block &)            = delete;
+    Block &operator=(const Block &) = delete;
+
+    /** @brief Resource the block came from */
+    YamlMemoryResource *resource;
+    /** @brief Start of the block (null after a move) */
+    void *memory;
+    /** @brief Size of the block in bytes */
+    size_t size;
+
+  private:
+    void release() noexcept;
+  };
+
+  YamlPooledTree(const std::string &image, YamlMemoryResource *resource);
+
+  /** @brief Memory holding the image */
+  Block m_block;
+  /** @brief View over the block */
+  YamlSnapshotView m_view;
+};
+
+} // namespace yamlparser
@@ -1,6 +1,8 @@
 #pragma once
 #include "YamlElement.hpp"
+#include "YamlOutputBuffer.hpp"
 #include <ostream>
+#include <string>
 
 /**
  * @file YamlPrinter.hpp
@@ -10,7 +12,8 @@
  * - Convert YAML data structures to formatted text
  * - Support proper indentation and nesting
  * - Handle all YAML data types consistently
- * - Output to any standard stream
+ * - Output to any standard stream, in large chunks
+ * - Output to a growable or caller-supplied buffer (YamlOutputBuffer)
  *
  * Usage example:
  * @code
@@ -18,6 +21,7 @@
  *   // ... populate map ...
  *   YamlPrinter::print(map, std::cout);  // Print to console
  *   YamlPrinter::print(map, outFile);    // Print to file
+ *   std::string text = YamlPrinter::toString(map);
  * @endcode
  */
 
@@ -39,6 +43,16 @@ public:
   static void print(const YamlSeq &seq, std::ostream &os, int indent = 0);
 
   static void print(const YamlItem &item, std::ostream &os, int indent = 0);
+
+  static void print(const YamlMap &map, YamlOutputBuffer &out, int indent = 0);
+
+  static void print(const YamlSeq &seq, YamlOutputBuffer &out, int indent = 0);
+
+  static void print(const YamlItem &item, YamlOutputBuffer &out, int indent = 0);
+
+  static std::string toString(const YamlMap &map);
+
+  static std::string toString(const YamlSeq &seq);
 };
 
 } // namespace yamlparser
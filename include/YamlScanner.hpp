@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file YamlScanner.hpp
+ * @brief Single-pass line tokenizer underneath the parser
+ *
+ * Provides functionality to:
+ * - Split a document into lines and classify each one (blank, comment,
+ *   sequence item or entry) in one pass over the text
+ * - Record the indentation, the first ':' and the trimmed key, value and
+ *   sequence item text of every line as offsets into the source
+ *
+ * The parser builds the tree from these tokens instead of trimming and
+ * splitting the raw lines again at every level, so each byte of the input
+ * is scanned once. Tokens hold offsets only; the text is copied out when a
+ * key or scalar is actually needed.
+ *
+ * Usage example:
+ * @code
+ *   std::string text = "name: api\nports:\n  - 80\n";
+ *   YamlScanner scanner(text);
+ *   for (size_t i = 0; i < scanner.size(); ++i) {
+ *     const YamlToken &token = scanner[i];
+ *     if (token.kind == YamlTokenKind::Entry)
+ *       std::cout << token.line << ": " << scanner.str(scanner.key(token)) << "\n";
+ *   }
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Byte range of the source text
+ */
+struct YamlSpan {
+  /** @brief Offset of the first byte in the source */
+  size_t offset = 0;
+  /** @brief Number of bytes */
+  size_t length = 0;
+
+  bool empty() const {
+    return length == 0;
+  }
+};
+
+/**
+ * @brief What a line holds, judged by its first non-blank character
+ */
+enum class YamlTokenKind : unsigned char {
+  Blank,        ///< Empty, or only spaces and tabs
+  Comment,      ///< Starts with '#'
+  SequenceItem, ///< Starts with '-'
+  Entry         ///< Anything else: a "key: value" pair, or text that is not one
+};
+
+/**
+ * @brief One line of the document
+ *
+ * Positions within the line are stored as 32-bit offsets from its start to
+ * keep the token stream small; YamlScanner turns them into spans of the
+ * source. Key and value are split at the first ':' of the line, as the
+ * parser does for every kind of line, so the key of a sequence item
+ * "- a: 1" includes the dash (see YamlScanner::itemKey()).
+ */
+struct YamlToken {
+  /** @brief Offset of the first byte of the line in the source */
+  size_t offset = 0;
+  /** @brief 1-based line number */
+  uint32_t line = 0;
+  /** @brief Column of the first non-blank character; 0 for blank lines */
+  uint32_t indent = 0;
+  /** @brief End of the line without trailing blanks */
+  uint32_t textEnd = 0;
+  /** @brief End of the trimmed key, if the line has a ':' */
+  uint32_t keyEnd = 0;
+  /** @brief Start of the trimmed value, if the line has a ':' */
+  uint32_t valueBegin = 0;
+  /** @brief Start of the trimmed text after the '-' of a sequence item */
+  uint32_t itemBegin = 0;
+  /** @brief Line classification */
+  YamlTokenKind kind = YamlTokenKind::Blank;
+  /** @brief True if the line contains a ':' */
+  bool hasColon = false;
+};
+
+/**
+ * @brief Token stream of a document, one token per line
+ *
+ * A final newline does not start a new line, so "a: 1\n" has one token. The
+ * scanner keeps a reference to the source, which must outlive it.
+ */
+class YamlScanner {
+public:
+  explicit YamlScanner(const std::string &source);
+
+  YamlScanner(YamlScanner &&)                 = default;
+  YamlScanner(const YamlScanner &)            = delete;
+  YamlScanner &operator=(const YamlScanner &) = delete;
+
+  size_t size() const;
+
+  const YamlToken &operator[](size_t index) const;
+
+  const std::string &source() const;
+
+  std::string str(const YamlSpan &span) const;
+
+  /**
+   * @name Spans of a Token
+   * @{
+   */
+  YamlSpan content(const YamlToken &token) const;
+
+  YamlSpan text(const YamlToken &token) const;
+
+  YamlSpan key(const YamlToken &token) const;
+
+  YamlSpan value(const YamlToken &token) const;
+
+  YamlSpan item(const YamlToken &token) const;
+
+  YamlSpan itemKey(const YamlToken &token) const;
+  /** @} */
+
+  size_t nextNonBlank(size_t index) const;
+
+  bool startsWithSequence() const;
+
+private:
+  void scanLine(size_t begin, size_t end);
+
+  /** @brief The scanned document */
+  const std::string &m_source;
+
+  /** @brief One token per line */
+  std::vector<YamlToken> m_tokens;
+};
+
+} // namespace yamlparser
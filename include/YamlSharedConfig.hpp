@@ -0,0 +1,148 @@
+#pragma once
+#include "YamlParser.hpp"
+#include "YamlSnapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @file YamlSharedConfig.hpp
+ * @brief Publication of parsed documents to other processes through POSIX shared memory
+ *
+ * Provides functionality to:
+ * - Parse a document once and publish it as an immutable snapshot image
+ * - Map the published image read-only in any number of processes
+ * - Query it with the YamlSnapshotNode lookup API, without copying
+ * - Switch to a newer version by checking a generation counter
+ *
+ * Segments are named after the publication name: "/<name>" is a small
+ * control segment holding the current generation, and "/<name>.<generation>"
+ * holds the image of that generation. Only available on Linux; elsewhere the
+ * constructors throw SnapshotException.
+ *
+ * Usage example:
+ * @code
+ *   // Publisher process
+ *   YamlSharedPublisher publisher("myservice-config");
+ *   publisher.publish(parser.root());
+ *
+ *   // Worker processes
+ *   YamlSharedSubscriber subscriber("myservice-config");
+ *   auto doc = subscriber.current();   // null until something is published
+ *   if (doc) {
+ *     int port = doc->get("server").at("port").asInt();
+ *   }
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Writes new generations of a document into shared memory
+ *
+ * Each publish() creates a new image segment, fills it completely and only
+ * then advances the generation counter (release store), so subscribers never
+ * observe a partially written image. The previous generation's name is
+ * unlinked; processes that still map it keep a valid copy until they unmap.
+ * Published segments outlive the publisher; use remove() to delete them.
+ */
+class YamlSharedPublisher {
+public:
+  explicit YamlSharedPublisher(const std::string &name);
+
+  ~YamlSharedPublisher();
+
+  YamlSharedPublisher(const YamlSharedPublisher &)            = delete;
+  YamlSharedPublisher &operator=(const YamlSharedPublisher &) = delete;
+
+  std::uint64_t publish(const YamlMap &map);
+
+  std::uint64_t publish(const YamlSeq &seq);
+
+  std::uint64_t publish(const YamlParser &parser);
+
+  std::uint64_t generation() const;
+
+  static void remove(const std::string &name);
+
+  /** @brief Layout of the control segment (defined in the implementation) */
+  struct Control;
+
+private:
+  std::uint64_t publishImage(const std::string &image);
+
+  /** @brief Publication name (without the leading '/') */
+  std::string m_name;
+  /** @brief Mapped control segment */
+  Control *m_control = nullptr;
+};
+
+/**
+ * @brief One published generation, mapped read-only into this process
+ *
+ * Keeps the mapping alive for as long as any reference to it exists, so
+ * handles obtained from it stay valid across later refreshes.
+ */
+class YamlSharedDocument {
+public:
+  ~YamlSharedDocument();
+
+  YamlSharedDocument(const YamlSharedDocument &)            = delete;
+  YamlSharedDocument &operator=(const YamlSharedDocument &) = delete;
+
+  std::uint64_t generation() const;
+
+  const YamlSnapshotView &view() const;
+
+  YamlSnapshotNode root() const;
+
+  YamlSnapshotNode get(const std::string &key) const;
+
+private:
+  friend class YamlSharedSubscriber;
+
+  YamlSharedDocument(std::uint64_t generation, void *mapping, size_t size);
+
+  /** @brief Generation this document was published as */
+  std::uint64_t m_generation;
+  /** @brief Address of the read-only mapping */
+  void *m_mapping;
+  /** @brief Size of the mapping in bytes */
+  size_t m_size;
+  /** @brief View over the mapped image */
+  YamlSnapshotView m_view;
+};
+
+/**
+ * @brief Follows the generations published under a name
+ *
+ * current() costs one atomic load when nothing changed. A subscriber is
+ * not thread-safe; give each thread its own, or share the returned
+ * documents, which are immutable.
+ */
+class YamlSharedSubscriber {
+public:
+  explicit YamlSharedSubscriber(const std::string &name);
+
+  ~YamlSharedSubscriber();
+
+  YamlSharedSubscriber(const YamlSharedSubscriber &)            = delete;
+  YamlSharedSubscriber &operator=(const YamlSharedSubscriber &) = delete;
+
+  std::shared_ptr<const YamlSharedDocument> current();
+
+  std::uint64_t publishedGeneration();
+
+private:
+  bool attachControl();
+
+  /** @brief Publication name (without the leading '/') */
+  std::string m_name;
+  /** @brief Mapped control segment (null until the publisher has created it) */
+  const YamlSharedPublisher::Control *m_control = nullptr;
+  /** @brief Most recently mapped generation */
+  std::shared_ptr<const YamlSharedDocument> m_document;
+};
+
+} // namespace yamlparser
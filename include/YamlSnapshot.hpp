@@ -0,0 +1,192 @@
+#pragma once
+#include "YamlElement.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @file YamlSnapshot.hpp
+ * @brief Compact binary images of parsed documents and zero-copy views over them
+ *
+ * Provides functionality to:
+ * - Serialize a parsed tree into a position-independent binary image
+ * - Map an image file into memory and query it without parsing or allocating
+ * - Convert any node of an image back into an ordinary YamlItem
+ *
+ * Image layout (all integers in native byte order, checked on load):
+ * - A 32-byte header (magic, version, byte-order tag, node count, pool size)
+ * - A node table of 24-byte records in breadth-first order; the children of
+ *   a collection are stored contiguously, map children sorted by key
+ * - A string pool holding NUL-terminated keys and string values (deduplicated)
+ *
+ * save() replaces the file atomically (temporary file, then rename), so a
+ * view that already maps the file keeps reading the old image while new
+ * views see the new one.
+ *
+ * Usage example:
+ * @code
+ *   YamlParser parser;
+ *   parser.parse("config.yaml");
+ *   YamlSnapshot::save(parser.root(), "config.snap");
+ *
+ *   YamlSnapshotView view("config.snap");           // mmap, no parsing
+ *   int port = view.get("server").at("port").asInt(); // binary search per level
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief Static utility class that builds snapshot images
+ */
+class YamlSnapshot {
+public:
+  static std::string build(const YamlMap &map);
+
+  static std::string build(const YamlSeq &seq);
+
+  static std::string build(const YamlItem &item);
+
+  static void save(const YamlMap &map, const std::string &filename);
+
+  static void save(const YamlSeq &seq, const std::string &filename);
+
+  /** @brief On-disk node record (defined in the implementation) */
+  struct Record;
+};
+
+/**
+ * @brief Read-only handle to one node of a snapshot image
+ *
+ * Mirrors the accessors of YamlElement. Handles are small values that point
+ * into the image; they stay valid as long as the owning YamlSnapshotView
+ * (or caller-supplied memory) does. Accessing a value of the wrong type
+ * throws TypeException, missing keys throw KeyException and out-of-range
+ * indices throw IndexException.
+ */
+class YamlSnapshotNode {
+public:
+  YamlElement::ElementType type() const;
+
+  /**
+   * @name Type Check Methods
+   * @{
+   */
+  bool isNull() const;
+
+  bool isString() const;
+
+  bool isDouble() const;
+
+  bool isInt() const;
+
+  bool isBool() const;
+
+  bool isSeq() const;
+
+  bool isMap() const;
+
+  bool isScalar() const;
+  /** @} */
+
+  /**
+   * @name Value Access Methods
+   * @{
+   */
+  std::string asString() const;
+
+  const char *c_str() const;
+
+  size_t stringSize() const;
+
+  double asDouble() const;
+
+  int asInt() const;
+
+  bool asBool() const;
+  /** @} */
+
+  /**
+   * @name Collection Access Methods
+   * @{
+   */
+  size_t size() const;
+
+  YamlSnapshotNode at(size_t index) const;
+
+  YamlSnapshotNode at(const std::string &key) const;
+
+  bool contains(const std::string &key) const;
+
+  std::string keyAt(size_t index) const;
+  /** @} */
+
+  YamlItem toItem() const;
+
+private:
+  friend class YamlSnapshotView;
+
+  YamlSnapshotNode(const YamlSnapshot::Record *nodes, const char *pool, const YamlSnapshot::Record *record);
+
+  const YamlSnapshot::Record *find(const char *key, size_t keySize) const;
+
+  /** @brief Start of the image's node table */
+  const YamlSnapshot::Record *m_nodes;
+  /** @brief Start of the image's string pool */
+  const char *m_pool;
+  /** @brief Record of this node */
+  const YamlSnapshot::Record *m_record;
+};
+
+/**
+ * @brief Read-only document backed by a snapshot image
+ *
+ * The image is validated once when the view is created (bounds of every
+ * node and string reference); after that lookups read the image directly.
+ * A view either maps a file (read-only, shared pages) or refers to memory
+ * owned by the caller, which must be 8-byte aligned and outlive the view.
+ */
+class YamlSnapshotView {
+public:
+  explicit YamlSnapshotView(const std::string &filename);
+
+  YamlSnapshotView(const void *data, size_t size);
+
+  ~YamlSnapshotView();
+
+  YamlSnapshotView(YamlSnapshotView &&other) noexcept;
+
+  YamlSnapshotView &operator=(YamlSnapshotView &&other) noexcept;
+
+  YamlSnapshotView(const YamlSnapshotView &)            = delete;
+  YamlSnapshotView &operator=(const YamlSnapshotView &) = delete;
+
+  bool isSequenceRoot() const;
+
+  YamlSnapshotNode root() const;
+
+  YamlSnapshotNode get(const std::string &key) const;
+
+  size_t nodeCount() const;
+
+  size_t imageSize() const;
+
+private:
+  void attach(const void *data, size_t size);
+
+  void release();
+
+  /** @brief Start of the image */
+  const char *m_data = nullptr;
+  /** @brief Size of the image in bytes */
+  size_t m_size = 0;
+  /** @brief Number of records in the node table */
+  size_t m_nodeCount = 0;
+  /** @brief Address returned by mmap (null when not mapped) */
+  void *m_mapping = nullptr;
+  /** @brief Heap copy of the file when memory mapping is unavailable */
+  std::unique_ptr<std::uint64_t[]> m_heapCopy;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,202 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file YamlTrace.hpp
+ * @brief Scoped trace events of parser and printer internals, written as Chrome trace JSON
+ *
+ * Provides functionality to:
+ * - Record timed events for file reads, root detection, top-level sections,
+ *   alias and merge resolution, and printing (YamlTracer)
+ * - Attach the source line range to each parsing event
+ * - Write the events in the Chrome trace-event format, which chrome://tracing
+ *   and https://ui.perfetto.dev display as a timeline
+ *
+ * Tracing is enabled per thread with a YamlTraceScope. Without one, every
+ * trace point costs a single thread-local pointer check.
+ *
+ * Usage example:
+ * @code
+ *   YamlTracer tracer;
+ *   {
+ *     YamlTraceScope scope(&tracer);
+ *     parser.parse("manifest.yaml");
+ *     YamlPrinter::print(parser.root(), out);
+ *   }
+ *   tracer.writeFile("manifest.trace.json");
+ * @endcode
+ */
+
+namespace yamlparser {
+
+/**
+ * @brief One completed event
+ */
+struct YamlTraceEvent {
+  /** @brief Event name: a phase, a mapping key or a sequence index */
+  std::string name;
+  /** @brief Event category: "io", "scan", "build", "section", "resolve" or "print" */
+  const char *category = "";
+  /** @brief Start time in microseconds since the tracer was created */
+  double startMicros = 0.0;
+  /** @brief Duration in microseconds */
+  double durationMicros = 0.0;
+  /** @brief Small per-tracer number of the recording thread, starting at 1 */
+  unsigned thread = 0;
+  /** @brief First source line covered (1-based, 0 if not applicable) */
+  size_t firstLine = 0;
+  /** @brief Last source line covered (1-based, 0 if not applicable) */
+  size_t lastLine = 0;
+  /** @brief Additional information such as a file name or an alias */
+  std::string detail;
+};
+
+/**
+ * @brief Collects trace events; safe to share between threads
+ *
+ * Parsing events are recorded for the whole document and for every entry
+ * down to sectionDepth levels of nesting (1 = the top-level keys or items),
+ * so that deep documents do not produce one event per node.
+ */
+class YamlTracer {
+public:
+  explicit YamlTracer(size_t sectionDepth = 1);
+
+  YamlTracer(const YamlTracer &)            = delete;
+  YamlTracer &operator=(const YamlTracer &) = delete;
+
+  size_t sectionDepth() const;
+
+  double nowMicros() const;
+
+  void record(YamlTraceEvent event);
+
+  std::vector<YamlTraceEvent> events() const;
+
+  void clear();
+
+  void write(std::ostream &os) const;
+
+  void writeFile(const std::string &filename) const;
+
+private:
+  /** @brief Nesting depth down to which entries get their own event */
+  size_t m_sectionDepth;
+  /** @brief Time origin of the trace */
+  std::chrono::steady_clock::time_point m_origin;
+  /** @brief Guards m_events and m_threads */
+  mutable std::mutex m_mutex;
+  /** @brief Recorded events in order of completion */
+  std::vector<YamlTraceEvent> m_events;
+  /** @brief Threads seen so far; the index plus one is the thread number */
+  std::vector<std::thread::id> m_threads;
+};
+
+YamlTracer *currentTracer() noexcept;
+
+/**
+ * @brief Makes a tracer current for the calling thread until the scope ends
+ *
+ * Scopes nest; the destructor restores the previous tracer. A null tracer
+ * disables tracing inside the scope.
+ */
+class YamlTraceScope {
+public:
+  explicit YamlTraceScope(YamlTracer *tracer) noexcept;
+
+  ~YamlTraceScope();
+
+  YamlTraceScope(const YamlTraceScope &)            = delete;
+  YamlTraceScope &operator=(const YamlTraceScope &) = delete;
+
+private:
+  /** @brief Tracer that was current before this scope */
+  YamlTracer *m_previous;
+};
+
+/**
+ * @brief Records one event covering its own lifetime
+ *
+ * Does nothing when constructed with a null tracer, and the name is only
+ * copied when tracing.
+ */
+class YamlTraceSpan {
+public:
+  /**
+   * @brief Starts an event
+   * @param tracer Destination; null makes the span a no-op
+   * @param category Event category (must outlive the tracer, normally a literal)
+   * @param name Event name
+   * @param firstLine First source line covered (1-based, 0 if not applicable); also the initial last line
+   */
+  YamlTraceSpan(YamlTracer *tracer, const char *category, const char *name, size_t firstLine = 0)
+      : m_tracer(tracer) {
+    // The disabled path stays inline: trace points sit in the per-entry parsing loops
+    if (m_tracer)
+      start(category, name, firstLine);
+  }
+
+  /**
+   * @brief Starts an event
+   * @param tracer Destination; null makes the span a no-op
+   * @param category Event category (must outlive the tracer, normally a literal)
+   * @param name Event name, copied only when tracing
+   * @param firstLine First source line covered (1-based, 0 if not applicable); also the initial last line
+   */
+  YamlTraceSpan(YamlTracer *tracer, const char *category, const std::string &name, size_t firstLine = 0)
+      : m_tracer(tracer) {
+    if (m_tracer)
+      start(category, name, firstLine);
+  }
+
+  /**
+   * @brief Ends the event and records it, also when unwinding from an exception
+   */
+  ~YamlTraceSpan() {
+    if (m_tracer)
+      finish();
+  }
+
+  YamlTraceSpan(const YamlTraceSpan &)            = delete;
+  YamlTraceSpan &operator=(const YamlTraceSpan &) = delete;
+
+  /**
+   * @brief Check if the span will record an event
+   * @return true when constructed with a tracer and not cancelled
+   */
+  bool active() const {
+    return m_tracer != nullptr;
+  }
+
+  void setName(const std::string &name);
+
+  /**
+   * @brief Sets the last source line covered
+   * @param lastLine 1-based line number
+   */
+  void setLastLine(size_t lastLine) {
+    m_event.lastLine = lastLine;
+  }
+
+  void setDetail(const std::string &detail);
+
+  void cancel();
+
+private:
+  void start(const char *category, const std::string &name, size_t firstLine);
+
+  void finish() noexcept;
+
+  /** @brief Destination, or null when not tracing */
+  YamlTracer *m_tracer;
+  /** @brief Event being built; timing is filled in by the destructor */
+  YamlTraceEvent m_event;
+};
+
+} // namespace yamlparser
@@ -0,0 +1,213 @@
+#include "YamlAsyncParse.hpp"
+#include "YamlException.hpp"
+#include "YamlTrace.hpp"
+#include <algorithm>
+
+// Asynchronous parse implementation - a promise fulfilled on an executor
+// Key features:
+// - The task owns everything it needs (a copy of the options and, for
+//   buffers, the moved-in text), so the caller may return right away
+// - The caller's thread-local tracer is captured at launch and made current
+//   on the worker for the duration of the parse
+// - Cancellation and progress go through YamlParser's progress handler,
+//   which the parser calls between top-level entries only; the per-line
+//   work of the parse is unchanged
+// - The shared pool is created on first use and joined at exit
+
+namespace yamlparser {
+
+namespace {
+
+/**
+ * @brief Submits a parse to the executor of the options
+ * @param options How the parse runs
+ * @param parseFn Runs the parse on the parser it is given
+ * @return Future of the parser
+ */
+template <typename ParseFn> std::future<YamlParser> launch(const AsyncParseOptions &options, ParseFn parseFn) {
+  auto                    promise = std::make_shared<std::promise<YamlParser>>();
+  std::future<YamlParser> future  = promise->get_future();
+
+  YamlCancellation      cancellation = options.cancellation;
+  YamlProgressHandler   onProgress   = options.onProgress;
+  ParseLimits           limits       = options.limits;
+  YamlTracer           *tracer       = currentTracer();
+  std::function<void()> task         = [promise, parseFn, cancellation, onProgress, limits, tracer]() {
+    YamlTraceScope traceScope(tracer);
+    try {
+      cancellation.throwIfCancelled();
+      YamlParser parser(limits);
+      parser.setProgressHandler([&](size_t consumed, size_t total) {
+        // The last call only reports completion; the tree is already built
+        if (consumed < total)
+          cancellation.throwIfCancelled();
+        if (onProgress)
+          onProgress(consumed, total);
+      });
+      parseFn(parser);
+      parser.setProgressHandler(nullptr);
+      promise->set_value(std::move(parser));
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  };
+
+  if (options.executor)
+    options.executor(std::move(task));
+  else
+    YamlThreadPool::shared().submit(std::move(task));
+  return future;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Constructs a flag that is not set
+ */
+YamlCancellation::YamlCancellation() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+/**
+ * @brief Requests cancellation; parses sharing the flag stop at their next check
+ */
+void YamlCancellation::cancel() {
+  m_flag->store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Check if cancellation was requested
+ * @return true once cancel() was called on any copy
+ */
+bool YamlCancellation::cancelled() const {
+  return m_flag->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Stops the caller if cancellation was requested
+ * @throws CancelledException if cancel() was called on any copy
+ */
+void YamlCancellation::throwIfCancelled() const {
+  if (cancelled())
+    throw CancelledException();
+}
+
+/**
+ * @brief Starts the workers
+ * @param threads Number of workers; 0 uses one per hardware thread
+ */
+YamlThreadPool::YamlThreadPool(size_t threads) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  m_threads.reserve(threads);
+  try {
+    for (size_t i = 0; i < threads; ++i)
+      m_threads.emplace_back([this]() { run(); });
+  } catch (...) {
+    // The destructor does not run for a failed constructor: stop and join
+    // the workers already started before the exception leaves
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_ready.notify_all();
+    for (auto &thread : m_threads)
+      thread.join();
+    throw;
+  }
+}
+
+/**
+ * @brief Runs the queued tasks, then joins the workers
+ */
+YamlThreadPool::~YamlThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_ready.notify_all();
+  for (auto &thread : m_threads)
+    thread.join();
+}
+
+/**
+ * @brief Queues a task
+ * @param task Runs on one of the workers, in submission order
+ */
+void YamlThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+  m_ready.notify_one();
+}
+
+/**
+ * @brief Get an executor that submits to this pool
+ * @return Executor for AsyncParseOptions; the pool must outlive the parses using it
+ */
+YamlExecutor YamlThreadPool::executor() {
+  return [this](std::function<void()> task) { submit(std::move(task)); };
+}
+
+/**
+ * @brief Get the number of workers
+ * @return Number of threads of the pool
+ */
+size_t YamlThreadPool::size() const {
+  return m_threads.size();
+}
+
+/**
+ * @brief Get the pool used when no executor is given
+ * @return Pool with one worker per hardware thread, created on first use
+ */
+YamlThreadPool &YamlThreadPool::shared() {
+  static YamlThreadPool pool;
+  return pool;
+}
+
+/**
+ * @brief Worker loop: takes tasks until the pool stops and the queue is empty
+ */
+void YamlThreadPool::run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_ready.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+      if (m_tasks.empty())
+        return;
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    try {
+      task();
+    } catch (...) {
+      // Tasks report their own errors; one that escapes must not end the worker
+    }
+  }
+}
+
+/**
+ * @brief Parses a YAML file asynchronously
+ * @param filename Path to the YAML file to parse
+ * @param options Executor, limits, cancellation and progress handler
+ * @return Future of the parser holding the document; get() rethrows the errors of YamlParser::parse()
+ *         and CancelledException
+ */
+std::future<YamlParser> parseAsync(const std::string &filename, const AsyncParseOptions &options) {
+  return launch(options, [filename](YamlParser &parser) { parser.parse(filename); });
+}
+
+/**
+ * @brief Parses YAML text asynchronously
+ * @param content The YAML document; move it in to avoid a copy
+ * @param options Executor, limits, cancellation and progress handler
+ * @return Future of the parser holding the document; get() rethrows the errors of YamlParser::parseString()
+ *         and CancelledException
+ */
+std::future<YamlParser> parseStringAsync(std::string content, const AsyncParseOptions &options) {
+  auto text = std::make_shared<const std::string>(std::move(content));
+  return launch(options, [text](YamlParser &parser) { parser.parseString(*text); });
+}
+
+} // namespace yamlparser
@@ -0,0 +1,83 @@
+#include "YamlAtomicFile.hpp"
+#include "YamlException.hpp"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Atomic file replacement - write-to-temp, fsync, rename
+// Key features:
+// - The temporary file lives in the destination's directory, so the rename
+//   never crosses file systems
+// - Its name combines the process id and a counter, so concurrent writers
+//   in any process never share one
+// - Shared by YamlSnapshot::save() and YamlParseCache, whose readers may
+//   have the destination mapped while it is replaced
+
+namespace yamlparser {
+
+namespace {
+std::string temporaryName(const std::string &path) {
+  static std::atomic<unsigned long> counter(0);
+#if defined(_WIN32)
+  long pid = static_cast<long>(_getpid());
+#else
+  long pid = static_cast<long>(::getpid());
+#endif
+  return path + ".tmp." + std::to_string(pid) + "." + std::to_string(counter++);
+}
+} // anonymous namespace
+
+/**
+ * @brief Writes data to a temporary file and renames it over path
+ * @param data Complete new contents
+ * @param path Destination file, replaced if it exists
+ * @param what Description of the file for error messages, e.g. "cache entry"
+ * @throws OutputException if the file cannot be written or renamed; the destination is left unchanged
+ */
+void replaceFileAtomically(const std::string &data, const std::string &path, const std::string &what) {
+  std::string tmp = temporaryName(path);
+#if defined(_WIN32)
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file.write(data.data(), static_cast<std::streamsize>(data.size())) || !file.flush()) {
+      std::remove(tmp.c_str());
+      throw OutputException("cannot write " + what + ": " + tmp);
+    }
+  }
+  std::remove(path.c_str()); // rename() does not replace existing files here
+#else
+  int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (fd < 0)
+    throw OutputException("cannot create " + what + ": " + tmp);
+  const char *next = data.data();
+  size_t      left = data.size();
+  while (left > 0) {
+    ssize_t written = ::write(fd, next, left);
+    if (written <= 0) {
+      ::close(fd);
+      std::remove(tmp.c_str());
+      throw OutputException("cannot write " + what + ": " + tmp);
+    }
+    next += written;
+    left -= static_cast<size_t>(written);
+  }
+  // Make the data durable before it becomes visible under its final name
+  if (::fsync(fd) != 0 || ::close(fd) != 0) {
+    std::remove(tmp.c_str());
+    throw OutputException("cannot write " + what + ": " + tmp);
+  }
+#endif
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    throw OutputException("cannot publish " + what + ": " + path);
+  }
+}
+
+} // namespace yamlparser
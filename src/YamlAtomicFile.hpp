@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+/**
+ * @file YamlAtomicFile.hpp
+ * @brief Internal helper that replaces a file without exposing partial contents
+ *
+ * The data is written to a temporary file next to the destination, flushed
+ * to disk, then renamed over the destination. Readers that opened or mapped
+ * the old file keep its contents; new readers see the complete new file.
+ * The rename is atomic on POSIX; on Windows the old file is removed first.
+ *
+ * This header is private to the library sources.
+ */
+
+namespace yamlparser {
+
+void replaceFileAtomically(const std::string &data, const std::string &path, const std::string &what);
+
+} // namespace yamlparser
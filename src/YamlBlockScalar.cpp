@@ -0,0 +1,235 @@
+#include "YamlBlockScalar.hpp"
+#include "YamlException.hpp"
+
+// YamlBlockScalar implementation - measure first, then copy once
+// Key features:
+// - The constructor finds the block boundaries from the line tokens and
+//   runs the output rules with a sink that only counts bytes
+// - str() runs the same rules with a sink that appends to a string
+//   reserved to the counted size, so both passes agree by construction
+//   and the content is copied exactly once
+// - Line text is copied straight from the source from the block's
+//   indentation column, which keeps deeper indentation and trailing blanks
+
+namespace yamlparser {
+
+namespace {
+
+// Counts the bytes the output rules produce
+class CountingSink {
+public:
+  void put(char, size_t count) {
+    m_size += count;
+  }
+
+  void write(const char *, size_t length) {
+    m_size += length;
+  }
+
+  size_t size() const {
+    return m_size;
+  }
+
+private:
+  size_t m_size = 0;
+};
+
+// Appends the output to a string that already has the capacity for it
+class AppendSink {
+public:
+  explicit AppendSink(std::string &out) : m_out(out) {}
+
+  void put(char c, size_t count) {
+    m_out.append(count, c);
+  }
+
+  void write(const char *data, size_t length) {
+    m_out.append(data, length);
+  }
+
+private:
+  std::string &m_out;
+};
+
+inline bool isBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Reads the header and measures the block
+ * @param tokens Tokens of the document
+ * @param headerIdx Index of the line holding the header
+ * @param parentIndent Indentation of that line; content must be indented more
+ * @param header Header text, e.g. "|", ">-" or "|2+ # comment"
+ * @throws SyntaxException if the header is malformed
+ */
+YamlBlockScalar::YamlBlockScalar(const YamlScanner &tokens, size_t headerIdx, size_t parentIndent,
+                                 const std::string &header)
+    : m_tokens(tokens) {
+  if (!parseHeader(header))
+    throw SyntaxException("Invalid block scalar header: '" + header + "'", headerIdx + 1);
+  measure(headerIdx, parentIndent);
+}
+
+/**
+ * @brief Get the block style
+ * @return '|' for literal, '>' for folded
+ */
+char YamlBlockScalar::style() const {
+  return m_style;
+}
+
+/**
+ * @brief Get the chomping indicator
+ * @return How the trailing line breaks are handled
+ */
+YamlChomping YamlBlockScalar::chomping() const {
+  return m_chomping;
+}
+
+/**
+ * @brief Get the indentation of the content
+ * @return Column of the content lines; deeper indentation is part of the content
+ */
+size_t YamlBlockScalar::indent() const {
+  return m_indent;
+}
+
+/**
+ * @brief Get the line after the block
+ * @return Index of the first token that is not part of the block, or the token count
+ */
+size_t YamlBlockScalar::end() const {
+  return m_end;
+}
+
+/**
+ * @brief Get the size of the content
+ * @return Length of str(), known without building it
+ */
+size_t YamlBlockScalar::size() const {
+  return m_size;
+}
+
+/**
+ * @brief Builds the content
+ * @return The scalar, allocated once at its final size
+ */
+std::string YamlBlockScalar::str() const {
+  std::string out;
+  out.reserve(m_size);
+  AppendSink sink(out);
+  emit(sink);
+  return out;
+}
+
+/**
+ * @brief Reads the style and the indicators
+ * @param header Header text
+ * @return false unless the header is a style followed by at most one of each indicator and an
+ *         optional comment
+ */
+bool YamlBlockScalar::parseHeader(const std::string &header) {
+  if (header.empty() || (header[0] != '|' && header[0] != '>'))
+    return false;
+  m_style = header[0];
+
+  size_t pos         = 1;
+  bool   hasChomping = false;
+  for (; pos < header.size(); ++pos) {
+    const char c = header[pos];
+    if ((c == '-' || c == '+') && !hasChomping) {
+      m_chomping  = c == '-' ? YamlChomping::Strip : YamlChomping::Keep;
+      hasChomping = true;
+    } else if (c >= '1' && c <= '9' && m_indicator == 0) {
+      m_indicator = static_cast<size_t>(c - '0');
+    } else {
+      break;
+    }
+  }
+  while (pos < header.size() && isBlank(header[pos]))
+    pos++;
+  return pos == header.size() || header[pos] == '#';
+}
+
+/**
+ * @brief Finds the boundaries and the indentation of the block and counts its content
+ * @param headerIdx Index of the header line
+ * @param parentIndent Indentation of the header line
+ */
+void YamlBlockScalar::measure(size_t headerIdx, size_t parentIndent) {
+  m_begin = headerIdx + 1;
+  if (m_indicator) {
+    m_indent = parentIndent + m_indicator;
+  } else {
+    size_t first = m_tokens.nextNonBlank(m_begin);
+    m_indent     = first < m_tokens.size() && m_tokens[first].indent > parentIndent ? m_tokens[first].indent
+                                                                                     : parentIndent + 1;
+  }
+
+  m_contentEnd = m_begin;
+  size_t idx   = m_begin;
+  for (; idx < m_tokens.size(); ++idx) {
+    const YamlToken &token = m_tokens[idx];
+    if (token.kind == YamlTokenKind::Blank)
+      continue;
+    if (token.indent < m_indent)
+      break;
+    m_contentEnd = idx + 1;
+  }
+  m_end = idx;
+
+  CountingSink counter;
+  emit(counter);
+  m_size = counter.size();
+}
+
+/**
+ * @brief Produces the content into a sink
+ * @param sink Receives runs of one character and copies of line text
+ */
+template <typename Sink> void YamlBlockScalar::emit(Sink &sink) const {
+  enum class Previous { None, Normal, MoreIndented };
+  Previous previous = Previous::None;
+  size_t   blanks   = 0;
+
+  for (size_t idx = m_begin; idx < m_contentEnd; ++idx) {
+    const YamlToken &token = m_tokens[idx];
+    if (token.kind == YamlTokenKind::Blank) {
+      blanks++;
+      continue;
+    }
+    // Line breaks before this line: literal blocks keep all of them, folded
+    // blocks turn a single one between two plain lines into a space and drop
+    // the one before a run of blank lines
+    const bool moreIndented = token.indent > m_indent;
+    const bool folds        = m_style == '>' && previous == Previous::Normal && !moreIndented;
+    if (previous == Previous::None)
+      sink.put('\n', blanks);
+    else if (folds && blanks == 0)
+      sink.put(' ', 1);
+    else
+      sink.put('\n', folds ? blanks : blanks + 1);
+
+    YamlSpan content = m_tokens.content(token);
+    size_t   begin   = token.offset + m_indent;
+    sink.write(m_tokens.source().data() + begin, content.offset + content.length - begin);
+    previous = moreIndented ? Previous::MoreIndented : Previous::Normal;
+    blanks   = 0;
+  }
+
+  if (previous == Previous::None) {
+    // No content: only keep produces anything, one break per blank line
+    if (m_chomping == YamlChomping::Keep)
+      sink.put('\n', m_end - m_begin);
+    return;
+  }
+  if (m_chomping == YamlChomping::Keep)
+    sink.put('\n', 1 + m_end - m_contentEnd);
+  else if (m_chomping == YamlChomping::Clip)
+    sink.put('\n', 1);
+}
+
+} // namespace yamlparser
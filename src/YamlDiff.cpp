@@ -0,0 +1,247 @@
+#include "YamlDiff.hpp"
+#include <algorithm>
+#include <cstring>
+
+// YamlDiff implementation - Merkle-style hashing and hash-pruned tree comparison
+// Key features:
+// - One bottom-up pass computes a 64-bit hash for every node
+// - diff() only descends into subtrees whose hashes differ, so the work is
+//   proportional to the size of the change rather than the size of the trees
+// - Maps are compared with a merge walk over their sorted keys
+
+namespace yamlparser {
+
+namespace {
+const std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME  = 1099511628211ULL;
+
+std::uint64_t hashBytes(const char *data, size_t size, std::uint64_t h = FNV_OFFSET) {
+  for (size_t i = 0; i < size; ++i) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+std::uint64_t hashString(const std::string &s) {
+  return hashBytes(s.data(), s.size());
+}
+
+// Order-dependent combination of two hashes (splitmix64 finalizer on the sum)
+std::uint64_t combine(std::uint64_t seed, std::uint64_t value) {
+  std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL + value;
+  z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z               = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+std::uint64_t typeSeed(YamlElement::ElementType type) {
+  return combine(FNV_OFFSET, static_cast<std::uint64_t>(type));
+}
+
+void buildMap(const YamlMap &map, YamlHashTree::Node &node);
+void buildSeq(const YamlSeq &seq, YamlHashTree::Node &node);
+
+void buildElement(const YamlElement &v, YamlHashTree::Node &node) {
+  node.type       = v.type;
+  node.element    = &v;
+  std::uint64_t h = typeSeed(v.type);
+  switch (v.type) {
+  case YamlElement::ElementType::STRING:
+    h = combine(h, hashString(v.data.str));
+    break;
+  case YamlElement::ElementType::DOUBLE: {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &v.data.d, sizeof(bits));
+    h = combine(h, bits);
+    break;
+  }
+  case YamlElement::ElementType::INT:
+    h = combine(h, static_cast<std::uint64_t>(static_cast<std::int64_t>(v.data.i)));
+    break;
+  case YamlElement::ElementType::BOOL:
+    h = combine(h, v.data.b ? 1U : 0U);
+    break;
+  case YamlElement::ElementType::SEQ:
+    if (v.data.seq) {
+      buildSeq(*v.data.seq, node);
+      return;
+    }
+    break;
+  case YamlElement::ElementType::MAP:
+    if (v.data.map) {
+      buildMap(*v.data.map, node);
+      return;
+    }
+    break;
+  case YamlElement::ElementType::NONE:
+  default:
+    break;
+  }
+  node.hash = h;
+}
+
+void buildMap(const YamlMap &map, YamlHashTree::Node &node) {
+  node.type = YamlElement::ElementType::MAP;
+  node.map  = &map;
+  node.children.resize(map.size());
+  std::uint64_t h = typeSeed(node.type);
+  size_t        i = 0;
+  for (const auto &kv : map) {
+    buildElement(kv.second.value, node.children[i]);
+    h = combine(h, hashString(kv.first));
+    h = combine(h, node.children[i].hash);
+    ++i;
+  }
+  node.hash = h;
+}
+
+void buildSeq(const YamlSeq &seq, YamlHashTree::Node &node) {
+  node.type = YamlElement::ElementType::SEQ;
+  node.seq  = &seq;
+  node.children.resize(seq.size());
+  std::uint64_t h = typeSeed(node.type);
+  for (size_t i = 0; i < seq.size(); ++i) {
+    buildElement(seq[i].value, node.children[i]);
+    h = combine(h, node.children[i].hash);
+  }
+  node.hash = h;
+}
+
+std::string keyPath(const std::string &parent, const std::string &key) {
+  return parent.empty() ? key : parent + "." + key;
+}
+
+std::string indexPath(const std::string &parent, size_t index) {
+  return parent + "[" + std::to_string(index) + "]";
+}
+
+void diffNodes(const YamlHashTree::Node &a, const YamlHashTree::Node &b, const std::string &path,
+               std::vector<YamlDiffEntry> &out) {
+  if (a.hash == b.hash && a.type == b.type)
+    return; // identical subtree: prune
+
+  if (a.type == YamlElement::ElementType::MAP && b.type == YamlElement::ElementType::MAP) {
+    // Merge walk over both sorted key sets
+    auto   ia = a.map->begin();
+    auto   ib = b.map->begin();
+    size_t ca = 0, cb = 0;
+    while (ia != a.map->end() || ib != b.map->end()) {
+      if (ib == b.map->end() || (ia != a.map->end() && ia->first < ib->first)) {
+        out.push_back({YamlDiffEntry::Kind::REMOVED, keyPath(path, ia->first)});
+        ++ia, ++ca;
+      } else if (ia == a.map->end() || ib->first < ia->first) {
+        out.push_back({YamlDiffEntry::Kind::ADDED, keyPath(path, ib->first)});
+        ++ib, ++cb;
+      } else {
+        diffNodes(a.children[ca], b.children[cb], keyPath(path, ia->first), out);
+        ++ia, ++ca;
+        ++ib, ++cb;
+      }
+    }
+    return;
+  }
+
+  if (a.type == YamlElement::ElementType::SEQ && b.type == YamlElement::ElementType::SEQ) {
+    size_t common = std::min(a.children.size(), b.children.size());
+    for (size_t i = 0; i < common; ++i) {
+      diffNodes(a.children[i], b.children[i], indexPath(path, i), out);
+    }
+    for (size_t i = common; i < a.children.size(); ++i) {
+      out.push_back({YamlDiffEntry::Kind::REMOVED, indexPath(path, i)});
+    }
+    for (size_t i = common; i < b.children.size(); ++i) {
+      out.push_back({YamlDiffEntry::Kind::ADDED, indexPath(path, i)});
+    }
+    return;
+  }
+
+  // Scalars with different values, or a change of type
+  out.push_back({YamlDiffEntry::Kind::CHANGED, path});
+}
+} // anonymous namespace
+
+/**
+ * @brief Builds the hash tree of a mapping
+ * @param map The mapping to hash (must outlive the hash tree)
+ */
+YamlHashTree::YamlHashTree(const YamlMap &map) {
+  buildMap(map, m_root);
+}
+
+/**
+ * @brief Builds the hash tree of a sequence
+ * @param seq The sequence to hash (must outlive the hash tree)
+ */
+YamlHashTree::YamlHashTree(const YamlSeq &seq) {
+  buildSeq(seq, m_root);
+}
+
+/**
+ * @brief Builds the hash tree of a single item
+ * @param item The item to hash (must outlive the hash tree)
+ */
+YamlHashTree::YamlHashTree(const YamlItem &item) {
+  buildElement(item.value, m_root);
+}
+
+/**
+ * @brief Builds the hash tree of a single element
+ * @param element The element to hash (must outlive the hash tree)
+ */
+YamlHashTree::YamlHashTree(const YamlElement &element) {
+  buildElement(element, m_root);
+}
+
+/**
+ * @brief Get the content hash of the whole tree
+ * @return 64-bit hash of the root node
+ */
+std::uint64_t YamlHashTree::hash() const {
+  return m_root.hash;
+}
+
+/**
+ * @brief Get the root node of the hash tree
+ * @return Reference to the root node
+ */
+const YamlHashTree::Node &YamlHashTree::root() const {
+  return m_root;
+}
+
+/**
+ * @brief Computes the content hash of a single item without keeping the tree
+ * @param item The item to hash
+ * @return 64-bit content hash, equal to YamlHashTree(item).hash()
+ */
+std::uint64_t YamlHashTree::hashOf(const YamlItem &item) {
+  return YamlHashTree(item).hash();
+}
+
+/**
+ * @brief Compares two hash trees and reports the differing paths
+ * @param a The "before" tree
+ * @param b The "after" tree
+ * @return List of changes in depth-first, key/index order
+ * @details Subtrees with equal hashes are skipped without being visited.
+ *          Sequences are compared index by index, so an insertion in the
+ *          middle of a sequence reports every following index as changed.
+ *          A change of type at the root is reported with an empty path.
+ */
+std::vector<YamlDiffEntry> diff(const YamlHashTree &a, const YamlHashTree &b) {
+  std::vector<YamlDiffEntry> out;
+  diffNodes(a.root(), b.root(), "", out);
+  return out;
+}
+
+/**
+ * @brief Convenience overload hashing two mappings and comparing them
+ * @param a The "before" mapping
+ * @param b The "after" mapping
+ * @return List of changes (see diff(const YamlHashTree&, const YamlHashTree&))
+ */
+std::vector<YamlDiffEntry> diff(const YamlMap &a, const YamlMap &b) {
+  return diff(YamlHashTree(a), YamlHashTree(b));
+}
+
+} // namespace yamlparser
@@ -1,6 +1,7 @@
 
 #include "YamlElement.hpp"
 #include "YamlException.hpp"
+#include "YamlMemoryUsage.hpp"
 #include <stdexcept>
 
 // YamlElement implementation - A type-safe variant class for YAML values
@@ -66,6 +67,26 @@ YamlElement::YamlElement(const YamlMap &map) : type(ElementType::MAP), data() {
   data.map = std::make_unique<YamlMap>(map);
 }
 
+/**
+ * @brief Constructs a sequence YAML element from a temporary sequence
+ * @param seq Sequence to move from; left empty
+ * @details The items are not copied, so building a tree bottom-up costs
+ *          nothing per level.
+ */
+YamlElement::YamlElement(YamlSeq &&seq) : type(ElementType::SEQ), data() {
+  data.seq = std::make_unique<YamlSeq>(std::move(seq));
+}
+
+/**
+ * @brief Constructs a mapping YAML element from a temporary mapping
+ * @param map Mapping to move from; left empty
+ * @details The entries are not copied, so building a tree bottom-up costs
+ *          nothing per level.
+ */
+YamlElement::YamlElement(YamlMap &&map) : type(ElementType::MAP), data() {
+  data.map = std::make_unique<YamlMap>(std::move(map));
+}
+
 /**
  * @brief Copy constructor
  * @param other The YamlElement to copy
@@ -180,6 +201,15 @@ bool YamlElement::isScalar() const {
          type == ElementType::BOOL;
 }
 
+/**
+ * @brief Measures the heap usage of this element and everything it owns
+ * @param largestCount Number of largest subtrees to list by path (0 skips the list)
+ * @return Usage breakdown (see YamlMemoryUsage.hpp)
+ */
+YamlMemoryUsage YamlElement::memoryUsage(size_t largestCount) const {
+  return yamlparser::memoryUsage(*this, largestCount);
+}
+
 /**
  * @brief Swaps the contents of this element with another
  * @param other The YamlElement to swap with
@@ -0,0 +1,248 @@
+#include "YamlEmitter.hpp"
+#include "YamlException.hpp"
+#include "YamlHelperFunctions.hpp"
+#include "YamlPrinter.hpp"
+
+// YamlEmitter implementation - writes YAML text as the caller walks its data
+// Key features:
+// - Only a stack of open collections is kept, one frame per nesting level
+// - Layout mirrors YamlPrinter (nested collections indented by 4 spaces)
+// - Scalar quoting and number formatting shared with YamlPrinter
+// - Misuse (value without key, unbalanced end) reported as StructureException
+
+namespace yamlparser {
+
+/**
+ * @brief Creates an emitter writing to a stream through an internal buffer
+ * @param os Destination stream
+ */
+YamlEmitter::YamlEmitter(std::ostream &os)
+    : m_ownedBuffer(std::make_unique<YamlOutputBuffer>(os)), m_out(m_ownedBuffer.get()) {}
+
+/**
+ * @brief Creates an emitter writing into a caller-supplied buffer
+ * @param out Destination buffer (must outlive the emitter)
+ */
+YamlEmitter::YamlEmitter(YamlOutputBuffer &out) : m_out(&out) {}
+
+/**
+ * @brief Destructor - pending output of an owned buffer is written to the stream
+ */
+YamlEmitter::~YamlEmitter() = default;
+
+/**
+ * @brief Prepares the current context to receive a value
+ * @param what Description of the value used in error messages
+ * @throws StructureException if there is no open collection or no pending key
+ * @details Inside a sequence this writes the "- " item prefix; inside a
+ *          mapping it consumes the key written by key().
+ */
+void YamlEmitter::beginValue(const char *what) {
+  if (m_stack.empty()) {
+    throw StructureException(std::string(what) + " outside of a mapping or sequence");
+  }
+  Frame &top = m_stack.back();
+  if (top.type == FrameType::MAP) {
+    if (!top.keyPending) {
+      throw StructureException(std::string(what) + " in mapping without a preceding key");
+    }
+    top.keyPending = false;
+  } else {
+    m_out->appendIndent(top.indent);
+    m_out->append("- ", 2);
+  }
+}
+
+/**
+ * @brief Opens a mapping or sequence, either as the root or as a nested value
+ * @param type Kind of collection to open
+ * @throws StructureException if a root was already written or no key is pending
+ */
+void YamlEmitter::beginCollection(FrameType type) {
+  if (m_stack.empty()) {
+    if (m_started) {
+      throw StructureException("document root has already been written");
+    }
+    m_started = true;
+    m_stack.push_back({type, 0, false});
+    return;
+  }
+  beginValue(type == FrameType::MAP ? "mapping" : "sequence");
+  m_out->append('\n');
+  m_stack.push_back({type, m_stack.back().indent + 4, false});
+}
+
+/**
+ * @brief Opens a mapping
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::beginMap() {
+  beginCollection(FrameType::MAP);
+  return *this;
+}
+
+/**
+ * @brief Opens a sequence
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::beginSeq() {
+  beginCollection(FrameType::SEQ);
+  return *this;
+}
+
+/**
+ * @brief Writes a mapping key; the next call must provide its value
+ * @param key The key to write
+ * @return Reference to this emitter for chaining
+ * @throws StructureException if not inside a mapping or a key is already pending
+ */
+YamlEmitter &YamlEmitter::key(const std::string &key) {
+  if (m_stack.empty() || m_stack.back().type != FrameType::MAP) {
+    throw StructureException("key '" + key + "' outside of a mapping");
+  }
+  Frame &top = m_stack.back();
+  if (top.keyPending) {
+    throw StructureException("key '" + key + "' written while the previous key has no value");
+  }
+  m_out->appendIndent(top.indent);
+  writeQuotedIfNeeded(key, *m_out);
+  m_out->append(": ", 2);
+  top.keyPending = true;
+  return *this;
+}
+
+/**
+ * @brief Closes the innermost open mapping or sequence
+ * @return Reference to this emitter for chaining
+ * @throws StructureException if nothing is open or a key has no value
+ */
+YamlEmitter &YamlEmitter::end() {
+  if (m_stack.empty()) {
+    throw StructureException("end() without an open mapping or sequence");
+  }
+  if (m_stack.back().keyPending) {
+    throw StructureException("mapping closed while a key has no value");
+  }
+  m_stack.pop_back();
+  return *this;
+}
+
+/**
+ * @brief Writes a string value
+ * @param s The string to write
+ * @return Reference to this emitter for chaining
+ * @details Empty strings are written as null inside a mapping, as YamlPrinter does
+ */
+YamlEmitter &YamlEmitter::value(const std::string &s) {
+  bool inMap = !m_stack.empty() && m_stack.back().type == FrameType::MAP;
+  beginValue("value");
+  if (inMap && s.empty()) {
+    m_out->append("null\n", 5);
+  } else {
+    writeQuotedIfNeeded(s, *m_out);
+    m_out->append('\n');
+  }
+  return *this;
+}
+
+/**
+ * @brief Writes a string value given as a C string
+ * @param s The NUL-terminated string to write
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::value(const char *s) {
+  return value(std::string(s));
+}
+
+/**
+ * @brief Writes an integer value
+ * @param i The integer to write
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::value(int i) {
+  beginValue("value");
+  writeInt(i, *m_out);
+  m_out->append('\n');
+  return *this;
+}
+
+/**
+ * @brief Writes a floating-point value
+ * @param d The double to write
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::value(double d) {
+  beginValue("value");
+  writeDouble(d, *m_out);
+  m_out->append('\n');
+  return *this;
+}
+
+/**
+ * @brief Writes a boolean value
+ * @param b The boolean to write
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::value(bool b) {
+  beginValue("value");
+  if (b)
+    m_out->append("true\n", 5);
+  else
+    m_out->append("false\n", 6);
+  return *this;
+}
+
+/**
+ * @brief Writes an already-built subtree as the next value
+ * @param item The item to write (scalar or collection)
+ * @return Reference to this emitter for chaining
+ * @details Useful to embed small prebuilt fragments in a streamed document
+ */
+YamlEmitter &YamlEmitter::value(const YamlItem &item) {
+  bool inMap = !m_stack.empty() && m_stack.back().type == FrameType::MAP;
+  beginValue("value");
+  const YamlElement &v = item.value;
+  if (inMap && (v.type == YamlElement::ElementType::NONE || (v.isString() && v.asString().empty()))) {
+    m_out->append("null\n", 5);
+  } else {
+    YamlPrinter::print(item, *m_out, m_stack.back().indent + 2);
+  }
+  return *this;
+}
+
+/**
+ * @brief Writes a null value
+ * @return Reference to this emitter for chaining
+ */
+YamlEmitter &YamlEmitter::null() {
+  beginValue("value");
+  m_out->append("null\n", 5);
+  return *this;
+}
+
+/**
+ * @brief Get the number of currently open collections
+ * @return Nesting depth (0 before the root is opened and after it is closed)
+ */
+size_t YamlEmitter::depth() const {
+  return m_stack.size();
+}
+
+/**
+ * @brief Check whether a complete document has been written
+ * @return true once the root collection has been opened and closed again
+ */
+bool YamlEmitter::complete() const {
+  return m_started && m_stack.empty();
+}
+
+/**
+ * @brief Writes buffered output to the destination stream
+ * @details Only meaningful when the emitter writes to a stream; the
+ *          stream itself is not flushed.
+ */
+void YamlEmitter::flush() {
+  m_out->flush();
+}
+
+} // namespace yamlparser
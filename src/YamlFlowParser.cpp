@@ -0,0 +1,266 @@
+#include "YamlFlowParser.hpp"
+#include "YamlException.hpp"
+#include "YamlParser.hpp"
+
+// YamlFlowParser implementation - flow collections in one pass
+// Key features:
+// - One function per grammar rule; each consumes the characters of its rule
+//   and returns the finished element, so nested collections are never
+//   rescanned by their parents
+// - Item text is only copied for typing a scalar, which fits in the small
+//   string buffer for numbers and short words
+// - The depth check comes before the recursion, so the limit also bounds
+//   the stack
+
+namespace yamlparser {
+
+namespace {
+
+inline bool isBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Creates a parser
+ * @param maxDepth Maximum nesting depth, counting baseDepth
+ * @param baseDepth Depth of the block collection that holds the flow collection (0 for a standalone one)
+ * @param line 1-based line of the flow collection, reported in errors (0 if unknown)
+ */
+YamlFlowParser::YamlFlowParser(size_t maxDepth, size_t baseDepth, size_t line)
+    : m_maxDepth(maxDepth), m_baseDepth(baseDepth), m_line(line) {}
+
+/**
+ * @brief Parses a flow collection
+ * @param text "[...]" or "{...}", optionally surrounded by blanks
+ * @return Sequence or mapping item
+ * @throws SyntaxException if the text is not exactly one well-formed flow collection
+ * @throws LimitException if the collection is nested too deeply
+ * @throws ConversionException if a numeric scalar is out of range
+ */
+YamlItem YamlFlowParser::parse(const std::string &text) {
+  m_pos   = text.data();
+  m_end   = text.data() + text.size();
+  m_nodes = 0;
+  m_depth = 0;
+
+  skipBlanks();
+  if (m_pos == m_end || (*m_pos != '[' && *m_pos != '{'))
+    throw syntaxError("Malformed flow collection: expected '[' or '{'");
+  YamlItem item = parseCollection(1);
+  skipBlanks();
+  if (m_pos != m_end)
+    throw syntaxError("Unexpected text after flow collection: '" + std::string(m_pos, m_end) + "'");
+  return item;
+}
+
+/**
+ * @brief Get the size of the last parsed collection
+ * @return Number of nodes, the collection itself included
+ */
+size_t YamlFlowParser::nodes() const {
+  return m_nodes;
+}
+
+/**
+ * @brief Get the nesting of the last parsed collection
+ * @return 1 for a collection of scalars, plus one per nested level
+ */
+size_t YamlFlowParser::depth() const {
+  return m_depth;
+}
+
+/**
+ * @brief Parses the collection starting at the current '[' or '{'
+ * @param level Nesting level of the collection's entries (1 for the outermost collection)
+ * @return Sequence or mapping item
+ * @throws LimitException if level exceeds the depth limit
+ */
+YamlItem YamlFlowParser::parseCollection(size_t level) {
+  if (m_baseDepth + level > m_maxDepth)
+    throw LimitException("nesting depth", m_maxDepth, m_line);
+  if (level > m_depth)
+    m_depth = level;
+  m_nodes++;
+  if (*m_pos == '[')
+    return YamlItem(YamlElement(parseSeq(level)));
+  return YamlItem(YamlElement(parseMap(level)));
+}
+
+/**
+ * @brief Parses a flow sequence
+ * @param level Nesting level of the items
+ * @return The sequence; the position is after its ']'
+ * @throws SyntaxException if the sequence is not closed or items are not separated by ','
+ */
+YamlSeq YamlFlowParser::parseSeq(size_t level) {
+  YamlSeq seq;
+  ++m_pos;
+  skipBlanks();
+  if (m_pos != m_end && *m_pos == ']') {
+    ++m_pos;
+    return seq;
+  }
+  do {
+    seq.push_back(parseValue(level));
+  } while (expectSeparator(']'));
+  return seq;
+}
+
+/**
+ * @brief Parses a flow mapping
+ * @param level Nesting level of the values
+ * @return The mapping; the position is after its '}'
+ * @throws SyntaxException if the mapping is not closed, a key is empty, repeated or not a scalar,
+ *         or entries are not separated by ','
+ */
+YamlMap YamlFlowParser::parseMap(size_t level) {
+  YamlMap map;
+  ++m_pos;
+  skipBlanks();
+  if (m_pos != m_end && *m_pos == '}') {
+    ++m_pos;
+    return map;
+  }
+  do {
+    if (m_pos != m_end && (*m_pos == '[' || *m_pos == '{'))
+      throw syntaxError("Flow mapping keys must be scalars");
+    const char *begin = m_pos;
+    const char *end   = scanScalar(true);
+    std::string key;
+    try {
+      key = YamlParser::processQuotedString(std::string(begin, end));
+    } catch (const SyntaxException &e) {
+      // Escape errors come without a line
+      throw syntaxError(e.detail());
+    }
+    if (key.empty())
+      throw syntaxError("Empty key in key-value pair");
+    if (map.find(key) != map.end())
+      throw syntaxError("Duplicate mapping key: '" + key + "'");
+
+    if (m_pos != m_end && *m_pos == ':') {
+      ++m_pos;
+      skipBlanks();
+      map.emplace(std::move(key), parseValue(level));
+    } else {
+      m_nodes++;
+      map.emplace(std::move(key), YamlItem(YamlElement(std::string())));
+    }
+  } while (expectSeparator('}'));
+  return map;
+}
+
+/**
+ * @brief Parses a sequence item or mapping value at the current position
+ * @param level Nesting level of the value
+ * @return Nested collection or typed scalar
+ */
+YamlItem YamlFlowParser::parseValue(size_t level) {
+  if (m_pos != m_end && (*m_pos == '[' || *m_pos == '{'))
+    return parseCollection(level + 1);
+  const char *begin = m_pos;
+  const char *end   = scanScalar(false);
+  m_nodes++;
+  try {
+    return YamlItem(YamlParser::parseScalar(std::string(begin, end)));
+  } catch (const SyntaxException &e) {
+    throw syntaxError(e.detail());
+  }
+}
+
+/**
+ * @brief Advances past a scalar
+ * @param key true to stop at ':' as well
+ * @return End of the scalar text without trailing blanks; the position is at the character that ended it
+ * @throws SyntaxException if a quoted scalar is not closed
+ * @details A leading quote runs to the matching quote; \" and '' do not
+ *          close it. Plain text ends at ',' or at a closing bracket; brackets
+ *          opened within it are balanced, so "a[0]" is one scalar.
+ */
+const char *YamlFlowParser::scanScalar(bool key) {
+  const char *begin = m_pos;
+  if (m_pos != m_end && (*m_pos == '"' || *m_pos == '\'')) {
+    const char quote = *m_pos++;
+    while (true) {
+      while (m_pos != m_end && *m_pos != quote) {
+        // An escaped character cannot close a double-quoted scalar
+        if (quote == '"' && *m_pos == '\\' && m_end - m_pos > 1)
+          ++m_pos;
+        ++m_pos;
+      }
+      if (m_pos == m_end)
+        throw syntaxError("Unterminated quoted scalar in flow collection");
+      ++m_pos;
+      // '' is a quote inside a single-quoted scalar
+      if (quote == '\'' && m_pos != m_end && *m_pos == '\'')
+        ++m_pos;
+      else
+        break;
+    }
+  }
+  size_t nesting = 0;
+  for (; m_pos != m_end; ++m_pos) {
+    const char c = *m_pos;
+    if (c == '[' || c == '{') {
+      nesting++;
+    } else if (c == ']' || c == '}') {
+      if (nesting == 0)
+        break;
+      nesting--;
+    } else if (nesting == 0 && (c == ',' || (key && c == ':'))) {
+      break;
+    }
+  }
+  const char *end = m_pos;
+  while (end != begin && isBlank(end[-1]))
+    --end;
+  return end;
+}
+
+/**
+ * @brief Consumes the separator after an entry
+ * @param closer ']' or '}'
+ * @return true if another entry follows, false if the collection was closed
+ * @throws SyntaxException if neither ',' nor closer follows, or the text ends
+ */
+bool YamlFlowParser::expectSeparator(char closer) {
+  skipBlanks();
+  if (m_pos == m_end)
+    throw syntaxError(closer == ']' ? "Malformed flow sequence: missing closing bracket"
+                                    : "Malformed flow mapping: missing closing brace");
+  if (*m_pos == closer) {
+    ++m_pos;
+    return false;
+  }
+  if (*m_pos != ',')
+    throw syntaxError(std::string("Expected ',' or '") + closer + "' in flow collection, found '" + *m_pos + "'");
+  ++m_pos;
+  skipBlanks();
+  // A trailing ',' before the closing bracket ends the collection
+  if (m_pos != m_end && *m_pos == closer) {
+    ++m_pos;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Builds the exception for malformed input
+ * @param message What is wrong
+ * @return The exception, with the line when it is known
+ */
+SyntaxException YamlFlowParser::syntaxError(const std::string &message) const {
+  return m_line > 0 ? SyntaxException(message, m_line) : SyntaxException(message);
+}
+
+/**
+ * @brief Advances past spaces and tabs
+ */
+void YamlFlowParser::skipBlanks() {
+  while (m_pos != m_end && isBlank(*m_pos))
+    ++m_pos;
+}
+
+} // namespace yamlparser
@@ -1,8 +1,15 @@
 #include "YamlHelperFunctions.hpp"
+#include "YamlBlockScalar.hpp"
+#include "YamlFlowParser.hpp"
+#include "YamlJsonPrinter.hpp"
 #include "YamlParser.hpp"
 #include "YamlPrinter.hpp"
 #include "YamlElement.hpp"
+#include "YamlNumberFormat.hpp"
+#include "YamlSimd.hpp"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <map>
@@ -13,6 +20,7 @@
 // - YAML type detection (multiline, anchor, alias, etc.)
 // - String manipulation and validation
 // - Complex value parsing (inline sequences, merge keys, etc.)
+// - Scalar output formatting shared by YamlPrinter and YamlEmitter
 // These functions are used internally by the parser to handle specific YAML features
 
 namespace yamlparser {
@@ -67,6 +75,17 @@ bool isInlineSeq(const std::string &value) {
   return false;
 }
 
+/**
+ * @brief Checks if a value is a YAML flow collection
+ * @param value The string to check
+ * @return true if the value is enclosed in square brackets or in braces, including "[]" and "{}"
+ */
+bool isFlowCollection(const std::string &value) {
+  if (value.size() < 2)
+    return false;
+  return (value.front() == '[' && value.back() == ']') || (value.front() == '{' && value.back() == '}');
+}
+
 /**
  * @brief Checks if a key-value pair represents a YAML merge key
  * @param key The key to check
@@ -91,77 +110,248 @@ std::string trim(const std::string &s) {
   return s.substr(start, end - start + 1);
 }
 
+namespace {
+
+// Next '\\' or '\'' at or after pos; memchr is the vectorized scan of the C library
+const char *findByte(const char *pos, const char *end, char c) {
+  return pos < end ? static_cast<const char *>(std::memchr(pos, c, static_cast<size_t>(end - pos))) : nullptr;
+}
+
+void appendUtf8(std::string &out, uint32_t cp) {
+  if (cp < 0x80) {
+    out += static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    out += static_cast<char>(0xC0 | (cp >> 6));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    out += static_cast<char>(0xE0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (cp >> 18));
+    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+
+// Reads 'digits' hex digits at pos; throws unless all are there
+uint32_t readHex(const char *pos, const char *end, int digits, char escape) {
+  if (end - pos < digits)
+    throw SyntaxException(std::string("Truncated escape sequence '\\") + escape + "' in double-quoted scalar");
+  uint32_t value = 0;
+  for (int i = 0; i < digits; ++i) {
+    const char c = pos[i];
+    uint32_t   digit;
+    if (c >= '0' && c <= '9')
+      digit = static_cast<uint32_t>(c - '0');
+    else if (c >= 'a' && c <= 'f')
+      digit = static_cast<uint32_t>(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      digit = static_cast<uint32_t>(c - 'A' + 10);
+    else
+      throw SyntaxException(std::string("Invalid hex digit in escape sequence '\\") + escape +
+                            "' in double-quoted scalar");
+    value = value << 4 | digit;
+  }
+  return value;
+}
+
+// Decodes the escape at esc (a '\\') into out; returns the position after it
+const char *decodeEscape(const char *esc, const char *end, std::string &out) {
+  if (esc + 1 == end)
+    throw SyntaxException("Unterminated escape sequence in double-quoted scalar");
+  const char code = esc[1];
+  switch (code) {
+  case '0':
+    out += '\0';
+    break;
+  case 'a':
+    out += '\a';
+    break;
+  case 'b':
+    out += '\b';
+    break;
+  case 't':
+  case '\t':
+    out += '\t';
+    break;
+  case 'n':
+    out += '\n';
+    break;
+  case 'v':
+    out += '\v';
+    break;
+  case 'f':
+    out += '\f';
+    break;
+  case 'r':
+    out += '\r';
+    break;
+  case 'e':
+    out += '\x1B';
+    break;
+  case ' ':
+  case '"':
+  case '/':
+  case '\\':
+    out += code;
+    break;
+  case 'N':
+    appendUtf8(out, 0x85);
+    break;
+  case '_':
+    appendUtf8(out, 0xA0);
+    break;
+  case 'L':
+    appendUtf8(out, 0x2028);
+    break;
+  case 'P':
+    appendUtf8(out, 0x2029);
+    break;
+  case 'x':
+    appendUtf8(out, readHex(esc + 2, end, 2, code));
+    return esc + 4;
+  case 'u':
+  case 'U': {
+    const int   digits = code == 'u' ? 4 : 8;
+    uint32_t    cp     = readHex(esc + 2, end, digits, code);
+    const char *next   = esc + 2 + digits;
+    // A UTF-16 surrogate pair, as JSON writes characters outside the BMP
+    if (code == 'u' && cp >= 0xD800 && cp <= 0xDBFF && end - next >= 6 && next[0] == '\\' && next[1] == 'u') {
+      uint32_t low = readHex(next + 2, end, 4, 'u');
+      if (low >= 0xDC00 && low <= 0xDFFF) {
+        cp   = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        next += 6;
+      }
+    }
+    if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+      throw SyntaxException("Invalid Unicode escape in double-quoted scalar");
+    appendUtf8(out, cp);
+    return next;
+  }
+  default:
+    throw SyntaxException(std::string("Invalid escape sequence '\\") + code + "' in double-quoted scalar");
+  }
+  return esc + 2;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Decodes the content of a double-quoted scalar
+ * @param data First byte after the opening quote
+ * @param size Number of bytes up to the closing quote
+ * @return The decoded string
+ * @throws SyntaxException for an unknown, truncated or out-of-range escape sequence
+ * @details Supports the YAML 1.2 escapes: \0 \a \b \t \n \v \f \r \e, the
+ *          escaped space, quote, slash and backslash, \N \_ \L \P, and
+ *          \xXX, \uXXXX (surrogate pairs included) and \UXXXXXXXX as UTF-8.
+ *          Text without a backslash is copied as is. Otherwise the output is
+ *          reserved once: only \L and \P decode to more bytes than they take.
+ */
+std::string unescapeDoubleQuoted(const char *data, size_t size) {
+  const char *end = data + size;
+  const char *esc = findByte(data, end, '\\');
+  if (!esc)
+    return std::string(data, size);
+
+  size_t bound = size;
+  for (const char *p = esc; p; p = findByte(p + 2, end, '\\')) {
+    if (p + 1 < end && (p[1] == 'L' || p[1] == 'P'))
+      bound++;
+  }
+
+  std::string out;
+  out.reserve(bound);
+  const char *run = data;
+  while (esc) {
+    out.append(run, static_cast<size_t>(esc - run));
+    run = decodeEscape(esc, end, out);
+    esc = findByte(run, end, '\\');
+  }
+  out.append(run, static_cast<size_t>(end - run));
+  return out;
+}
+
+/**
+ * @brief Decodes the content of a single-quoted scalar
+ * @param data First byte after the opening quote
+ * @param size Number of bytes up to the closing quote
+ * @return The string with each '' turned into '
+ * @details A lone quote is kept as is. Text without a quote is copied as is.
+ */
+std::string unescapeSingleQuoted(const char *data, size_t size) {
+  const char *end   = data + size;
+  const char *quote = findByte(data, end, '\'');
+  if (!quote)
+    return std::string(data, size);
+
+  std::string out;
+  out.reserve(size);
+  const char *run = data;
+  while (quote) {
+    out.append(run, static_cast<size_t>(quote - run) + 1);
+    run   = quote + 1 < end && quote[1] == '\'' ? quote + 2 : quote + 1;
+    quote = findByte(run, end, '\'');
+  }
+  out.append(run, static_cast<size_t>(end - run));
+  return out;
+}
+
 /**
  * @brief Parses a YAML multiline literal value
- * @param lines Vector of all lines in the YAML content
- * @param idx Current parsing position (modified as parsing progresses)
- * @param curIndent Current indentation level
- * @param style Literal style indicator ('|' or '>')
+ * @param tokens Token stream of the document
+ * @param idx Index of the line holding the block header; moved to the first line after the block
+ * @param curIndent Indentation of that line
+ * @param header Block header, e.g. "|", ">-" or "|2+"
  * @return YamlItem containing the parsed multiline string
- * @details Handles both literal ('|') and folded ('>') styles:
- *          - For '|': preserves newlines
- *          - For '>': folds newlines to spaces
- *          Maintains proper indentation handling
+ * @throws SyntaxException if the header is malformed
+ * @details See YamlBlockScalar for the chomping, indentation and folding rules.
  */
-YamlItem parseMultilineLiteral(const std::vector<std::string> &lines, size_t &idx, int curIndent, char style) {
-  std::string multiline;
-  idx++; // move past the line containing '|' or '>'
-
-  auto continues = [&](size_t i) -> bool {
-    if (i >= lines.size()) // reach end of file
-      return false;
-    auto firstNonSpacePos = lines[i].find_first_not_of(" \t");
-    // must be a non-empty line AND more indented than the literal introducer
-    return firstNonSpacePos != std::string::npos && firstNonSpacePos > static_cast<std::string::size_type>(curIndent);
-  };
-
-  if (style == '|') {
-    while (continues(idx)) {
-      multiline += trim(lines[idx]) + "\n";
-      ++idx;
-    }
-  } else { // style == '>'
-    while (continues(idx)) {
-      multiline += trim(lines[idx]) + " ";
-      ++idx;
-    }
+YamlItem parseMultilineLiteral(const YamlScanner &tokens, size_t &idx, int curIndent, const std::string &header) {
+  YamlBlockScalar block(tokens, idx, static_cast<size_t>(curIndent), header);
+  idx = block.end();
+  return YamlItem(YamlElement(block.str()));
+}
 
-    // trim a trailing space added by the last fold
-    if (!multiline.empty() && multiline.back() == ' ')
-      multiline.pop_back();
-  }
-  return YamlItem(YamlElement(multiline));
+/**
+ * @brief Parses a YAML multiline literal value without indicators
+ * @param tokens Token stream of the document
+ * @param idx Index of the line holding the block header; moved to the first line after the block
+ * @param curIndent Indentation of that line
+ * @param style '|' for a literal block; anything else is read as a folded block
+ * @return YamlItem containing the parsed multiline string
+ */
+YamlItem parseMultilineLiteral(const YamlScanner &tokens, size_t &idx, int curIndent, char style) {
+  return parseMultilineLiteral(tokens, idx, curIndent, std::string(1, style == '|' ? '|' : '>'));
 }
 
 /**
  * @brief Parses a YAML anchor and its associated value
  * @param value The anchor declaration string (starts with &)
- * @param lines Vector of all lines in the YAML content
+ * @param tokens Token stream of the document
  * @param idx Current parsing position (modified as parsing progresses)
- * @param curIndent Current indentation level
  * @param anchors Map to store the anchor reference
  * @param parser Reference to the YamlParser instance for nested parsing
  * @return YamlItem containing the parsed anchor value
  * @details Stores the parsed value in the anchors map for later reference
  *          Supports both sequence and mapping anchor values
  */
-YamlItem parseAnchor(const std::string &value, const std::vector<std::string> &lines, size_t &idx,
+YamlItem parseAnchor(const std::string &value, const YamlScanner &tokens, size_t &idx,
                      std::map<std::string, YamlItem> &anchors, YamlParser &parser) {
   // value starts with '&'
   std::string anchorName = value.substr(1);
   idx++; // move to the first line of the anchored node
 
-  if (idx < lines.size()) {
-    auto nextIndentPos = lines[idx].find_first_not_of(" \t");
-    if (nextIndentPos != std::string::npos) {
-      std::string next = lines[idx].substr(nextIndentPos);
-      // if next begins with '-', parse sequence; otherwise, parse map
-      YamlItem anchorNode = (!next.empty() && next[0] == '-')
-                                ? YamlItem(YamlElement(parser.parseSeq(lines, idx, static_cast<int>(nextIndentPos))))
-                                : YamlItem(YamlElement(parser.parseMap(lines, idx, static_cast<int>(nextIndentPos))));
-      anchors[anchorName] = anchorNode;
-      return anchorNode;
-    }
+  if (idx < tokens.size() && tokens[idx].kind != YamlTokenKind::Blank) {
+    const YamlToken &next = tokens[idx];
+    // if next begins with '-', parse sequence; otherwise, parse map
+    YamlItem anchorNode = next.kind == YamlTokenKind::SequenceItem
+                              ? YamlItem(YamlElement(parser.parseSeq(tokens, idx, static_cast<int>(next.indent))))
+                              : YamlItem(YamlElement(parser.parseMap(tokens, idx, static_cast<int>(next.indent))));
+    anchors[anchorName] = anchorNode;
+    return anchorNode;
   }
 
   // Empty anchor value -> treat as empty string scalar
@@ -191,64 +381,16 @@ YamlItem parseAlias(const std::string &value, const std::map<std::string, YamlIt
  * @brief Parses a YAML inline sequence
  * @param value The string containing the inline sequence (e.g., "[item1, item2]")
  * @return YamlItem containing the parsed sequence
- * @details Handles:
- *          - Quoted strings (both single and double quotes)
- *          - Proper comma separation
- *          - Nested sequences
- *          - Whitespace trimming
+ * @throws SyntaxException if value is not a well-formed flow sequence
+ * @details Parsed by YamlFlowParser, so items may be quoted strings, nested
+ *          sequences or flow mappings.
  */
 YamlItem parseInlineSeq(const std::string &value) {
-  // Validate input: must be at least 2 chars, start with [ and end with ]
   if (value.size() < 2 || value.front() != '[' || value.back() != ']') {
     throw SyntaxException("Malformed inline sequence: missing brackets");
   }
-
-  const std::string        seqContent = value.substr(1, value.size() - 2);
-  std::vector<std::string> items;
-  std::string              current;
-  bool                     inSingleQuote = false;
-  bool                     inDoubleQuote = false;
-  int                      bracketDepth  = 0; // support nested inline sequences
-
-  for (size_t i = 0; i < seqContent.size(); ++i) {
-    char c = seqContent[i];
-    if (c == '\'' && !inDoubleQuote) {
-      inSingleQuote = !inSingleQuote;
-      current += c;
-    } else if (c == '\"' && !inSingleQuote) {
-      inDoubleQuote = !inDoubleQuote;
-      current += c;
-    } else if (!inSingleQuote && !inDoubleQuote) {
-      if (c == '[') {
-        ++bracketDepth;
-        current += c;
-      } else if (c == ']') {
-        --bracketDepth;
-        current += c;
-      } else if (c == ',' && bracketDepth == 0) {
-        items.push_back(trim(current));
-        current.clear();
-      } else {
-        current += c;
-      }
-    } else {
-      current += c;
-    }
-  }
-  if (!current.empty())
-    items.push_back(trim(current));
-
-  YamlSeq seq;
-  seq.reserve(items.size());
-  for (const auto &it : items) {
-    // If item itself looks like an inline seq, parse recursively
-    if (!it.empty() && it.front() == '[' && it.back() == ']') {
-      seq.push_back(parseInlineSeq(it));
-    } else {
-      seq.push_back(YamlItem(YamlElement(yamlparser::YamlParser::parseScalar(it))));
-    }
-  }
-  return YamlItem(YamlElement(seq));
+  YamlFlowParser flow;
+  return flow.parse(value);
 }
 
 /**
@@ -281,4 +423,88 @@ void parseMergeKey(const std::string &value, std::map<std::string, YamlItem> &ma
   }
 }
 
+/**
+ * @brief Checks if a string must be quoted to be emitted as a plain YAML scalar
+ * @param s The string to check
+ * @return true if the string is empty, has surrounding spaces, starts with an
+ *         indicator character or contains YAML syntax characters
+ */
+bool needsQuoting(const std::string &s) {
+  if (s.empty())
+    return true; // for empty string, "null" will be print
+  if (s.front() == ' ' || s.back() == ' ')
+    return true;
+  // special leading characters or YAML syntax chars
+  if (s.front() == '-' || s.front() == '?' || s.front() == ':')
+    return true;
+  return s.find_first_of(":#{}[],&*!?|>'\"%@`") != std::string::npos;
+}
+
+/**
+ * @brief Checks if a string contains a control character such as a line break or a tab
+ * @param s The string to check
+ * @return true if any byte is below 0x20
+ */
+bool hasControlCharacter(const std::string &s) {
+  const char *data = s.data();
+  for (size_t pos = simd::findJsonEscape(data, s.size()); pos < s.size();
+       pos += 1 + simd::findJsonEscape(data + pos + 1, s.size() - pos - 1)) {
+    if (static_cast<unsigned char>(data[pos]) < 0x20)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Writes a string scalar, single-quoted only when needsQuoting() says so
+ * @param s The string to write
+ * @param out The output buffer to write to
+ * @details Embedded single quotes are escaped by doubling them. Strings with
+ *          control characters are double-quoted with escapes instead.
+ */
+void writeQuotedIfNeeded(const std::string &s, YamlOutputBuffer &out) {
+  if (hasControlCharacter(s)) {
+    // Line breaks and tabs only survive a round trip as escapes; a JSON string is a valid double-quoted scalar
+    YamlJsonPrinter::writeString(s, out);
+    return;
+  }
+  if (!needsQuoting(s)) {
+    out.append(s);
+    return;
+  }
+  // simple single-quote strategy: double single-quotes inside
+  out.append('\'');
+  size_t start = 0;
+  size_t quote = s.find('\'');
+  while (quote != std::string::npos) {
+    out.append(s.data() + start, quote + 1 - start);
+    out.append('\''); // escape by doubling
+    start = quote + 1;
+    quote = s.find('\'', start);
+  }
+  out.append(s.data() + start, s.size() - start);
+  out.append('\'');
+}
+
+/**
+ * @brief Writes an integer in decimal without going through iostreams
+ * @param value The integer to write
+ * @param out The output buffer to write to
+ */
+void writeInt(int value, YamlOutputBuffer &out) {
+  char buf[YamlNumberFormat::BUFFER_SIZE];
+  out.append(buf, YamlNumberFormat::formatInt(value, buf));
+}
+
+/**
+ * @brief Writes a double without going through iostreams
+ * @param value The double to write
+ * @param out The output buffer to write to
+ * @details Uses the shortest text that reads back as the same double
+ */
+void writeDouble(double value, YamlOutputBuffer &out) {
+  char buf[YamlNumberFormat::BUFFER_SIZE];
+  out.append(buf, YamlNumberFormat::formatDouble(value, buf));
+}
+
 } // namespace yamlparser
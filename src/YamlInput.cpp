@@ -0,0 +1,159 @@
+#include "YamlInput.hpp"
+#include "YamlException.hpp"
+#include "YamlSimd.hpp"
+#include <algorithm>
+#include <cstring>
+
+// YamlInput implementation - validate once, copy only when needed
+// Key features:
+// - ASCII runs are skipped 16 bytes at a time by an SSE2 kernel; only
+//   multi-byte sequences are decoded byte by byte
+// - Multi-byte sequences are checked against the well-formed ranges of
+//   RFC 3629, which rules out overlong forms, surrogates and code points
+//   above U+10FFFF without computing the code point
+// - '\r' is found with memchr; a source without it and without a byte
+//   order mark is passed through with no copy
+
+namespace yamlparser {
+
+namespace {
+
+const char UTF8_BOM[] = "\xEF\xBB\xBF";
+
+inline bool inRange(unsigned char c, unsigned char low, unsigned char high) {
+  return c >= low && c <= high;
+}
+
+/**
+ * @brief Length of the well-formed multi-byte sequence at the start of a buffer
+ * @param p First byte, which is not ASCII
+ * @param avail Number of bytes from p to the end of the input
+ * @return 2 to 4, or 0 if the sequence is invalid or truncated
+ */
+size_t sequenceLength(const unsigned char *p, size_t avail) {
+  const unsigned char lead = p[0];
+  size_t              length;
+  unsigned char       low  = 0x80;
+  unsigned char       high = 0xBF;
+  if (inRange(lead, 0xC2, 0xDF)) {
+    length = 2;
+  } else if (inRange(lead, 0xE0, 0xEF)) {
+    length = 3;
+    if (lead == 0xE0)
+      low = 0xA0; // overlong
+    else if (lead == 0xED)
+      high = 0x9F; // surrogates
+  } else if (inRange(lead, 0xF0, 0xF4)) {
+    length = 4;
+    if (lead == 0xF0)
+      low = 0x90; // overlong
+    else if (lead == 0xF4)
+      high = 0x8F; // above U+10FFFF
+  } else {
+    return 0;
+  }
+  if (avail < length || !inRange(p[1], low, high))
+    return 0;
+  for (size_t i = 2; i < length; ++i) {
+    if (!inRange(p[i], 0x80, 0xBF))
+      return 0;
+  }
+  return length;
+}
+
+std::string hexByte(unsigned char c) {
+  const char digits[] = "0123456789ABCDEF";
+  return std::string("0x") + digits[c >> 4] + digits[c & 0xF];
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Finds the first byte that is not part of well-formed UTF-8
+ * @param data Bytes to check
+ * @param size Number of bytes
+ * @return Offset of the first byte of the first invalid sequence, or size if the input is valid
+ */
+size_t findInvalidUtf8(const char *data, size_t size) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+  size_t               pos   = simd::findNonAscii(data, size);
+  while (pos < size) {
+    size_t length = sequenceLength(bytes + pos, size - pos);
+    if (length == 0)
+      return pos;
+    pos += length;
+    pos += simd::findNonAscii(data + pos, size - pos);
+  }
+  return size;
+}
+
+/**
+ * @brief Checks the encoding of a document and normalizes its line breaks
+ * @param source YAML text; must outlive the input
+ * @throws EncodingException if the source is not valid UTF-8
+ */
+YamlInput::YamlInput(const std::string &source) : m_source(source) {
+  size_t invalid = findInvalidUtf8(source.data(), source.size());
+  if (invalid < source.size()) {
+    const unsigned char byte = static_cast<unsigned char>(source[invalid]);
+    const size_t        line = 1 + static_cast<size_t>(std::count(source.data(), source.data() + invalid, '\n'));
+    if (invalid == 0 && source.size() >= 2 && (byte == 0xFE || byte == 0xFF))
+      throw EncodingException("UTF-16 or UTF-32 byte order mark; only UTF-8 is supported", line, invalid);
+    throw EncodingException("invalid UTF-8 sequence starting with byte " + hexByte(byte), line, invalid);
+  }
+  m_bom = source.compare(0, 3, UTF8_BOM) == 0;
+  normalize();
+}
+
+/**
+ * @brief Get the text to scan
+ * @return The source itself, or its normalized copy
+ */
+const std::string &YamlInput::text() const {
+  return m_normalized ? m_copy : m_source;
+}
+
+/**
+ * @brief Check if the source started with a byte order mark
+ * @return true if a UTF-8 byte order mark was dropped
+ */
+bool YamlInput::hasBom() const {
+  return m_bom;
+}
+
+/**
+ * @brief Check if the text differs from the source
+ * @return true if a byte order mark was dropped or line breaks were rewritten
+ */
+bool YamlInput::normalized() const {
+  return m_normalized;
+}
+
+/**
+ * @brief Builds the normalized copy if the source needs one
+ * @details "\r\n" and a lone '\r' both become '\n', as YAML reads either as a
+ *          line break. The copy is reserved once at the source size.
+ */
+void YamlInput::normalize() {
+  const char *data  = m_source.data();
+  size_t      size  = m_source.size();
+  size_t      pos   = m_bom ? 3 : 0;
+  const void *found = std::memchr(data + pos, '\r', size - pos);
+  if (!found && !m_bom)
+    return;
+
+  m_copy.reserve(size - pos);
+  while (found) {
+    size_t cr = static_cast<size_t>(static_cast<const char *>(found) - data);
+    m_copy.append(data + pos, cr - pos);
+    m_copy += '\n';
+    pos = cr + 1;
+    if (pos < size && data[pos] == '\n')
+      pos++;
+    found = std::memchr(data + pos, '\r', size - pos);
+  }
+  m_copy.append(data + pos, size - pos);
+  m_normalized = true;
+}
+
+} // namespace yamlparser
@@ -0,0 +1,431 @@
+#include "YamlJsonPrinter.hpp"
+#include "YamlException.hpp"
+#include "YamlHelperFunctions.hpp"
+#include "YamlSimd.hpp"
+#include "YamlTrace.hpp"
+#include <cmath>
+
+// YamlJsonPrinter implementation - Converts YAML data structures to JSON text
+// Key features:
+// - Compact output rendered into a YamlOutputBuffer
+// - String escaping copies clean runs found by a SIMD scan in one append
+// - Numbers formatted by the shared YamlNumberFormat kernel (shortest
+//   round-trip doubles, locale-independent decimal point)
+// - YamlJsonEmitter mirrors the YamlEmitter API for streaming output
+
+namespace yamlparser {
+
+namespace {
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+void writeJsonDouble(double value, YamlOutputBuffer &out) {
+  if (!std::isfinite(value)) {
+    out.append("null", 4); // JSON has no representation for inf/nan
+    return;
+  }
+  writeDouble(value, out);
+}
+
+void writeEscape(unsigned char c, YamlOutputBuffer &out) {
+  switch (c) {
+  case '"':
+    out.append("\\\"", 2);
+    break;
+  case '\\':
+    out.append("\\\\", 2);
+    break;
+  case '\b':
+    out.append("\\b", 2);
+    break;
+  case '\f':
+    out.append("\\f", 2);
+    break;
+  case '\n':
+    out.append("\\n", 2);
+    break;
+  case '\r':
+    out.append("\\r", 2);
+    break;
+  case '\t':
+    out.append("\\t", 2);
+    break;
+  default: {
+    char esc[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+    out.append(esc, sizeof(esc));
+    break;
+  }
+  }
+}
+} // anonymous namespace
+
+/**
+ * @brief Writes a string as a quoted, escaped JSON string
+ * @param s The string to write (bytes >= 0x80 are passed through unchanged)
+ * @param out The output buffer to write to
+ */
+void YamlJsonPrinter::writeString(const std::string &s, YamlOutputBuffer &out) {
+  out.append('"');
+  const char *data = s.data();
+  size_t      size = s.size();
+  size_t      pos  = 0;
+  while (pos < size) {
+    size_t next = pos + simd::findJsonEscape(data + pos, size - pos);
+    out.append(data + pos, next - pos);
+    if (next == size)
+      break;
+    writeEscape(static_cast<unsigned char>(data[next]), out);
+    pos = next + 1;
+  }
+  out.append('"');
+}
+
+/**
+ * @brief Prints a YAML mapping as a JSON object
+ * @param map The YAML mapping to print
+ * @param out The output buffer to write to
+ */
+void YamlJsonPrinter::print(const YamlMap &map, YamlOutputBuffer &out) {
+  out.append('{');
+  bool first = true;
+  for (const auto &kv : map) {
+    if (!first)
+      out.append(',');
+    first = false;
+    writeString(kv.first, out);
+    out.append(':');
+    print(kv.second, out);
+  }
+  out.append('}');
+}
+
+/**
+ * @brief Prints a YAML sequence as a JSON array
+ * @param seq The YAML sequence to print
+ * @param out The output buffer to write to
+ */
+void YamlJsonPrinter::print(const YamlSeq &seq, YamlOutputBuffer &out) {
+  out.append('[');
+  bool first = true;
+  for (const auto &item : seq) {
+    if (!first)
+      out.append(',');
+    first = false;
+    print(item, out);
+  }
+  out.append(']');
+}
+
+/**
+ * @brief Prints a YAML item as a JSON value
+ * @param item The YAML item to print
+ * @param out The output buffer to write to
+ */
+void YamlJsonPrinter::print(const YamlItem &item, YamlOutputBuffer &out) {
+  const YamlElement &v = item.value;
+  switch (v.type) {
+  case YamlElement::ElementType::STRING:
+    writeString(v.asString(), out);
+    break;
+  case YamlElement::ElementType::DOUBLE:
+    writeJsonDouble(v.asDouble(), out);
+    break;
+  case YamlElement::ElementType::INT:
+    writeInt(v.asInt(), out);
+    break;
+  case YamlElement::ElementType::BOOL:
+    if (v.asBool())
+      out.append("true", 4);
+    else
+      out.append("false", 5);
+    break;
+  case YamlElement::ElementType::SEQ:
+    print(v.asSeq(), out);
+    break;
+  case YamlElement::ElementType::MAP:
+    print(v.asMap(), out);
+    break;
+  default:
+    out.append("null", 4);
+    break;
+  }
+}
+
+/**
+ * @brief Prints a YAML mapping as JSON to an output stream
+ * @param map The YAML mapping to print
+ * @param os The output stream to write to
+ */
+void YamlJsonPrinter::print(const YamlMap &map, std::ostream &os) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlJsonPrinter::print");
+  YamlOutputBuffer out(os);
+  print(map, out);
+  out.flush();
+}
+
+/**
+ * @brief Prints a YAML sequence as JSON to an output stream
+ * @param seq The YAML sequence to print
+ * @param os The output stream to write to
+ */
+void YamlJsonPrinter::print(const YamlSeq &seq, std::ostream &os) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlJsonPrinter::print");
+  YamlOutputBuffer out(os);
+  print(seq, out);
+  out.flush();
+}
+
+/**
+ * @brief Prints a YAML item as JSON to an output stream
+ * @param item The YAML item to print
+ * @param os The output stream to write to
+ */
+void YamlJsonPrinter::print(const YamlItem &item, std::ostream &os) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlJsonPrinter::print");
+  YamlOutputBuffer out(os);
+  print(item, out);
+  out.flush();
+}
+
+/**
+ * @brief Renders a YAML mapping as a JSON string
+ * @param map The YAML mapping to render
+ * @return The JSON text
+ */
+std::string YamlJsonPrinter::toString(const YamlMap &map) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlJsonPrinter::toString");
+  YamlOutputBuffer out;
+  print(map, out);
+  return out.str();
+}
+
+/**
+ * @brief Renders a YAML sequence as a JSON string
+ * @param seq The YAML sequence to render
+ * @return The JSON text
+ */
+std::string YamlJsonPrinter::toString(const YamlSeq &seq) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlJsonPrinter::toString");
+  YamlOutputBuffer out;
+  print(seq, out);
+  return out.str();
+}
+
+/**
+ * @brief Creates a JSON emitter writing to a stream through an internal buffer
+ * @param os Destination stream
+ */
+YamlJsonEmitter::YamlJsonEmitter(std::ostream &os)
+    : m_ownedBuffer(std::make_unique<YamlOutputBuffer>(os)), m_out(m_ownedBuffer.get()) {}
+
+/**
+ * @brief Creates a JSON emitter writing into a caller-supplied buffer
+ * @param out Destination buffer (must outlive the emitter)
+ */
+YamlJsonEmitter::YamlJsonEmitter(YamlOutputBuffer &out) : m_out(&out) {}
+
+/**
+ * @brief Destructor - pending output of an owned buffer is written to the stream
+ */
+YamlJsonEmitter::~YamlJsonEmitter() = default;
+
+/**
+ * @brief Prepares the current context to receive a value
+ * @param what Description of the value used in error messages
+ * @throws StructureException if there is no open collection or no pending key
+ * @details Inside an array this writes the separating comma; inside an
+ *          object it consumes the key written by key().
+ */
+void YamlJsonEmitter::beginValue(const char *what) {
+  if (m_stack.empty()) {
+    throw StructureException(std::string(what) + " outside of a mapping or sequence");
+  }
+  Frame &top = m_stack.back();
+  if (top.type == FrameType::MAP) {
+    if (!top.keyPending) {
+      throw StructureException(std::string(what) + " in mapping without a preceding key");
+    }
+    top.keyPending = false;
+  } else {
+    if (!top.empty)
+      m_out->append(',');
+    top.empty = false;
+  }
+}
+
+/**
+ * @brief Opens an object or array, either as the root or as a nested value
+ * @param type Kind of collection to open
+ * @throws StructureException if a root was already written or no key is pending
+ */
+void YamlJsonEmitter::beginCollection(FrameType type) {
+  if (m_stack.empty()) {
+    if (m_started) {
+      throw StructureException("document root has already been written");
+    }
+    m_started = true;
+  } else {
+    beginValue(type == FrameType::MAP ? "mapping" : "sequence");
+  }
+  m_out->append(type == FrameType::MAP ? '{' : '[');
+  m_stack.push_back({type, true, false});
+}
+
+/**
+ * @brief Opens a JSON object
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::beginMap() {
+  beginCollection(FrameType::MAP);
+  return *this;
+}
+
+/**
+ * @brief Opens a JSON array
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::beginSeq() {
+  beginCollection(FrameType::SEQ);
+  return *this;
+}
+
+/**
+ * @brief Writes an object key; the next call must provide its value
+ * @param key The key to write
+ * @return Reference to this emitter for chaining
+ * @throws StructureException if not inside an object or a key is already pending
+ */
+YamlJsonEmitter &YamlJsonEmitter::key(const std::string &key) {
+  if (m_stack.empty() || m_stack.back().type != FrameType::MAP) {
+    throw StructureException("key '" + key + "' outside of a mapping");
+  }
+  Frame &top = m_stack.back();
+  if (top.keyPending) {
+    throw StructureException("key '" + key + "' written while the previous key has no value");
+  }
+  if (!top.empty)
+    m_out->append(',');
+  top.empty = false;
+  YamlJsonPrinter::writeString(key, *m_out);
+  m_out->append(':');
+  top.keyPending = true;
+  return *this;
+}
+
+/**
+ * @brief Closes the innermost open object or array
+ * @return Reference to this emitter for chaining
+ * @throws StructureException if nothing is open or a key has no value
+ */
+YamlJsonEmitter &YamlJsonEmitter::end() {
+  if (m_stack.empty()) {
+    throw StructureException("end() without an open mapping or sequence");
+  }
+  if (m_stack.back().keyPending) {
+    throw StructureException("mapping closed while a key has no value");
+  }
+  m_out->append(m_stack.back().type == FrameType::MAP ? '}' : ']');
+  m_stack.pop_back();
+  return *this;
+}
+
+/**
+ * @brief Writes a string value
+ * @param s The string to write
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(const std::string &s) {
+  beginValue("value");
+  YamlJsonPrinter::writeString(s, *m_out);
+  return *this;
+}
+
+/**
+ * @brief Writes a string value given as a C string
+ * @param s The NUL-terminated string to write
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(const char *s) {
+  return value(std::string(s));
+}
+
+/**
+ * @brief Writes an integer value
+ * @param i The integer to write
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(int i) {
+  beginValue("value");
+  writeInt(i, *m_out);
+  return *this;
+}
+
+/**
+ * @brief Writes a floating-point value (non-finite values become null)
+ * @param d The double to write
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(double d) {
+  beginValue("value");
+  writeJsonDouble(d, *m_out);
+  return *this;
+}
+
+/**
+ * @brief Writes a boolean value
+ * @param b The boolean to write
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(bool b) {
+  beginValue("value");
+  if (b)
+    m_out->append("true", 4);
+  else
+    m_out->append("false", 5);
+  return *this;
+}
+
+/**
+ * @brief Writes an already-built subtree as the next value
+ * @param item The item to write (scalar or collection)
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::value(const YamlItem &item) {
+  beginValue("value");
+  YamlJsonPrinter::print(item, *m_out);
+  return *this;
+}
+
+/**
+ * @brief Writes a null value
+ * @return Reference to this emitter for chaining
+ */
+YamlJsonEmitter &YamlJsonEmitter::null() {
+  beginValue("value");
+  m_out->append("null", 4);
+  return *this;
+}
+
+/**
+ * @brief Get the number of currently open collections
+ * @return Nesting depth (0 before the root is opened and after it is closed)
+ */
+size_t YamlJsonEmitter::depth() const {
+  return m_stack.size();
+}
+
+/**
+ * @brief Check whether a complete document has been written
+ * @return true once the root collection has been opened and closed again
+ */
+bool YamlJsonEmitter::complete() const {
+  return m_started && m_stack.empty();
+}
+
+/**
+ * @brief Writes buffered output to the destination stream
+ */
+void YamlJsonEmitter::flush() {
+  m_out->flush();
+}
+
+} // namespace yamlparser
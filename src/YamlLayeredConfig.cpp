@@ -0,0 +1,352 @@
+#include "YamlLayeredConfig.hpp"
+#include "YamlException.hpp"
+#include "YamlParser.hpp"
+
+// YamlLayeredConfig implementation - priority lookups over stacked documents
+// Key features:
+// - A node is a list of pointers to the layers' mappings at one path, so a
+//   lookup costs one map search per layer that still has the path
+// - Keys of several mappings are merged by walking their sorted entries side
+//   by side; flatten() and keys() visit every entry once and append to the
+//   result in key order, which keeps them linear in the size of the layers
+//   (times the number of layers for picking the next key)
+
+namespace yamlparser {
+
+namespace {
+
+using LayerMap  = YamlLayeredNode::LayerMap;
+using LayerItem = std::pair<size_t, const YamlItem *>;
+
+/**
+ * Calls fn(key, values) for every key of the mappings in ascending order.
+ * maps are ordered highest priority first; values holds the entries for the
+ * key in the same order, cut after the first one that is not a mapping.
+ */
+template <typename Fn> void forEachMergedKey(const std::vector<LayerMap> &maps, Fn fn) {
+  std::vector<YamlMap::const_iterator> pos;
+  pos.reserve(maps.size());
+  for (const auto &map : maps)
+    pos.push_back(map.second->begin());
+
+  std::vector<LayerItem> values;
+  while (true) {
+    const std::string *key = nullptr;
+    for (size_t i = 0; i < maps.size(); ++i) {
+      if (pos[i] != maps[i].second->end() && (!key || pos[i]->first < *key))
+        key = &pos[i]->first;
+    }
+    if (!key)
+      return;
+
+    values.clear();
+    bool shadowed = false;
+    for (size_t i = 0; i < maps.size(); ++i) {
+      if (pos[i] == maps[i].second->end() || pos[i]->first != *key)
+        continue;
+      if (!shadowed) {
+        values.emplace_back(maps[i].first, &pos[i]->second);
+        shadowed = !pos[i]->second.value.isMap();
+      }
+    }
+    fn(*key, values);
+    // key stays valid: advancing an iterator does not touch the entry it left
+    for (size_t i = 0; i < maps.size(); ++i) {
+      if (pos[i] != maps[i].second->end() && pos[i]->first == *key)
+        ++pos[i];
+    }
+  }
+}
+
+YamlMap mergeMaps(const std::vector<LayerMap> &maps);
+
+// Builds the merged value of one key from its entries, highest priority first
+YamlItem mergeValues(const std::vector<LayerItem> &values) {
+  if (values.size() == 1 || !values.front().second->value.isMap())
+    return *values.front().second;
+  std::vector<LayerMap> maps;
+  maps.reserve(values.size());
+  for (const auto &value : values) {
+    if (value.second->value.isMap())
+      maps.emplace_back(value.first, &value.second->value.asMap());
+  }
+  return YamlItem(YamlElement(mergeMaps(maps)));
+}
+
+YamlMap mergeMaps(const std::vector<LayerMap> &maps) {
+  if (maps.size() == 1)
+    return *maps.front().second;
+  YamlMap merged;
+  forEachMergedKey(maps, [&](const std::string &key, const std::vector<LayerItem> &values) {
+    merged.emplace_hint(merged.end(), key, mergeValues(values));
+  });
+  return merged;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Check if the node is a mapping
+ * @return true if the winning value is a mapping; its entries are then merged across layers
+ */
+bool YamlLayeredNode::isMap() const {
+  return m_leaf == nullptr;
+}
+
+/**
+ * @brief Get the layer that supplies the value
+ * @return Index for YamlLayeredConfig::layerName(); for mappings the highest layer that has one here
+ */
+size_t YamlLayeredNode::layer() const {
+  return m_layer;
+}
+
+/**
+ * @brief Access a map entry by key
+ * @param key The key to look up
+ * @return Handle to the merged value
+ * @throws TypeException if node is not a mapping
+ * @throws KeyException if no layer has the key
+ */
+YamlLayeredNode YamlLayeredNode::at(const std::string &key) const {
+  if (!isMap())
+    throw TypeException("Expected mapping, but element is not a mapping");
+  YamlLayeredNode child;
+  for (const auto &map : m_maps) {
+    auto it = map.second->find(key);
+    if (it == map.second->end())
+      continue;
+    if (child.m_maps.empty())
+      child.m_layer = map.first;
+    if (!it->second.value.isMap()) {
+      // A plain value wins if nothing above it has the key, and hides everything below
+      if (child.m_maps.empty())
+        child.m_leaf = &it->second;
+      break;
+    }
+    child.m_maps.emplace_back(map.first, &it->second.value.asMap());
+  }
+  if (!child.m_leaf && child.m_maps.empty())
+    throw KeyException(key);
+  return child;
+}
+
+/**
+ * @brief Check whether any layer has a key in this mapping
+ * @param key The key to look up
+ * @return true if the key is present
+ * @throws TypeException if node is not a mapping
+ */
+bool YamlLayeredNode::contains(const std::string &key) const {
+  if (!isMap())
+    throw TypeException("Expected mapping, but element is not a mapping");
+  for (const auto &map : m_maps) {
+    if (map.second->find(key) != map.second->end())
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Get the merged keys of the mapping
+ * @return Keys of all layers, sorted and without duplicates
+ * @throws TypeException if node is not a mapping
+ */
+std::vector<std::string> YamlLayeredNode::keys() const {
+  if (!isMap())
+    throw TypeException("Expected mapping, but element is not a mapping");
+  std::vector<std::string> keys;
+  forEachMergedKey(m_maps, [&](const std::string &key, const std::vector<LayerItem> &) { keys.push_back(key); });
+  return keys;
+}
+
+/**
+ * @brief Get the number of merged entries of a mapping, or of items of a sequence
+ * @return Entry count
+ * @throws TypeException if node is a scalar
+ */
+size_t YamlLayeredNode::size() const {
+  if (!isMap())
+    return asSeq().size();
+  size_t count = 0;
+  forEachMergedKey(m_maps, [&](const std::string &, const std::vector<LayerItem> &) { count++; });
+  return count;
+}
+
+/**
+ * @brief Get the winning element of a non-mapping node
+ * @return The element as stored in its layer
+ * @throws TypeException if node is a mapping
+ */
+const YamlElement &YamlLayeredNode::value() const {
+  if (isMap())
+    throw TypeException("Expected a value, but element is a layered mapping");
+  return m_leaf->value;
+}
+
+/**
+ * @brief Get the string value
+ * @return Reference into the winning layer
+ * @throws TypeException if the value is not a string
+ */
+const std::string &YamlLayeredNode::asString() const {
+  return value().asString();
+}
+
+/**
+ * @brief Get the integer value
+ * @return The value
+ * @throws TypeException if the value is not an integer
+ */
+int YamlLayeredNode::asInt() const {
+  return value().asInt();
+}
+
+/**
+ * @brief Get the double value
+ * @return The value
+ * @throws TypeException if the value is not a double
+ */
+double YamlLayeredNode::asDouble() const {
+  return value().asDouble();
+}
+
+/**
+ * @brief Get the boolean value
+ * @return The value
+ * @throws TypeException if the value is not a boolean
+ */
+bool YamlLayeredNode::asBool() const {
+  return value().asBool();
+}
+
+/**
+ * @brief Get the sequence value; sequences are not merged across layers
+ * @return Reference into the winning layer
+ * @throws TypeException if the value is not a sequence
+ */
+const YamlSeq &YamlLayeredNode::asSeq() const {
+  return value().asSeq();
+}
+
+/**
+ * @brief Converts the node into an ordinary item
+ * @return Deep copy of the winning value, or of the merged mapping
+ */
+YamlItem YamlLayeredNode::toItem() const {
+  if (!isMap())
+    return *m_leaf;
+  return YamlItem(YamlElement(mergeMaps(m_maps)));
+}
+
+/**
+ * @brief Adds a layer above all current layers
+ * @param name Name reported by layerName(), e.g. the file it came from
+ * @param map The document; shared, not copied
+ * @throws StructureException if map is null
+ * @details Node handles obtained before the call do not see the new layer.
+ */
+void YamlLayeredConfig::addLayer(const std::string &name, std::shared_ptr<const YamlMap> map) {
+  if (!map)
+    throw StructureException("Layer '" + name + "' has no document");
+  m_names.push_back(name);
+  m_layers.push_back(std::move(map));
+}
+
+/**
+ * @brief Parses a file and adds it above all current layers
+ * @param filename Path to a YAML document whose root is a mapping
+ * @param limits Limits for parsing the file
+ * @throws FileException, SyntaxException or LimitException if the file cannot be parsed
+ * @throws TypeException if the root of the document is a sequence
+ */
+void YamlLayeredConfig::addFile(const std::string &filename, const ParseLimits &limits) {
+  addLayer(filename, load(filename, limits));
+}
+
+/**
+ * @brief Parses a file into a layer that can be shared between configurations
+ * @param filename Path to a YAML document whose root is a mapping
+ * @param limits Limits for parsing the file
+ * @return The root mapping; it stays owned by the parser that read it, so it is never copied
+ * @throws FileException, SyntaxException or LimitException if the file cannot be parsed
+ * @throws TypeException if the root of the document is a sequence
+ */
+std::shared_ptr<const YamlMap> YamlLayeredConfig::load(const std::string &filename, const ParseLimits &limits) {
+  auto parser = std::make_shared<YamlParser>(limits);
+  parser->parse(filename);
+  if (parser->isSequenceRoot())
+    throw TypeException("Layer root is not a mapping: " + filename);
+  return std::shared_ptr<const YamlMap>(parser, &parser->root());
+}
+
+/**
+ * @brief Get the number of layers
+ * @return Layer count
+ */
+size_t YamlLayeredConfig::layerCount() const {
+  return m_layers.size();
+}
+
+/**
+ * @brief Get the name of a layer
+ * @param index 0 for the lowest-priority layer
+ * @return The name given to addLayer(), or the file name for addFile()
+ * @throws IndexException if index is out of bounds
+ */
+const std::string &YamlLayeredConfig::layerName(size_t index) const {
+  if (index >= m_names.size())
+    throw IndexException(index, m_names.size());
+  return m_names[index];
+}
+
+/**
+ * @brief Get the document of a layer
+ * @param index 0 for the lowest-priority layer
+ * @return The layer's root mapping
+ * @throws IndexException if index is out of bounds
+ */
+const YamlMap &YamlLayeredConfig::layer(size_t index) const {
+  if (index >= m_layers.size())
+    throw IndexException(index, m_layers.size());
+  return *m_layers[index];
+}
+
+/**
+ * @brief Get the merged root mapping
+ * @return Handle over the roots of all layers; an empty mapping without layers
+ */
+YamlLayeredNode YamlLayeredConfig::root() const {
+  YamlLayeredNode node;
+  node.m_maps.reserve(m_layers.size());
+  for (size_t i = m_layers.size(); i-- > 0;)
+    node.m_maps.emplace_back(i, m_layers[i].get());
+  node.m_layer = m_layers.empty() ? 0 : m_layers.size() - 1;
+  return node;
+}
+
+/**
+ * @brief Access a top-level key of the merged document
+ * @param key The key to look up
+ * @return Handle to the merged value
+ * @throws KeyException if no layer has the key
+ */
+YamlLayeredNode YamlLayeredConfig::get(const std::string &key) const {
+  return root().at(key);
+}
+
+/**
+ * @brief Builds the merged document
+ * @return Ordinary mapping equal to the layered view
+ * @details Each entry of every layer is visited once and every value of the
+ *          result is copied once, so the cost is linear in the size of the
+ *          layers for a fixed number of them.
+ */
+YamlMap YamlLayeredConfig::flatten() const {
+  YamlLayeredNode top = root();
+  if (top.m_maps.empty())
+    return YamlMap();
+  return mergeMaps(top.m_maps);
+}
+
+} // namespace yamlparser
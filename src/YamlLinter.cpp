@@ -0,0 +1,446 @@
+#include "YamlLinter.hpp"
+#include "YamlBlockScalar.hpp"
+#include "YamlException.hpp"
+#include "YamlHelperFunctions.hpp"
+#include "YamlInput.hpp"
+#include "YamlParser.hpp"
+#include "YamlScanner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+// YamlLinter implementation - the parser's walk, minus the tree
+// Key features:
+// - lintMap()/lintSeq() follow YamlParser::parseMap()/parseSeq() line for
+//   line, so a document passes the linter exactly when it parses; values
+//   are checked with the same helpers (YamlBlockScalar, YamlFlowParser,
+//   YamlParser::parseScalar()) and then dropped
+// - Errors are caught per entry: the entry is reported, its more indented
+//   lines are skipped, and the enclosing collection carries on
+// - lintFiles() hands out file indices from an atomic counter to a pool of
+//   threads, each with its own linter; results are stored per file, so the
+//   report keeps the input order without locking
+
+namespace yamlparser {
+
+/**
+ * @brief Formats the diagnostic like a compiler message
+ * @return "file:line: message", or "file: message" if there is no line
+ */
+std::string YamlDiagnostic::str() const {
+  return file + (line > 0 ? ":" + std::to_string(line) : std::string()) + ": " + message;
+}
+
+/**
+ * @brief Check if the run found nothing
+ * @return true if there are no diagnostics
+ */
+bool YamlLintReport::ok() const {
+  return diagnostics.empty();
+}
+
+/**
+ * @brief Get the throughput of the run
+ * @return Megabytes (10^6 bytes) checked per wall-clock second
+ */
+double YamlLintReport::megabytesPerSecond() const {
+  return seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0;
+}
+
+/**
+ * @brief Get the file rate of the run
+ * @return Files checked per wall-clock second
+ */
+double YamlLintReport::filesPerSecond() const {
+  return seconds > 0 ? static_cast<double>(files) / seconds : 0.0;
+}
+
+/**
+ * @brief Constructs a linter
+ * @param maxDepth Deepest nesting checked, counted like ParseLimits::maxDepth
+ */
+YamlLinter::YamlLinter(size_t maxDepth) : m_maxDepth(maxDepth) {}
+
+/**
+ * @brief Checks YAML text held in memory
+ * @param content The YAML document
+ * @param name Name reported in the diagnostics
+ * @return All diagnostics of the document, by line; empty if it parses
+ * @details Invalid UTF-8 is reported once and ends the check, as the
+ *          parser would not get past it either.
+ */
+std::vector<YamlDiagnostic> YamlLinter::lintString(const std::string &content, const std::string &name) {
+  m_name = name;
+  m_anchors.clear();
+  m_diagnostics.clear();
+  try {
+    YamlInput   input(content);
+    YamlScanner tokens(input.text());
+    m_tokens   = &tokens;
+    size_t idx = 0;
+    if (tokens.startsWithSequence())
+      lintSeq(idx, 0, 1);
+    else
+      lintMap(idx, 0, 1);
+  } catch (const EncodingException &e) {
+    report(e.line(), e.what());
+  } catch (const std::exception &e) {
+    report(0, e.what());
+  }
+  m_tokens = nullptr;
+
+  std::vector<YamlDiagnostic> diagnostics;
+  diagnostics.swap(m_diagnostics);
+  std::stable_sort(diagnostics.begin(), diagnostics.end(),
+                   [](const YamlDiagnostic &a, const YamlDiagnostic &b) { return a.line < b.line; });
+  return diagnostics;
+}
+
+/**
+ * @brief Checks a YAML file
+ * @param filename Path to the file
+ * @return All diagnostics of the file; a file that cannot be read gets one without a line
+ */
+std::vector<YamlDiagnostic> YamlLinter::lintFile(const std::string &filename) {
+  size_t bytes = 0;
+  return lintFile(filename, bytes);
+}
+
+/**
+ * @brief Checks files on a pool of threads
+ * @param files Paths of the files
+ * @param threads Number of threads; 0 uses one per hardware thread
+ * @return Diagnostics of all files, in the order of files, and the throughput of the run
+ */
+YamlLintReport YamlLinter::lintFiles(const std::vector<std::string> &files, size_t threads) const {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::max<size_t>(1, std::min(threads, files.size()));
+
+  std::vector<std::vector<YamlDiagnostic>> results(files.size());
+  std::vector<size_t>                      sizes(files.size(), 0);
+  std::atomic<size_t>                      next(0);
+  auto                                     worker = [&]() {
+    YamlLinter linter(m_maxDepth);
+    for (size_t i = next++; i < files.size(); i = next++)
+      results[i] = linter.lintFile(files[i], sizes[i]);
+  };
+
+  auto                     start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  try {
+    for (size_t i = 1; i < threads; ++i)
+      pool.emplace_back(worker);
+    worker();
+  } catch (...) {
+    // A thread could not be started: hand out no more files and join the
+    // ones already running, so none is still joinable when the stack unwinds
+    next = files.size();
+    for (auto &thread : pool)
+      thread.join();
+    throw;
+  }
+  for (auto &thread : pool)
+    thread.join();
+
+  YamlLintReport report;
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  report.files   = files.size();
+  report.threads = threads;
+  for (size_t i = 0; i < files.size(); ++i) {
+    report.bytes += sizes[i];
+    if (results[i].empty())
+      continue;
+    report.failedFiles++;
+    std::move(results[i].begin(), results[i].end(), std::back_inserter(report.diagnostics));
+  }
+  return report;
+}
+
+/**
+ * @brief Reads and checks a file
+ * @param filename Path to the file
+ * @param bytes Receives the size of the file
+ * @return All diagnostics of the file
+ */
+std::vector<YamlDiagnostic> YamlLinter::lintFile(const std::string &filename, size_t &bytes) {
+  bytes = 0;
+  std::ifstream file(filename);
+  if (!file.is_open())
+    return {YamlDiagnostic{filename, 0, FileException(filename).what()}};
+  std::ostringstream content;
+  content << file.rdbuf();
+  std::string text = content.str();
+  bytes            = text.size();
+  return lintString(text, filename);
+}
+
+/**
+ * @brief Checks a block mapping, as YamlParser::parseMap()
+ * @param idx First line of the mapping; moved past it
+ * @param indent Indentation of the mapping
+ * @param depth Depth of its entries
+ */
+void YamlLinter::lintMap(size_t &idx, size_t indent, size_t depth) {
+  if (!enter(idx, indent, depth))
+    return;
+  const YamlScanner    &tokens = *m_tokens;
+  std::set<std::string> keys;
+
+  while (idx < tokens.size()) {
+    const YamlToken &token = tokens[idx];
+    if (token.kind == YamlTokenKind::Blank || token.kind == YamlTokenKind::Comment) {
+      idx++;
+      continue;
+    }
+    if (token.indent < indent)
+      break;
+    size_t start = idx;
+    try {
+      lintMapEntry(idx, depth, keys);
+    } catch (const SyntaxException &e) {
+      report(e.line() ? e.line() : token.line, e.detail());
+      idx = start;
+      recover(idx);
+    } catch (const YamlException &e) {
+      report(token.line, e.what());
+      idx = start;
+      recover(idx);
+    }
+  }
+}
+
+/**
+ * @brief Checks one line of a block mapping and the lines it owns
+ * @param idx Line of the entry; moved to the next entry
+ * @param depth Depth of the entry
+ * @param keys Keys defined so far in the mapping
+ * @throws YamlException for the first problem of the entry itself
+ */
+void YamlLinter::lintMapEntry(size_t &idx, size_t depth, std::set<std::string> &keys) {
+  const YamlScanner &tokens = *m_tokens;
+  const YamlToken   &token  = tokens[idx];
+
+  // Sequence lines belong to the key of the closest line above
+  if (token.kind == YamlTokenKind::SequenceItem) {
+    size_t prev = idx;
+    while (prev > 0 && tokens[prev - 1].kind == YamlTokenKind::Blank)
+      prev--;
+    if (prev > 0 && tokens[prev - 1].hasColon) {
+      std::string key = tokens.str(tokens.key(tokens[prev - 1]));
+      if (keys.find(key) == keys.end()) {
+        lintSeq(idx, token.indent, depth + 1);
+        keys.insert(key);
+      }
+    }
+    idx++;
+    return;
+  }
+
+  if (!token.hasColon)
+    throw SyntaxException("Missing ':' in key-value pair: '" + tokens.str(tokens.content(token)) + "'", token.line);
+  if (tokens.key(token).empty())
+    throw SyntaxException("Empty key in key-value pair", token.line);
+  std::string key   = tokens.str(tokens.key(token));
+  std::string value = tokens.str(tokens.value(token));
+  if (keys.find(key) != keys.end())
+    throw SyntaxException("Duplicate mapping key: '" + key + "'", token.line);
+
+  if (value.empty()) {
+    size_t next = tokens.nextNonBlank(idx + 1);
+    if (next < tokens.size() && tokens[next].indent > token.indent) {
+      idx = next;
+      if (tokens[next].kind == YamlTokenKind::SequenceItem)
+        lintSeq(idx, tokens[next].indent, depth + 1);
+      else
+        lintMap(idx, tokens[next].indent, depth + 1);
+    } else {
+      idx++;
+    }
+  } else if (isMultilineLiteral(value)) {
+    idx = YamlBlockScalar(tokens, idx, token.indent, value).end();
+  } else if (isAnchor(value)) {
+    lintAnchor(value, idx, depth);
+  } else if (isMergeKey(key, value)) {
+    if (resolveAlias(value) != AnchorKind::Mapping)
+      throw TypeException("Merge target is not a mapping: '" + value + "'");
+    idx++;
+    return; // '<<' may repeat
+  } else if (isAlias(value)) {
+    resolveAlias(value);
+    idx++;
+  } else if (isFlowCollection(value)) {
+    lintFlowCollection(value, token.line, depth);
+    idx++;
+  } else if (value.front() == '[' && value.back() != ']') {
+    throw SyntaxException("Malformed inline sequence: missing closing bracket", token.line);
+  } else {
+    YamlParser::parseScalar(value);
+    idx++;
+  }
+  keys.insert(key);
+}
+
+/**
+ * @brief Checks a block sequence, as YamlParser::parseSeq()
+ * @param idx First line of the sequence; moved past it
+ * @param indent Indentation of the sequence
+ * @param depth Depth of its items
+ */
+void YamlLinter::lintSeq(size_t &idx, size_t indent, size_t depth) {
+  if (!enter(idx, indent, depth))
+    return;
+  const YamlScanner &tokens = *m_tokens;
+
+  while (idx < tokens.size()) {
+    const YamlToken &token = tokens[idx];
+    if (token.kind == YamlTokenKind::Blank || token.kind == YamlTokenKind::Comment) {
+      idx++;
+      continue;
+    }
+    if (token.indent < indent || token.kind != YamlTokenKind::SequenceItem)
+      break;
+    size_t start = idx;
+    try {
+      lintSeqElement(idx, depth);
+    } catch (const SyntaxException &e) {
+      report(e.line() ? e.line() : token.line, e.detail());
+      idx = start;
+      recover(idx);
+    } catch (const YamlException &e) {
+      report(token.line, e.what());
+      idx = start;
+      recover(idx);
+    }
+  }
+}
+
+/**
+ * @brief Checks one sequence item and the lines it owns
+ * @param idx Line of the item; moved to the next item
+ * @param depth Depth of the item
+ * @throws YamlException for the first problem of the item itself
+ */
+void YamlLinter::lintSeqElement(size_t &idx, size_t depth) {
+  const YamlScanner &tokens = *m_tokens;
+  const YamlToken   &token  = tokens[idx];
+  YamlSpan           item   = tokens.item(token);
+
+  if (!item.empty() && (tokens.source()[item.offset] == '|' || tokens.source()[item.offset] == '>')) {
+    idx = YamlBlockScalar(tokens, idx, token.indent, tokens.str(item)).end();
+    return;
+  }
+  // A more indented next line makes the item a mapping
+  if (idx + 1 < tokens.size()) {
+    const YamlToken &next = tokens[idx + 1];
+    if (next.kind != YamlTokenKind::Blank && next.indent > token.indent) {
+      if (!item.empty() && token.hasColon)
+        YamlParser::parseScalar(tokens.str(tokens.value(token)));
+      idx++;
+      lintMap(idx, next.indent, depth + 1);
+      return;
+    }
+  }
+  if (!item.empty()) {
+    std::string value = tokens.str(item);
+    if (isFlowCollection(value))
+      lintFlowCollection(value, token.line, depth);
+    else
+      YamlParser::parseScalar(value);
+  }
+  idx++;
+}
+
+/**
+ * @brief Checks an anchored node and records the anchor, as parseAnchor()
+ * @param value The anchor declaration, e.g. "&base"
+ * @param idx Line of the declaration; moved past the anchored node
+ * @param depth Depth of the entry holding the anchor
+ */
+void YamlLinter::lintAnchor(const std::string &value, size_t &idx, size_t depth) {
+  const YamlScanner &tokens = *m_tokens;
+  AnchorKind         kind   = AnchorKind::Scalar;
+  idx++;
+  if (idx < tokens.size() && tokens[idx].kind != YamlTokenKind::Blank) {
+    const YamlToken &next = tokens[idx];
+    if (next.kind == YamlTokenKind::SequenceItem) {
+      lintSeq(idx, next.indent, depth + 1);
+      kind = AnchorKind::Sequence;
+    } else {
+      lintMap(idx, next.indent, depth + 1);
+      kind = AnchorKind::Mapping;
+    }
+  }
+  m_anchors[value.substr(1)] = kind;
+}
+
+/**
+ * @brief Checks a flow collection
+ * @param value Collection text including brackets or braces
+ * @param line Line of the collection
+ * @param depth Depth of the entry holding it
+ * @throws SyntaxException if the collection is malformed
+ * @throws ConversionException if one of its numbers is out of range
+ */
+void YamlLinter::lintFlowCollection(const std::string &value, size_t line, size_t depth) const {
+  YamlFlowParser flow(depth + m_maxDepth, depth, line);
+  flow.parse(value);
+}
+
+/**
+ * @brief Looks up the anchor of an alias
+ * @param value The alias, e.g. "*base"
+ * @return What the anchor refers to
+ * @throws SyntaxException if no anchor of that name was defined above (the parser throws KeyException)
+ */
+YamlLinter::AnchorKind YamlLinter::resolveAlias(const std::string &value) const {
+  auto it = m_anchors.find(value.substr(1));
+  if (it == m_anchors.end())
+    throw SyntaxException("Undefined alias '" + value + "'");
+  return it->second;
+}
+
+/**
+ * @brief Checks the depth of a collection before its lines are checked
+ * @param idx First line of the collection; moved past it if it is too deep
+ * @param indent Indentation of the collection
+ * @param depth Depth of its entries
+ * @return false if the collection is too deep and was skipped
+ */
+bool YamlLinter::enter(size_t &idx, size_t indent, size_t depth) {
+  if (depth <= m_maxDepth)
+    return true;
+  const YamlScanner &tokens = *m_tokens;
+  report(idx + 1, "Nesting deeper than " + std::to_string(m_maxDepth) + " levels");
+  while (idx < tokens.size() && (tokens[idx].kind == YamlTokenKind::Blank ||
+                                 tokens[idx].kind == YamlTokenKind::Comment || tokens[idx].indent >= indent))
+    idx++;
+  return false;
+}
+
+/**
+ * @brief Skips the rest of an entry that has an error
+ * @param idx Line of the entry; moved to the next line indented the same or less
+ */
+void YamlLinter::recover(size_t &idx) {
+  const YamlScanner &tokens = *m_tokens;
+  const size_t       indent = tokens[idx].indent;
+  idx++;
+  while (idx < tokens.size() && (tokens[idx].kind == YamlTokenKind::Blank ||
+                                 tokens[idx].kind == YamlTokenKind::Comment || tokens[idx].indent > indent))
+    idx++;
+}
+
+/**
+ * @brief Records a diagnostic for the document being checked
+ * @param line 1-based line, or 0 for the whole document
+ * @param message Description of the problem
+ */
+void YamlLinter::report(size_t line, const std::string &message) {
+  m_diagnostics.push_back(YamlDiagnostic{m_name, line, message});
+}
+
+} // namespace yamlparser
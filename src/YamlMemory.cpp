@@ -0,0 +1,288 @@
+#include "YamlMemory.hpp"
+#include <cstdint>
+#include <new>
+
+// YamlMemory implementation - memory resources and allocation accounting
+// Key features:
+// - The current resource and the active tally are thread-local pointers, so
+//   selecting a resource needs no locking and costs nothing on other threads
+// - Resource allocations are tallied in YamlMemoryResource::allocate(); heap
+//   allocations are reported by the optional yamlparser_heap_tally library
+// - The default resource is plain operator new/delete, which a resource call
+//   marks as forwarding so that the heap hook does not count it a second time
+
+namespace yamlparser {
+
+namespace {
+// Resource backed by the global heap
+class NewDeleteResource : public YamlMemoryResource {
+protected:
+  void *doAllocate(size_t bytes, size_t alignment) override {
+    // C++14 has no aligned operator new; YAML trees never need more than this
+    if (alignment > alignof(std::max_align_t))
+      throw std::bad_alloc();
+    return ::operator new(bytes);
+  }
+
+  void doDeallocate(void *p, size_t, size_t) noexcept override {
+    ::operator delete(p);
+  }
+};
+
+NewDeleteResource g_newDelete;
+
+thread_local YamlMemoryResource     *t_current  = nullptr;
+thread_local YamlAllocationCounters *t_counters = nullptr;
+// Set while a resource forwards to its upstream, so that only the outermost call is tallied
+thread_local bool t_forwarding = false;
+
+// Marks the extent of a tallied call
+class ForwardingGuard {
+public:
+  ForwardingGuard() noexcept {
+    t_forwarding = true;
+  }
+
+  ~ForwardingGuard() {
+    t_forwarding = false;
+  }
+};
+
+void countAllocation(size_t bytes) noexcept {
+  t_counters->allocations++;
+  t_counters->allocatedBytes += bytes;
+  t_counters->liveBytes += static_cast<long long>(bytes);
+  if (t_counters->liveBytes > static_cast<long long>(t_counters->peakBytes))
+    t_counters->peakBytes = static_cast<size_t>(t_counters->liveBytes);
+}
+
+void raisePeak(std::atomic<size_t> &peak, size_t value) {
+  size_t seen = peak.load(std::memory_order_relaxed);
+  while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+  }
+}
+} // anonymous namespace
+
+/**
+ * @brief Allocates memory from the resource
+ * @param bytes Size in bytes
+ * @param alignment Required alignment (a power of two)
+ * @return Pointer to the memory
+ * @throws std::bad_alloc if the memory cannot be provided
+ * @details Counted by the calling thread's active YamlAllocationTally, if any.
+ *          Allocations a resource makes from its upstream are not counted again.
+ */
+void *YamlMemoryResource::allocate(size_t bytes, size_t alignment) {
+  if (!t_counters || t_forwarding)
+    return doAllocate(bytes, alignment);
+  void *p;
+  {
+    ForwardingGuard guard;
+    p = doAllocate(bytes, alignment);
+  }
+  countAllocation(bytes);
+  return p;
+}
+
+/**
+ * @brief Returns memory to the resource
+ * @param p Pointer returned by allocate()
+ * @param bytes Size passed to allocate()
+ * @param alignment Alignment passed to allocate()
+ */
+void YamlMemoryResource::deallocate(void *p, size_t bytes, size_t alignment) noexcept {
+  if (!t_counters || t_forwarding) {
+    doDeallocate(p, bytes, alignment);
+    return;
+  }
+  t_counters->liveBytes -= static_cast<long long>(bytes);
+  ForwardingGuard guard;
+  doDeallocate(p, bytes, alignment);
+}
+
+/**
+ * @brief Get the resource backed by global operator new/delete
+ * @return Process-wide default resource
+ */
+YamlMemoryResource *defaultMemoryResource() noexcept {
+  return &g_newDelete;
+}
+
+/**
+ * @brief Get the resource pooled trees of the calling thread allocate from by default
+ * @return The innermost YamlMemoryScope's resource, or the default resource
+ */
+YamlMemoryResource *currentMemoryResource() noexcept {
+  return t_current ? t_current : &g_newDelete;
+}
+
+/**
+ * @brief Makes a resource current for the calling thread
+ * @param resource Resource to use; null selects the default resource
+ */
+YamlMemoryScope::YamlMemoryScope(YamlMemoryResource *resource) noexcept : m_previous(t_current) {
+  t_current = resource;
+}
+
+/**
+ * @brief Restores the previously current resource
+ */
+YamlMemoryScope::~YamlMemoryScope() {
+  t_current = m_previous;
+}
+
+/**
+ * @brief Constructs a counting resource
+ * @param upstream Resource that provides the memory
+ */
+CountingMemoryResource::CountingMemoryResource(YamlMemoryResource *upstream) noexcept
+    : m_upstream(upstream), m_allocations(0), m_allocatedBytes(0), m_liveBytes(0), m_peakBytes(0) {}
+
+/**
+ * @brief Get the number of allocations
+ * @return Allocations since construction
+ */
+size_t CountingMemoryResource::allocations() const noexcept {
+  return m_allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the total number of bytes allocated
+ * @return Bytes since construction, including freed ones
+ */
+size_t CountingMemoryResource::allocatedBytes() const noexcept {
+  return m_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of bytes currently allocated
+ * @return Live bytes
+ */
+size_t CountingMemoryResource::liveBytes() const noexcept {
+  return m_liveBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the high-water mark of the live byte count
+ * @return Peak live bytes since construction or the last resetPeak()
+ */
+size_t CountingMemoryResource::peakBytes() const noexcept {
+  return m_peakBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Restarts the high-water mark at the current live byte count
+ */
+void CountingMemoryResource::resetPeak() noexcept {
+  m_peakBytes.store(m_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void *CountingMemoryResource::doAllocate(size_t bytes, size_t alignment) {
+  void *p = m_upstream->allocate(bytes, alignment);
+  m_allocations.fetch_add(1, std::memory_order_relaxed);
+  m_allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  raisePeak(m_peakBytes, m_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  return p;
+}
+
+void CountingMemoryResource::doDeallocate(void *p, size_t bytes, size_t alignment) noexcept {
+  m_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  m_upstream->deallocate(p, bytes, alignment);
+}
+
+/**
+ * @brief Constructs an empty arena
+ * @param chunkSize Size of the chunks requested from upstream; larger requests get their own chunk
+ * @param upstream Resource that provides the chunks
+ */
+YamlArenaResource::YamlArenaResource(size_t chunkSize, YamlMemoryResource *upstream)
+    : m_chunkSize(chunkSize > 0 ? chunkSize : 1), m_upstream(upstream) {}
+
+/**
+ * @brief Returns all chunks to the upstream resource
+ */
+YamlArenaResource::~YamlArenaResource() {
+  release();
+}
+
+/**
+ * @brief Returns all chunks to the upstream resource
+ * @warning Everything allocated from the arena becomes invalid
+ */
+void YamlArenaResource::release() noexcept {
+  for (const Chunk &chunk : m_chunks)
+    m_upstream->deallocate(chunk.memory, chunk.size);
+  m_chunks.clear();
+  m_cursor = nullptr;
+  m_end    = nullptr;
+}
+
+/**
+ * @brief Get the memory obtained from upstream
+ * @return Total size of all chunks in bytes
+ */
+size_t YamlArenaResource::reservedBytes() const noexcept {
+  size_t total = 0;
+  for (const Chunk &chunk : m_chunks)
+    total += chunk.size;
+  return total;
+}
+
+void *YamlArenaResource::doAllocate(size_t bytes, size_t alignment) {
+  std::uintptr_t cursor  = reinterpret_cast<std::uintptr_t>(m_cursor);
+  std::uintptr_t aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+  if (!m_cursor || aligned + bytes > reinterpret_cast<std::uintptr_t>(m_end)) {
+    size_t size = bytes + alignment > m_chunkSize ? bytes + alignment : m_chunkSize;
+    m_chunks.reserve(m_chunks.size() + 1);
+    Chunk chunk{m_upstream->allocate(size), size};
+    m_chunks.push_back(chunk);
+    m_cursor = static_cast<char *>(chunk.memory);
+    m_end    = m_cursor + size;
+    cursor   = reinterpret_cast<std::uintptr_t>(m_cursor);
+    aligned  = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+  }
+  m_cursor = reinterpret_cast<char *>(aligned + bytes);
+  return reinterpret_cast<void *>(aligned);
+}
+
+void YamlArenaResource::doDeallocate(void *, size_t, size_t) noexcept {
+  // Memory is reclaimed all at once by release()
+}
+
+/**
+ * @brief Starts attributing the calling thread's allocations to a set of counters
+ * @param counters Counters to add to; they are not reset
+ */
+YamlAllocationTally::YamlAllocationTally(YamlAllocationCounters &counters) noexcept : m_previous(t_counters) {
+  t_counters = &counters;
+}
+
+/**
+ * @brief Restores the previously active counters
+ */
+YamlAllocationTally::~YamlAllocationTally() {
+  t_counters = m_previous;
+}
+
+/**
+ * @brief Reports a global heap allocation to the calling thread's active tally
+ * @param bytes Size passed to operator new
+ * @details Called by the yamlparser_heap_tally replacement of operator new.
+ *          Ignored without a tally and for the upstream calls of a resource,
+ *          which allocate() has already counted.
+ */
+void tallyHeapAllocation(size_t bytes) noexcept {
+  if (t_counters && !t_forwarding)
+    countAllocation(bytes);
+}
+
+/**
+ * @brief Reports a global heap deallocation to the calling thread's active tally
+ * @param bytes Size of the block passed to operator delete
+ */
+void tallyHeapDeallocation(size_t bytes) noexcept {
+  if (t_counters && !t_forwarding)
+    t_counters->liveBytes -= static_cast<long long>(bytes);
+}
+
+} // namespace yamlparser
@@ -0,0 +1,241 @@
+#include "YamlMemoryUsage.hpp"
+#include "YamlDiff.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+// YamlMemoryUsage implementation - heap usage walk over a hashed tree
+// Key features:
+// - One pass over a YamlHashTree: the subtree hashes find candidate repeats,
+//   which are confirmed by a structural comparison so that a hash collision
+//   cannot inflate duplicateBytes; the same walk sums up the bytes per category
+// - A repeated collection counts towards duplicateBytes once, at its top;
+//   nested repeats inside it are not counted again
+// - The largest subtrees are kept in a bounded min-heap; paths are only
+//   built when they are requested
+
+namespace yamlparser {
+
+namespace {
+// Red-black tree node: color and three links, followed by the entry
+const size_t MAP_NODE_BYTES = 4 * sizeof(void *) + sizeof(YamlMap::value_type);
+
+size_t heapBytes(const std::string &s) {
+  static const size_t inlineCapacity = std::string().capacity();
+  return s.capacity() > inlineCapacity ? s.capacity() + 1 : 0;
+}
+
+std::string keyPath(const std::string &parent, const std::string &key) {
+  return parent.empty() ? key : parent + "." + key;
+}
+
+std::string indexPath(const std::string &parent, size_t index) {
+  return parent + "[" + std::to_string(index) + "]";
+}
+
+// Structural equality of two hashed subtrees; values are compared the way they are hashed
+bool sameSubtree(const YamlHashTree::Node &a, const YamlHashTree::Node &b) {
+  if (a.hash != b.hash || a.type != b.type || a.children.size() != b.children.size())
+    return false;
+  if (a.map) {
+    auto left  = a.map->begin();
+    auto right = b.map->begin();
+    for (size_t i = 0; i < a.children.size(); ++i, ++left, ++right) {
+      if (left->first != right->first || !sameSubtree(a.children[i], b.children[i]))
+        return false;
+    }
+    return true;
+  }
+  if (a.seq) {
+    for (size_t i = 0; i < a.children.size(); ++i) {
+      if (!sameSubtree(a.children[i], b.children[i]))
+        return false;
+    }
+    return true;
+  }
+  if (!a.element || !b.element)
+    return a.element == b.element;
+  const YamlElement::Data &x = a.element->data;
+  const YamlElement::Data &y = b.element->data;
+  switch (a.type) {
+  case YamlElement::ElementType::STRING:
+    return x.str == y.str;
+  case YamlElement::ElementType::DOUBLE:
+    return std::memcmp(&x.d, &y.d, sizeof(x.d)) == 0;
+  case YamlElement::ElementType::INT:
+    return x.i == y.i;
+  case YamlElement::ElementType::BOOL:
+    return x.b == y.b;
+  default:
+    return true;
+  }
+}
+
+bool largerSubtree(const YamlSubtreeUsage &a, const YamlSubtreeUsage &b) {
+  return a.bytes != b.bytes ? a.bytes > b.bytes : a.path < b.path;
+}
+
+class UsageWalker {
+public:
+  UsageWalker(YamlMemoryUsage &usage, size_t largestCount) : m_usage(usage), m_largestCount(largestCount) {}
+
+  // Returns the heap bytes of the subtree at 'node'
+  size_t walk(const YamlHashTree::Node &node, const std::string &path, bool insideDuplicate) {
+    bool isElement = node.element != nullptr;
+    bool duplicate = false;
+    if (!insideDuplicate && ((node.map && !node.map->empty()) || (node.seq && !node.seq->empty())))
+      duplicate = seenBefore(node);
+
+    size_t bytes = 0;
+    if (node.map) {
+      if (isElement) {
+        bytes += sizeof(YamlMap);
+        m_usage.containerBytes += sizeof(YamlMap);
+      }
+      size_t i = 0;
+      for (const auto &entry : *node.map) {
+        size_t key = heapBytes(entry.first);
+        m_usage.mapNodeBytes += MAP_NODE_BYTES;
+        m_usage.stringBytes += key;
+        bytes += MAP_NODE_BYTES + key;
+        bytes += walk(node.children[i++], track() ? keyPath(path, entry.first) : std::string(),
+                      insideDuplicate || duplicate);
+      }
+    } else if (node.seq) {
+      if (isElement) {
+        bytes += sizeof(YamlSeq);
+        m_usage.containerBytes += sizeof(YamlSeq);
+      }
+      size_t used  = node.seq->size() * sizeof(YamlItem);
+      size_t slack = (node.seq->capacity() - node.seq->size()) * sizeof(YamlItem);
+      m_usage.sequenceBytes += used;
+      m_usage.sequenceSlackBytes += slack;
+      bytes += used + slack;
+      for (size_t i = 0; i < node.children.size(); ++i)
+        bytes += walk(node.children[i], track() ? indexPath(path, i) : std::string(), insideDuplicate || duplicate);
+    } else if (isElement && node.type == YamlElement::ElementType::STRING) {
+      bytes = heapBytes(node.element->data.str);
+      m_usage.stringBytes += bytes;
+    }
+
+    if (duplicate)
+      m_usage.duplicateBytes += bytes;
+    if (isElement) {
+      m_usage.nodes++;
+      record(path, bytes);
+    }
+    return bytes;
+  }
+
+  void finish() {
+    std::sort(m_usage.largest.begin(), m_usage.largest.end(), largerSubtree);
+  }
+
+private:
+  bool track() const {
+    return m_largestCount > 0;
+  }
+
+  // Records the collection and reports whether an equal one was seen before
+  bool seenBefore(const YamlHashTree::Node &node) {
+    Candidates &candidates = m_seen[node.hash];
+    for (const YamlHashTree::Node *candidate : candidates) {
+      if (sameSubtree(*candidate, node))
+        return true;
+    }
+    candidates.push_back(&node);
+    return false;
+  }
+
+  void record(const std::string &path, size_t bytes) {
+    if (!track() || bytes == 0)
+      return;
+    std::vector<YamlSubtreeUsage> &heap = m_usage.largest;
+    YamlSubtreeUsage               item{path, bytes};
+    if (heap.size() < m_largestCount) {
+      heap.push_back(item);
+      std::push_heap(heap.begin(), heap.end(), largerSubtree);
+    } else if (largerSubtree(item, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), largerSubtree);
+      heap.back() = item;
+      std::push_heap(heap.begin(), heap.end(), largerSubtree);
+    }
+  }
+
+  using Candidates = std::vector<const YamlHashTree::Node *>;
+
+  YamlMemoryUsage                              &m_usage;
+  size_t                                        m_largestCount;
+  std::unordered_map<std::uint64_t, Candidates> m_seen;
+};
+
+YamlMemoryUsage measure(const YamlHashTree &tree, size_t largestCount) {
+  YamlMemoryUsage usage;
+  UsageWalker     walker(usage, largestCount);
+  walker.walk(tree.root(), std::string(), false);
+  walker.finish();
+  return usage;
+}
+} // anonymous namespace
+
+/**
+ * @brief Get the sum of all categories
+ * @return Heap bytes of the tree (duplicateBytes is part of it, not added)
+ */
+size_t YamlMemoryUsage::totalBytes() const {
+  return containerBytes + mapNodeBytes + sequenceBytes + sequenceSlackBytes + stringBytes;
+}
+
+/**
+ * @brief Formats the usage as a multi-line report
+ * @return One "category: bytes" line per category, followed by the largest subtrees
+ */
+std::string YamlMemoryUsage::toString() const {
+  char        line[160];
+  std::string out;
+  std::snprintf(line, sizeof(line), "total: %zu bytes in %zu nodes\n", totalBytes(), nodes);
+  out += line;
+  std::snprintf(line, sizeof(line), "containers: %zu\nmap nodes: %zu\nsequences: %zu\nsequence slack: %zu\n",
+                containerBytes, mapNodeBytes, sequenceBytes, sequenceSlackBytes);
+  out += line;
+  std::snprintf(line, sizeof(line), "strings: %zu\nduplicated subtrees: %zu\n", stringBytes, duplicateBytes);
+  out += line;
+  for (const auto &subtree : largest) {
+    std::snprintf(line, sizeof(line), "  %zu  ", subtree.bytes);
+    out += line + (subtree.path.empty() ? std::string("(root)") : subtree.path) + "\n";
+  }
+  return out;
+}
+
+/**
+ * @brief Measures the heap usage of a mapping
+ * @param map Mapping to measure; its own object is not counted, only what it owns
+ * @param largestCount Number of largest subtrees to list (0 skips the list)
+ * @return Usage breakdown
+ */
+YamlMemoryUsage memoryUsage(const YamlMap &map, size_t largestCount) {
+  return measure(YamlHashTree(map), largestCount);
+}
+
+/**
+ * @brief Measures the heap usage of a sequence
+ * @param seq Sequence to measure; its own object is not counted, only what it owns
+ * @param largestCount Number of largest subtrees to list (0 skips the list)
+ * @return Usage breakdown
+ */
+YamlMemoryUsage memoryUsage(const YamlSeq &seq, size_t largestCount) {
+  return measure(YamlHashTree(seq), largestCount);
+}
+
+/**
+ * @brief Measures the heap usage of an element
+ * @param element Element to measure, including the collection it owns
+ * @param largestCount Number of largest subtrees to list (0 skips the list); the element itself has an empty path
+ * @return Usage breakdown
+ */
+YamlMemoryUsage memoryUsage(const YamlElement &element, size_t largestCount) {
+  return measure(YamlHashTree(element), largestCount);
+}
+
+} // namespace yamlparser
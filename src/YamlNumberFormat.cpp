@@ -0,0 +1,165 @@
+#include "YamlNumberFormat.hpp"
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// YamlNumberFormat implementation - shortest round-trip number formatting
+// Key features:
+// - Integers: two digits per step from a lookup table, no iostreams
+// - Integral doubles below 1e15: written via the integer path plus ".0"
+// - Other doubles: the first of %.15g/%.16g/%.17g that round-trips exactly is
+//   the shortest one (15 digits are always enough to separate decimals with
+//   fewer digits; subnormals, which have less precision, try 1..17 digits)
+// - The locale's decimal separator is replaced by '.'
+
+namespace yamlparser {
+
+namespace {
+const char DIGIT_PAIRS[] = "00010203040506070809"
+                           "10111213141516171819"
+                           "20212223242526272829"
+                           "30313233343536373839"
+                           "40414243444546474849"
+                           "50515253545556575859"
+                           "60616263646566676869"
+                           "70717273747576777879"
+                           "80818283848586878889"
+                           "90919293949596979899";
+
+// Writes the decimal digits of u, right-aligned so that they end at 'end'
+char *writeDigitsBackwards(unsigned long long u, char *end) {
+  while (u >= 100) {
+    size_t pair = static_cast<size_t>(u % 100) * 2;
+    u /= 100;
+    *--end = DIGIT_PAIRS[pair + 1];
+    *--end = DIGIT_PAIRS[pair];
+  }
+  if (u >= 10) {
+    size_t pair = static_cast<size_t>(u) * 2;
+    *--end      = DIGIT_PAIRS[pair + 1];
+    *--end      = DIGIT_PAIRS[pair];
+  } else {
+    *--end = static_cast<char>('0' + u);
+  }
+  return end;
+}
+
+size_t formatSigned(long long value, char *buf) {
+  char               tmp[24];
+  char              *end = tmp + sizeof(tmp);
+  unsigned long long u   = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                     : static_cast<unsigned long long>(value);
+  char *p = writeDigitsBackwards(u, end);
+  if (value < 0)
+    *--p = '-';
+  size_t len = static_cast<size_t>(end - p);
+  std::memcpy(buf, p, len);
+  return len;
+}
+
+size_t copyLiteral(const char *text, char *buf) {
+  size_t len = std::strlen(text);
+  std::memcpy(buf, text, len);
+  return len;
+}
+
+// Formats with the given precision and reports whether the text parses back to value
+bool tryPrecision(double value, int precision, char *tmp, size_t tmpSize, int &len) {
+  len = std::snprintf(tmp, tmpSize, "%.*g", precision, value);
+  return len > 0 && std::strtod(tmp, nullptr) == value;
+}
+} // anonymous namespace
+
+const size_t YamlNumberFormat::BUFFER_SIZE;
+
+/**
+ * @brief Formats an integer in decimal
+ * @param value The integer to format
+ * @param buf Destination with room for at least BUFFER_SIZE characters
+ * @return Number of characters written (no terminating NUL)
+ */
+size_t YamlNumberFormat::formatInt(int value, char *buf) {
+  return formatSigned(value, buf);
+}
+
+/**
+ * @brief Formats a double with the shortest text that round-trips exactly
+ * @param value The double to format
+ * @param buf Destination with room for at least BUFFER_SIZE characters
+ * @return Number of characters written (no terminating NUL)
+ */
+size_t YamlNumberFormat::formatDouble(double value, char *buf) {
+  if (std::isnan(value))
+    return copyLiteral(".nan", buf);
+  if (std::isinf(value))
+    return copyLiteral(value > 0 ? ".inf" : "-.inf", buf);
+  if (value == 0.0)
+    return copyLiteral(std::signbit(value) ? "-0.0" : "0.0", buf);
+
+  // Fast path: integral values in the range %g prints without an exponent
+  if (std::fabs(value) < 1e15 && std::floor(value) == value) {
+    size_t len = formatSigned(static_cast<long long>(value), buf);
+    buf[len++] = '.';
+    buf[len++] = '0';
+    return len;
+  }
+
+  char tmp[48];
+  int  len = 0;
+  if (std::fabs(value) < DBL_MIN) {
+    // Subnormals have fewer significant bits; search from one digit upwards
+    for (int precision = 1; precision <= 17; ++precision) {
+      if (tryPrecision(value, precision, tmp, sizeof(tmp), len))
+        break;
+    }
+  } else if (!tryPrecision(value, 15, tmp, sizeof(tmp), len) && !tryPrecision(value, 16, tmp, sizeof(tmp), len)) {
+    tryPrecision(value, 17, tmp, sizeof(tmp), len); // 17 digits always round-trip
+  }
+
+  // Copy, replacing the locale's decimal separator (possibly multi-byte) with '.'
+  size_t out         = 0;
+  bool   hasFraction = false;
+  bool   inSeparator = false;
+  for (int i = 0; i < len; ++i) {
+    char c       = tmp[i];
+    bool isDigit = c >= '0' && c <= '9';
+    if (isDigit || c == '-' || c == '+' || c == 'e') {
+      buf[out++]  = c;
+      inSeparator = false;
+      hasFraction = hasFraction || c == 'e';
+    } else if (!inSeparator) {
+      buf[out++]  = '.';
+      inSeparator = true;
+      hasFraction = true;
+    }
+  }
+  if (!hasFraction) {
+    buf[out++] = '.';
+    buf[out++] = '0';
+  }
+  return out;
+}
+
+/**
+ * @brief Formats an integer into a new string
+ * @param value The integer to format
+ * @return Decimal text of value
+ */
+std::string YamlNumberFormat::toString(int value) {
+  char buf[BUFFER_SIZE];
+  return std::string(buf, formatInt(value, buf));
+}
+
+/**
+ * @brief Formats a double into a new string
+ * @param value The double to format
+ * @return Shortest round-trip text of value
+ */
+std::string YamlNumberFormat::toString(double value) {
+  char buf[BUFFER_SIZE];
+  return std::string(buf, formatDouble(value, buf));
+}
+
+} // namespace yamlparser
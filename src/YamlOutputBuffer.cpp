@@ -0,0 +1,222 @@
+#include "YamlOutputBuffer.hpp"
+#include "YamlException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// YamlOutputBuffer implementation - append-only buffer used by the serializers
+// Key features:
+// - Amortized O(1) appends with geometric growth in growable mode
+// - Chunked std::ostream::write() calls in stream mode (no per-line flushes);
+//   the chunk grows from a small initial block, so short outputs stay cheap
+// - Owned storage is allocated without zero-filling it
+// - Bounds-checked writes into caller-supplied storage in fixed mode
+// - Indentation copied from a static block of spaces
+
+namespace yamlparser {
+
+namespace {
+const size_t INITIAL_CAPACITY = 4096;
+const size_t SPACES_SIZE      = 128;
+} // anonymous namespace
+
+const size_t YamlOutputBuffer::DEFAULT_CHUNK_SIZE;
+
+/**
+ * @brief Creates a growable in-memory buffer
+ */
+YamlOutputBuffer::YamlOutputBuffer() : m_mode(Mode::GROWABLE), m_limit(std::numeric_limits<size_t>::max()) {
+  grow(INITIAL_CAPACITY, m_limit);
+}
+
+/**
+ * @brief Creates a buffer that writes to a stream in chunks
+ * @param os Destination stream
+ * @param chunkSize Number of bytes collected before each write to the stream
+ */
+YamlOutputBuffer::YamlOutputBuffer(std::ostream &os, size_t chunkSize)
+    : m_mode(Mode::STREAM), m_limit(chunkSize == 0 ? 1 : chunkSize), m_stream(&os) {
+  grow(std::min(INITIAL_CAPACITY, m_limit), m_limit);
+}
+
+/**
+ * @brief Creates a buffer over caller-supplied storage
+ * @param buffer Storage to write into (must outlive this object)
+ * @param capacity Size of the storage in bytes
+ * @details Writing more than capacity bytes throws OutputException.
+ *          No terminating NUL is written; use size() to find the end.
+ */
+YamlOutputBuffer::YamlOutputBuffer(char *buffer, size_t capacity)
+    : m_mode(Mode::FIXED), m_data(buffer), m_capacity(capacity) {}
+
+/**
+ * @brief Destructor - writes any remaining bytes to the stream in stream mode
+ * @details Errors are swallowed here; call flush() explicitly to observe them.
+ */
+YamlOutputBuffer::~YamlOutputBuffer() {
+  try {
+    flush();
+  } catch (...) {
+    // Destructors must not throw
+  }
+}
+
+/**
+ * @brief Ensures that at least needed bytes can be appended
+ * @param needed Number of bytes about to be appended
+ * @throws OutputException if a fixed buffer is too small or the stream fails
+ */
+void YamlOutputBuffer::makeRoom(size_t needed) {
+  if (m_capacity - m_size >= needed)
+    return;
+  switch (m_mode) {
+  case Mode::GROWABLE:
+    grow(needed, m_limit);
+    break;
+  case Mode::STREAM:
+    if (m_capacity < m_limit) {
+      grow(needed, m_limit);
+    }
+    if (m_capacity - m_size < needed) {
+      flush();
+    }
+    break;
+  case Mode::FIXED:
+  default:
+    throw OutputException("fixed output buffer of " + std::to_string(m_capacity) + " bytes is full");
+  }
+}
+
+/**
+ * @brief Moves the owned storage to a larger allocation
+ * @param needed Number of bytes about to be appended
+ * @param limit Largest capacity to allocate
+ * @details Capacity doubles until needed bytes fit, capped at limit. The new
+ *          storage is not zero-filled; only the buffered bytes are copied.
+ */
+void YamlOutputBuffer::grow(size_t needed, size_t limit) {
+  size_t newCapacity = std::min(std::max(m_capacity * 2, INITIAL_CAPACITY), limit);
+  while (newCapacity - m_size < needed && newCapacity < limit) {
+    newCapacity = newCapacity > limit / 2 ? limit : newCapacity * 2;
+  }
+  std::unique_ptr<char[]> storage(new char[newCapacity]);
+  if (m_size > 0) {
+    std::memcpy(storage.get(), m_data, m_size);
+  }
+  m_storage  = std::move(storage);
+  m_data     = m_storage.get();
+  m_capacity = newCapacity;
+}
+
+/**
+ * @brief Appends raw bytes
+ * @param data Bytes to append
+ * @param size Number of bytes
+ * @details In stream mode, blocks larger than the chunk size bypass the buffer.
+ */
+void YamlOutputBuffer::append(const char *data, size_t size) {
+  if (size == 0)
+    return;
+  if (m_capacity - m_size < size) {
+    makeRoom(size);
+    if (m_mode == Mode::STREAM && m_capacity - m_size < size) {
+      m_stream->write(data, static_cast<std::streamsize>(size));
+      if (!*m_stream) {
+        throw OutputException("failed to write to output stream");
+      }
+      return;
+    }
+  }
+  std::memcpy(m_data + m_size, data, size);
+  m_size += size;
+}
+
+/**
+ * @brief Appends a string
+ * @param s String to append
+ */
+void YamlOutputBuffer::append(const std::string &s) {
+  append(s.data(), s.size());
+}
+
+/**
+ * @brief Appends a single character
+ * @param c Character to append
+ */
+void YamlOutputBuffer::append(char c) {
+  if (m_size == m_capacity) {
+    makeRoom(1);
+  }
+  m_data[m_size++] = c;
+}
+
+/**
+ * @brief Appends n spaces of indentation
+ * @param n Number of spaces (values <= 0 append nothing)
+ */
+void YamlOutputBuffer::appendIndent(int n) {
+  static const std::string spaces(SPACES_SIZE, ' ');
+  size_t                   remaining = n > 0 ? static_cast<size_t>(n) : 0;
+  while (remaining > 0) {
+    size_t count = remaining < SPACES_SIZE ? remaining : SPACES_SIZE;
+    append(spaces.data(), count);
+    remaining -= count;
+  }
+}
+
+/**
+ * @brief Writes buffered bytes to the stream (stream mode only)
+ * @throws OutputException if the stream reports an error
+ * @details Does not call std::ostream::flush(); in other modes this is a no-op.
+ */
+void YamlOutputBuffer::flush() {
+  if (m_mode != Mode::STREAM || m_size == 0)
+    return;
+  m_stream->write(m_data, static_cast<std::streamsize>(m_size));
+  m_size = 0;
+  if (!*m_stream) {
+    throw OutputException("failed to write to output stream");
+  }
+}
+
+/**
+ * @brief Get the buffered bytes
+ * @return Pointer to the first buffered byte (not NUL-terminated)
+ * @details In stream mode only the bytes not yet written to the stream are visible.
+ */
+const char *YamlOutputBuffer::data() const {
+  return m_data;
+}
+
+/**
+ * @brief Get the number of buffered bytes
+ * @return Number of bytes currently held in the buffer
+ */
+size_t YamlOutputBuffer::size() const {
+  return m_size;
+}
+
+/**
+ * @brief Get the number of bytes that fit before the buffer grows or writes
+ * @return Capacity of the active storage
+ */
+size_t YamlOutputBuffer::capacity() const {
+  return m_capacity;
+}
+
+/**
+ * @brief Copy the buffered bytes into a string
+ * @return String holding the buffered bytes
+ */
+std::string YamlOutputBuffer::str() const {
+  return std::string(m_data, m_size);
+}
+
+/**
+ * @brief Discards all buffered bytes without writing them
+ */
+void YamlOutputBuffer::clear() {
+  m_size = 0;
+}
+
+} // namespace yamlparser
@@ -0,0 +1,267 @@
+#include "YamlParseCache.hpp"
+#include "YamlAtomicFile.hpp"
+#include "YamlException.hpp"
+#include "YamlSnapshot.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <direct.h>
+#endif
+
+// YamlParseCache implementation - content-addressed cache of snapshot images
+// Key features:
+// - Entry names combine a format version and the SHA-256 digest of the
+//   document text, so entries never need invalidation and a colliding
+//   document cannot be crafted to receive another document's tree
+// - A miss parses the text that was hashed (not a second read of the file),
+//   so a file replaced mid-way can never be cached under the wrong key
+// - Entries are published with replaceFileAtomically() (write-to-temp + rename)
+
+namespace yamlparser {
+
+namespace {
+// Bump when parsing rules change so that entries from older builds are ignored
+const char CACHE_FORMAT[] = "v7";
+
+const std::uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+std::uint32_t rotr(std::uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+void sha256Block(std::uint32_t state[8], const unsigned char *block) {
+  std::uint32_t w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = static_cast<std::uint32_t>(block[4 * i]) << 24 | static_cast<std::uint32_t>(block[4 * i + 1]) << 16 |
+           static_cast<std::uint32_t>(block[4 * i + 2]) << 8 | static_cast<std::uint32_t>(block[4 * i + 3]);
+  }
+  for (int i = 16; i < 64; ++i) {
+    std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i]             = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; ++i) {
+    std::uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+    std::uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    h                = g;
+    g                = f;
+    f                = e;
+    e                = d + t1;
+    d                = c;
+    c                = b;
+    b                = a;
+    a                = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// SHA-256 of the document text as 64 lowercase hex digits
+std::string hashContent(const std::string &content) {
+  std::uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  const unsigned char *data = reinterpret_cast<const unsigned char *>(content.data());
+  size_t               full = content.size() / 64 * 64;
+  for (size_t i = 0; i < full; i += 64)
+    sha256Block(state, data + i);
+
+  // Final block(s): remaining bytes, 0x80, zero padding, bit length big-endian
+  unsigned char tail[128] = {};
+  size_t        rest      = content.size() - full;
+  std::memcpy(tail, data + full, rest);
+  tail[rest]           = 0x80;
+  size_t        blocks = rest < 56 ? 1 : 2;
+  std::uint64_t bits   = static_cast<std::uint64_t>(content.size()) * 8;
+  for (int i = 0; i < 8; ++i)
+    tail[blocks * 64 - 1 - static_cast<size_t>(i)] = static_cast<unsigned char>(bits >> (8 * i));
+  for (size_t i = 0; i < blocks; ++i)
+    sha256Block(state, tail + 64 * i);
+
+  static const char digits[] = "0123456789abcdef";
+  std::string       hex(64, '0');
+  for (size_t i = 0; i < 32; ++i) {
+    unsigned byte  = (state[i / 4] >> (24 - 8 * (i % 4))) & 0xffu;
+    hex[2 * i]     = digits[byte >> 4];
+    hex[2 * i + 1] = digits[byte & 0xfu];
+  }
+  return hex;
+}
+
+std::string readFile(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw FileException(filename);
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+} // anonymous namespace
+
+/**
+ * @brief Creates a cache backed by a directory
+ * @param directory Directory for cache entries (created if missing)
+ * @throws OutputException if the directory does not exist and cannot be created
+ */
+YamlParseCache::YamlParseCache(const std::string &directory) : m_directory(directory) {
+#if defined(_WIN32)
+  int created = _mkdir(directory.c_str());
+#else
+  int created = ::mkdir(directory.c_str(), 0755);
+#endif
+  if (created != 0) {
+    struct stat st;
+    if (::stat(directory.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFDIR)
+      throw OutputException("cannot create cache directory: " + directory);
+  }
+}
+
+/**
+ * @brief Parses a YAML file, reusing a cached result when the content is unchanged
+ * @param parser Parser that receives the document
+ * @param filename Path to the YAML file
+ * @throws FileException if the file cannot be opened or read
+ * @throws SyntaxException if the file has to be parsed and its syntax is invalid
+ * @throws LimitException if the file exceeds the parser's limits (see YamlParseLimits.hpp)
+ * @details Failure to write a new entry is not an error: the parse result is
+ *          still delivered and the next call simply misses again.
+ *          A cache hit is only checked against ParseLimits::maxInputBytes.
+ *          Entries are written after a successful parse, so a cache shared by
+ *          parsers with the same limits only holds documents within them.
+ */
+void YamlParseCache::parse(YamlParser &parser, const std::string &filename) {
+  std::string content = readFile(filename);
+  parser.checkInputBytes(content.size());
+  std::string path = entryPath(content);
+  if (load(parser, path)) {
+    ++m_hits;
+    return;
+  }
+  ++m_misses;
+  parser.parseString(content);
+  try {
+    store(parser, path);
+  } catch (const OutputException &) {
+    // The cache is an optimization; a read-only or full disk must not fail the parse
+  }
+}
+
+/**
+ * @brief Makes sure a valid cache entry exists for a file and returns its path
+ * @param filename Path to the YAML file
+ * @return Path of the snapshot image, suitable for YamlSnapshotView
+ * @throws FileException if the file cannot be opened or read
+ * @throws SyntaxException if the file has to be parsed and its syntax is invalid
+ * @throws OutputException if a new entry cannot be written
+ */
+std::string YamlParseCache::ensure(const std::string &filename) {
+  std::string content = readFile(filename);
+  std::string path    = entryPath(content);
+  try {
+    YamlSnapshotView probe(path);
+    ++m_hits;
+    return path;
+  } catch (const YamlException &) {
+    // Missing or invalid entry: rebuild it below
+  }
+  ++m_misses;
+  YamlParser parser;
+  parser.parseString(content);
+  store(parser, path);
+  return path;
+}
+
+/**
+ * @brief Get the cache entry path for a document
+ * @param content The document text
+ * @return Path of the entry inside the cache directory
+ */
+std::string YamlParseCache::entryPath(const std::string &content) const {
+  return m_directory + "/" + CACHE_FORMAT + "-" + hashContent(content) + ".snap";
+}
+
+/**
+ * @brief Get the cache directory
+ * @return Directory passed to the constructor
+ */
+const std::string &YamlParseCache::directory() const {
+  return m_directory;
+}
+
+/**
+ * @brief Get the number of documents served from the cache
+ * @return Hit count since construction
+ */
+size_t YamlParseCache::hits() const {
+  return m_hits;
+}
+
+/**
+ * @brief Get the number of documents that had to be parsed
+ * @return Miss count since construction
+ */
+size_t YamlParseCache::misses() const {
+  return m_misses;
+}
+
+/**
+ * @brief Loads a cache entry into a parser
+ * @param parser Parser that receives the document
+ * @param path Path of the entry
+ * @return true if the entry existed, was valid and has been loaded
+ */
+bool YamlParseCache::load(YamlParser &parser, const std::string &path) const {
+  YamlItem item;
+  try {
+    YamlSnapshotView view(path);
+    item = view.root().toItem();
+  } catch (const YamlException &) {
+    return false;
+  }
+  if (item.value.isSeq()) {
+    parser.m_sequenceRoot = true;
+    parser.m_sequenceData = std::move(*item.value.data.seq);
+    parser.m_data.clear();
+  } else if (item.value.isMap()) {
+    parser.m_sequenceRoot = false;
+    parser.m_data         = std::move(*item.value.data.map);
+    parser.m_sequenceData.clear();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Writes the parser's document as a cache entry
+ * @param parser Parser holding the document
+ * @param path Path of the entry
+ * @throws OutputException if the entry cannot be written
+ */
+void YamlParseCache::store(const YamlParser &parser, const std::string &path) const {
+  std::string image = parser.isSequenceRoot() ? YamlSnapshot::build(parser.sequenceRoot())
+                                              : YamlSnapshot::build(parser.root());
+  replaceFileAtomically(image, path, "cache entry");
+}
+
+} // namespace yamlparser
@@ -0,0 +1,32 @@
+#include "YamlParseLimits.hpp"
+
+// YamlParseLimits implementation - presets for parse limits
+
+namespace yamlparser {
+
+/**
+ * @brief Get limits suited to documents from untrusted sources
+ * @return 16 MiB of input, depth 64, one million nodes, 1 MiB scalars and
+ *         10000 nodes copied by aliases and merge keys
+ * @details Generous for configuration files, while keeping the memory and
+ *          time of a hostile document to a small multiple of its size.
+ */
+ParseLimits ParseLimits::untrusted() {
+  ParseLimits limits;
+  limits.maxInputBytes  = 16 * 1024 * 1024;
+  limits.maxDepth       = 64;
+  limits.maxNodes       = 1000000;
+  limits.maxScalarBytes = 1024 * 1024;
+  limits.maxAliasNodes  = 10000;
+  return limits;
+}
+
+/**
+ * @brief Check if no limit is set
+ * @return true if every limit is 0
+ */
+bool ParseLimits::unlimited() const {
+  return maxInputBytes == 0 && maxDepth == 0 && maxNodes == 0 && maxScalarBytes == 0 && maxAliasNodes == 0;
+}
+
+} // namespace yamlparser
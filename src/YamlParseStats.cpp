@@ -0,0 +1,72 @@
+#include "YamlParseStats.hpp"
+#include <cstdio>
+
+// YamlParseStats implementation - accessors and a human-readable report
+
+namespace yamlparser {
+
+namespace {
+const char *const TYPE_NAMES[ParseStats::TYPE_COUNT] = {"null", "string", "double", "int", "bool", "seq", "map"};
+} // anonymous namespace
+
+/**
+ * @brief Get the number of nodes of one type
+ * @param type Element type
+ * @return Node count
+ */
+size_t ParseStats::nodeCount(YamlElement::ElementType type) const {
+  return nodes[static_cast<size_t>(type)];
+}
+
+/**
+ * @brief Get the number of nodes of all types
+ * @return Node count
+ */
+size_t ParseStats::totalNodes() const {
+  size_t total = 0;
+  for (size_t count : nodes)
+    total += count;
+  return total;
+}
+
+/**
+ * @brief Get the wall time of all phases
+ * @return Seconds
+ */
+double ParseStats::totalSeconds() const {
+  return readSeconds + scanSeconds + buildSeconds + scalarSeconds;
+}
+
+/**
+ * @brief Clears all counters and timings
+ */
+void ParseStats::reset() {
+  *this = ParseStats();
+}
+
+/**
+ * @brief Formats the statistics as a multi-line report
+ * @return Report text, one "name: value" line per item
+ */
+std::string ParseStats::toString() const {
+  char        line[128];
+  std::string out;
+  std::snprintf(line, sizeof(line), "lines: %zu\nnodes: %zu (", lines, totalNodes());
+  out += line;
+  for (size_t i = 0; i < TYPE_COUNT; ++i) {
+    std::snprintf(line, sizeof(line), "%s%s %zu", i ? ", " : "", TYPE_NAMES[i], nodes[i]);
+    out += line;
+  }
+  std::snprintf(line, sizeof(line), ")\nanchors: %zu\naliases: %zu\nmerge keys: %zu\nmax depth: %zu\n", anchors,
+                aliases, mergeKeys, maxDepth);
+  out += line;
+  std::snprintf(line, sizeof(line), "scalar bytes: %zu\nallocations: %zu (%zu bytes, peak %zu)\n", scalarBytes,
+                allocations, allocatedBytes, peakAllocatedBytes);
+  out += line;
+  std::snprintf(line, sizeof(line), "time: %.3f ms (read %.3f, scan %.3f, build %.3f, scalar %.3f)\n",
+                totalSeconds() * 1e3, readSeconds * 1e3, scanSeconds * 1e3, buildSeconds * 1e3, scalarSeconds * 1e3);
+  out += line;
+  return out;
+}
+
+} // namespace yamlparser
@@ -1,17 +1,153 @@
 ﻿#include "YamlParser.hpp"
 #include "YamlException.hpp"
+#include "YamlBlockScalar.hpp"
+#include "YamlFlowParser.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iostream>
-#include <regex>
 #include <set>
 #include "YamlPrinter.hpp"
+#include "YamlInput.hpp"
+#include "YamlMemory.hpp"
+#include "YamlScanner.hpp"
+#include "YamlTrace.hpp"
 
 #include "YamlHelperFunctions.hpp"
 
 namespace yamlparser {
 
+namespace {
+// Adds the wall time of its scope to one ParseStats field; does nothing without stats
+class PhaseTimer {
+public:
+  PhaseTimer(ParseStats *stats, double ParseStats::*field) : m_stats(stats), m_field(field) {
+    if (m_stats)
+      m_start = std::chrono::steady_clock::now();
+  }
+
+  ~PhaseTimer() {
+    if (m_stats)
+      m_stats->*m_field += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+  }
+
+  PhaseTimer(const PhaseTimer &)            = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+  ParseStats                           *m_stats;
+  double ParseStats::                  *m_field;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+// Counts one level of parseMap()/parseSeq() nesting for the duration of a call
+class DepthGuard {
+public:
+  explicit DepthGuard(size_t &depth) : m_depth(depth) {
+    ++m_depth;
+  }
+
+  ~DepthGuard() {
+    --m_depth;
+  }
+
+  DepthGuard(const DepthGuard &)            = delete;
+  DepthGuard &operator=(const DepthGuard &) = delete;
+
+private:
+  size_t &m_depth;
+};
+
+void tallyMap(const YamlMap &map, size_t depth, ParseStats &stats);
+void tallySeq(const YamlSeq &seq, size_t depth, ParseStats &stats);
+
+void tallyItem(const YamlItem &item, size_t depth, ParseStats &stats) {
+  stats.nodes[static_cast<size_t>(item.value.type)]++;
+  if (depth > stats.maxDepth)
+    stats.maxDepth = depth;
+  if (item.value.isMap())
+    tallyMap(item.value.asMap(), depth, stats);
+  else if (item.value.isSeq())
+    tallySeq(item.value.asSeq(), depth, stats);
+}
+
+// Counts the children of a collection at 'depth'; the collection itself is counted by the caller
+void tallyMap(const YamlMap &map, size_t depth, ParseStats &stats) {
+  for (const auto &entry : map)
+    tallyItem(entry.second, depth + 1, stats);
+}
+
+void tallySeq(const YamlSeq &seq, size_t depth, ParseStats &stats) {
+  for (const auto &item : seq)
+    tallyItem(item, depth + 1, stats);
+}
+
+// Counts the nodes of a subtree into 'nodes', stopping once it exceeds 'budget'; returns the height (0 for a scalar)
+size_t measureSubtree(const YamlItem &item, size_t budget, size_t &nodes) {
+  if (++nodes > budget)
+    return 0;
+  size_t height = 0;
+  if (item.value.isMap()) {
+    for (const auto &entry : item.value.asMap()) {
+      height = std::max(height, measureSubtree(entry.second, budget, nodes) + 1);
+      if (nodes > budget)
+        break;
+    }
+  } else if (item.value.isSeq()) {
+    for (const auto &child : item.value.asSeq()) {
+      height = std::max(height, measureSubtree(child, budget, nodes) + 1);
+      if (nodes > budget)
+        break;
+    }
+  }
+  return height;
+}
+
+inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Advances past digits; returns how many there were
+size_t skipDigits(const std::string &s, size_t &pos) {
+  size_t begin = pos;
+  while (pos < s.size() && isDigit(s[pos]))
+    pos++;
+  return pos - begin;
+}
+
+size_t skipSign(const std::string &s) {
+  return !s.empty() && (s[0] == '+' || s[0] == '-') ? 1 : 0;
+}
+
+// [+-]?\d+
+bool isIntegerText(const std::string &s) {
+  size_t pos = skipSign(s);
+  return skipDigits(s, pos) > 0 && pos == s.size();
+}
+
+// [+-]?(\d+\.\d*|\.\d+|\d+)([eE][+-]?\d+)?
+bool isDoubleText(const std::string &s) {
+  size_t pos      = skipSign(s);
+  size_t mantissa = skipDigits(s, pos);
+  if (pos < s.size() && s[pos] == '.') {
+    pos++;
+    mantissa += skipDigits(s, pos);
+  }
+  if (mantissa == 0)
+    return false;
+  if (pos < s.size() && (s[pos] == 'e' || s[pos] == 'E')) {
+    pos++;
+    if (pos < s.size() && (s[pos] == '+' || s[pos] == '-'))
+      pos++;
+    if (skipDigits(s, pos) == 0)
+      return false;
+  }
+  return pos == s.size();
+}
+} // anonymous namespace
+
 /**
  * @brief Get the root mapping
  * @return Reference to the root mapping
@@ -38,197 +174,418 @@ bool YamlParser::isSequenceRoot() const {
   return m_sequenceRoot;
 }
 
+/**
+ * @brief Constructs a parser that enforces resource limits
+ * @param limits Limits applied to every parse; see ParseLimits
+ */
+YamlParser::YamlParser(const ParseLimits &limits) : m_limits(limits) {}
+
+/**
+ * @brief Replaces the resource limits
+ * @param limits Limits applied to subsequent parses; a default ParseLimits removes all limits
+ */
+void YamlParser::setLimits(const ParseLimits &limits) {
+  m_limits = limits;
+}
+
+/**
+ * @brief Get the resource limits
+ * @return Limits applied to every parse
+ */
+const ParseLimits &YamlParser::limits() const {
+  return m_limits;
+}
+
+/**
+ * @brief Sets the handler called between top-level entries
+ * @param handler Receives the bytes parsed so far; may throw to stop the parse. An empty handler removes it.
+ * @details The handler runs on the thread of the parse, before each entry of
+ *          the root mapping or item of the root sequence, and once more with
+ *          bytesConsumed equal to totalBytes when the tree is complete. An
+ *          exception thrown before an entry leaves the parser as any failed
+ *          parse does.
+ */
+void YamlParser::setProgressHandler(YamlProgressHandler handler) {
+  m_progress = std::move(handler);
+}
+
 /**
  * @brief Parses a YAML file and loads its contents into the parser
  * @param filename Path to the YAML file to parse
  * @throws FileException if file cannot be opened or read
  * @throws SyntaxException if YAML syntax is invalid
- * @details This function:
- *          1. Opens and reads the specified YAML file
- *          2. Detects if the root element is a sequence or mapping
- *          3. For sequence root: stores in m_sequenceData and sets m_sequenceRoot flag
- *          4. For mapping root: stores in m_data and clears m_sequenceRoot flag
- *          5. Handles empty files gracefully
+ * @throws LimitException if a limit set with the constructor or setLimits() is exceeded
+ * @details Reads the whole file and hands its contents to parseString().
+ *          With ParseLimits::maxInputBytes set, oversized files are rejected
+ *          before they are read.
  */
 void YamlParser::parse(const std::string &filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw FileException(filename);
+  std::ostringstream content;
+  {
+    PhaseTimer    timer(m_stats, &ParseStats::readSeconds);
+    YamlTraceSpan span(currentTracer(), "io", "read");
+    span.setDetail(filename);
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+      throw FileException(filename);
+    }
+    if (m_limits.maxInputBytes) {
+      std::streamoff size = file.seekg(0, std::ios::end).tellg();
+      if (size > 0)
+        checkInputBytes(static_cast<size_t>(size));
+      file.seekg(0, std::ios::beg);
+    }
+    content << file.rdbuf();
   }
+  parseString(content.str());
+}
+
+/**
+ * @brief Parses a YAML file and reports statistics about the parse
+ * @param filename Path to the YAML file to parse
+ * @param stats Receives the statistics; reset first, and partially filled if parsing throws
+ * @throws FileException if file cannot be opened or read
+ * @throws SyntaxException if YAML syntax is invalid
+ */
+void YamlParser::parse(const std::string &filename, ParseStats &stats) {
+  withStats(stats, [&]() { parse(filename); });
+}
+
+/**
+ * @brief Parses YAML text held in memory and reports statistics about the parse
+ * @param content The YAML document
+ * @param stats Receives the statistics; reset first, and partially filled if parsing throws
+ * @throws SyntaxException if YAML syntax is invalid
+ */
+void YamlParser::parseString(const std::string &content, ParseStats &stats) {
+  withStats(stats, [&]() { parseString(content); });
+}
 
-  std::string              line;
-  std::vector<std::string> lines;
-  while (std::getline(file, line)) {
-    lines.push_back(line);
+/**
+ * @brief Runs a parse with statistics and allocation accounting attached
+ * @param stats Statistics to reset and fill
+ * @param parseFn The parse to run
+ */
+template <typename Fn> void YamlParser::withStats(ParseStats &stats, Fn parseFn) {
+  stats.reset();
+  YamlAllocationCounters counters;
+  auto                   detach = [&]() {
+    m_stats                  = nullptr;
+    stats.allocations        = counters.allocations;
+    stats.allocatedBytes     = counters.allocatedBytes;
+    stats.peakAllocatedBytes = counters.peakBytes;
+  };
+  m_stats = &stats;
+  try {
+    YamlAllocationTally tally(counters);
+    parseFn();
+  } catch (...) {
+    detach();
+    throw;
   }
+  detach();
+}
 
-  size_t idx = 0;
-  // First pass: detect if the root element is a sequence (starts with '-')
-  // Iterate through lines until we find non-empty content
-  for (const auto &l : lines) {
-    std::string trimmed = trim(l);
-    if (trimmed.empty()) // Skip empty or whitespace-only lines
-      continue;
-    if (!trimmed.empty() && trimmed[0] == '#') // Skip comment lines
-      continue;
-    if (trimmed[0] == '-') {
+/**
+ * @brief Parses YAML text held in memory and loads it into the parser
+ * @param content The YAML document
+ * @throws SyntaxException if YAML syntax is invalid
+ * @throws EncodingException if the text is not valid UTF-8
+ * @throws LimitException if a limit set with the constructor or setLimits() is exceeded
+ * @details This function:
+ *          1. Checks the encoding and normalizes line breaks with YamlInput (a
+ *             byte order mark is dropped, "\r\n" and "\r" become "\n"), then
+ *             tokenizes the text with YamlScanner (a final newline does not start a new line)
+ *          2. Detects if the root element is a sequence or mapping
+ *          3. For sequence root: stores in m_sequenceData and sets m_sequenceRoot flag
+ *          4. For mapping root: stores in m_data and clears m_sequenceRoot flag
+ *          5. Handles empty documents gracefully
+ *          Anchors are local to the document: those of earlier parses are forgotten.
+ */
+void YamlParser::parseString(const std::string &content) {
+  checkInputBytes(content.size());
+  m_tracer     = currentTracer();
+  m_depth      = 0;
+  m_nodes      = 0;
+  m_aliasNodes = 0;
+  m_line       = 0;
+  m_anchors.clear();
+
+  // Check the encoding and normalize line breaks, then tokenize every line
+  // once; the build phase works on the tokens only
+  YamlInput input = [&]() {
+    PhaseTimer timer(m_stats, &ParseStats::scanSeconds);
+    return YamlInput(content);
+  }();
+  YamlScanner tokens = [&]() {
+    PhaseTimer    timer(m_stats, &ParseStats::scanSeconds);
+    YamlTraceSpan span(m_tracer, "scan", "tokenize", 1);
+    YamlScanner   scanned(input.text());
+    span.setLastLine(scanned.size());
+    return scanned;
+  }();
+  bool sequenceRoot = tokens.startsWithSequence();
+
+  // Scalar typing runs inside the build phase; its share is moved out afterwards
+  double scalarBefore = m_stats ? m_stats->scalarSeconds : 0.0;
+  {
+    PhaseTimer    timer(m_stats, &ParseStats::buildSeconds);
+    YamlTraceSpan span(m_tracer, "build", sequenceRoot ? "parseSeq" : "parseMap", 1);
+    span.setLastLine(tokens.size());
+    size_t idx = 0;
+    if (sequenceRoot) {
       // Found sequence indicator at root level - parse entire sequence
-      YamlSeq seq    = parseSeq(lines, idx, 0);
       m_sequenceRoot = true;
-      m_sequenceData = seq;
+      m_sequenceData = parseSeq(tokens, idx, 0);
       m_data.clear();
-      return;
     } else {
-      break;
+      // Parse as a mapping (default case)
+      m_sequenceRoot = false;
+      m_data         = parseMap(tokens, idx, 0);
+      m_sequenceData.clear();
     }
   }
-  // Parse as a mapping (default case)
-  idx            = 0;
-  m_sequenceRoot = false;
-  m_data         = parseMap(lines, idx, 0);
-  m_sequenceData.clear();
+
+  if (m_progress)
+    m_progress(input.text().size(), input.text().size());
+
+  if (m_stats) {
+    m_stats->buildSeconds -= m_stats->scalarSeconds - scalarBefore;
+    m_stats->lines = tokens.size();
+    collectTreeStats();
+  }
 }
 
 /**
- * @brief Validates the structure of a mapping line and extracts key-value pair
- * @param line The line to validate and parse
- * @param lineNumber Current line number for error reporting
- * @param key Output parameter for the extracted key
- * @param value Output parameter for the extracted value
- * @throws SyntaxException if line structure is invalid
+ * @brief Types a scalar value, recording its size and typing time when statistics are requested
+ * @param value Raw scalar text
+ * @return Typed element, as parseScalar()
+ * @throws LimitException if the scalar is too long or there are too many nodes
+ * @throws SyntaxException for an invalid escape sequence, with the line of the scalar
  */
-void YamlParser::validateMapStructure(const std::string &line, size_t lineNumber, std::string &key,
-                                      std::string &value) {
-  auto pos = line.find(":");
-  if (pos == std::string::npos) {
-    throw SyntaxException("Missing ':' in key-value pair: '" + line + "'", lineNumber + 1);
+YamlElement YamlParser::typeScalar(const std::string &value) {
+  checkScalar(value.size());
+  addNodes(1);
+  try {
+    if (!m_stats)
+      return parseScalar(value);
+    PhaseTimer timer(m_stats, &ParseStats::scalarSeconds);
+    m_stats->scalarBytes += value.size();
+    return parseScalar(value);
+  } catch (const SyntaxException &e) {
+    // parseScalar() does not know where the scalar is
+    if (e.line() > 0)
+      throw;
+    throw SyntaxException(e.detail(), m_line);
   }
+}
 
-  key   = trim(line.substr(0, pos));
-  value = trim(line.substr(pos + 1));
+/**
+ * @brief Parses a block scalar, checking its size before the content is copied
+ * @param tokens Token stream of the document
+ * @param idx Index of the line holding the header; moved to the first line after the block
+ * @param indent Indentation of that line
+ * @param header Block header, e.g. "|" or ">-"
+ * @return String item
+ * @throws SyntaxException if the header is malformed
+ * @throws LimitException if the content is too long or there are too many nodes
+ */
+YamlItem YamlParser::typeBlockScalar(const YamlScanner &tokens, size_t &idx, size_t indent, const std::string &header) {
+  YamlBlockScalar block(tokens, idx, indent, header);
+  checkScalar(block.size());
+  addNodes(1);
+  if (m_stats)
+    m_stats->scalarBytes += block.size();
+  idx = block.end();
+  return YamlItem(YamlElement(block.str()));
+}
 
-  if (key.empty()) {
-    throw SyntaxException("Empty key in key-value pair", lineNumber + 1);
+/**
+ * @brief Parses a flow collection, recording it as scalar work when statistics are requested
+ * @param value Flow collection text including brackets or braces
+ * @return Sequence or mapping item
+ * @throws LimitException if the collection is too long, nested too deeply or has too many nodes
+ * @throws SyntaxException if the collection is malformed
+ * @details The flow parser stops at the depth limit before recursing any
+ *          further; without a limit, it allows its default depth below the
+ *          current collection.
+ */
+YamlItem YamlParser::typeFlowCollection(const std::string &value) {
+  checkScalar(value.size());
+  YamlFlowParser flow(m_limits.maxDepth ? m_limits.maxDepth : m_depth + YamlFlowParser::DEFAULT_MAX_DEPTH, m_depth,
+                      m_line);
+  YamlItem item;
+  {
+    PhaseTimer timer(m_stats, &ParseStats::scalarSeconds);
+    if (m_stats)
+      m_stats->scalarBytes += value.size();
+    item = flow.parse(value);
   }
+  addNodes(flow.nodes());
+  return item;
 }
 
 /**
- * @brief Handles syntax errors during map parsing with context information
- * @param error The error message
- * @param context Additional context about the error
- * @param lineNumber The line number where the error occurred
- * @throws SyntaxException with detailed error information
+ * @brief Adds node counts and the maximum depth of the parsed tree to m_stats
+ * @details The root collection is counted as one node at depth 0. Copies
+ *          made by aliases and merge keys are counted as separate nodes.
  */
-void YamlParser::handleMapSyntaxError(const std::string &error, const std::string &context, size_t lineNumber) {
-  std::string detailedError = error;
-  if (!context.empty()) {
-    detailedError += " (Context: " + context + ")";
+void YamlParser::collectTreeStats() const {
+  if (m_sequenceRoot) {
+    m_stats->nodes[static_cast<size_t>(YamlElement::ElementType::SEQ)]++;
+    tallySeq(m_sequenceData, 0, *m_stats);
+  } else {
+    m_stats->nodes[static_cast<size_t>(YamlElement::ElementType::MAP)]++;
+    tallyMap(m_data, 0, *m_stats);
   }
-  throw SyntaxException(detailedError, lineNumber + 1);
 }
 
 /**
- * @brief Parses a single map entry and adds it to the map
- * @param lines Vector of all lines in the YAML content
- * @param idx Current parsing position (modified as parsing progresses)
- * @param indent Current indentation level
- * @param curIndent Indentation of the current line
- * @param line The current line content
- * @param map The map to add the entry to
- * @return true if entry was processed, false if parsing should break
- */
-bool YamlParser::parseMapEntry(const std::vector<std::string> &lines, size_t &idx, int indent,
-                               std::string::size_type curIndent, const std::string &line, YamlMap &map) {
-  // Skip empty lines
-  if (line.empty() || line.find_first_not_of(" \t") == std::string::npos) {
-    idx++;
-    return true;
-  }
+ * @brief Get the tracer for an entry of the collection being parsed
+ * @return m_tracer while the nesting depth is within the tracer's section depth, null otherwise
+ */
+YamlTracer *YamlParser::sectionTracer() const {
+  return m_tracer && m_depth <= m_tracer->sectionDepth() ? m_tracer : nullptr;
+}
 
-  // Skip comment lines
-  std::string trimmed_line = trim(line);
-  if (!trimmed_line.empty() && trimmed_line[0] == '#') {
-    idx++;
-    return true;
-  }
+/**
+ * @brief Checks the size of a document against ParseLimits::maxInputBytes
+ * @param bytes Document size
+ * @throws LimitException if the document is too large
+ */
+void YamlParser::checkInputBytes(size_t bytes) const {
+  if (m_limits.maxInputBytes && bytes > m_limits.maxInputBytes)
+    throw LimitException("input bytes", m_limits.maxInputBytes);
+}
 
-  // Check indentation level
-  if (static_cast<int>(curIndent) < indent) {
-    return false; // Break from parsing
-  }
+/**
+ * @brief Calls the progress handler before a top-level entry
+ * @param tokens Token stream of the document
+ * @param idx Line of the entry
+ */
+void YamlParser::reportProgress(const YamlScanner &tokens, size_t idx) const {
+  if (m_progress && m_depth == 1)
+    m_progress(tokens[idx].offset, tokens.source().size());
+}
+
+/**
+ * @brief Accounts for a mapping or sequence whose parse has just begun
+ * @param line 1-based line of its first entry
+ * @throws LimitException if its entries would be nested too deeply or there are too many nodes
+ * @details Called after the DepthGuard, so m_depth is the depth of the entries.
+ */
+void YamlParser::enterCollection(size_t line) {
+  m_line = line;
+  if (m_limits.maxDepth && m_depth > m_limits.maxDepth)
+    throw LimitException("nesting depth", m_limits.maxDepth, m_line);
+  addNodes(1);
+}
 
-  std::string processedLine = line.substr(curIndent);
+/**
+ * @brief Counts created nodes against ParseLimits::maxNodes
+ * @param count Nodes just created
+ * @throws LimitException if there are too many nodes
+ */
+void YamlParser::addNodes(size_t count) {
+  m_nodes += count;
+  if (m_limits.maxNodes && m_nodes > m_limits.maxNodes)
+    throw LimitException("node count", m_limits.maxNodes, m_line);
+}
 
-  // Handle sequence lines within a map
-  if (processedLine[0] == '-') {
-    if (idx > 0) {
-      std::string prevLine = lines[idx - 1].substr(lines[idx - 1].find_first_not_of(" \t"));
-      auto        prevPos  = prevLine.find(":");
-      if (prevPos != std::string::npos) {
-        std::string key = trim(prevLine.substr(0, prevPos));
-        if (map.find(key) == map.end()) {
-          map[key] = YamlItem(YamlElement(parseSeq(lines, idx, static_cast<int>(curIndent))));
-        }
-      }
+/**
+ * @brief Checks the length of a scalar or key against ParseLimits::maxScalarBytes
+ * @param bytes Length of its source text
+ * @throws LimitException if it is too long
+ */
+void YamlParser::checkScalar(size_t bytes) const {
+  if (m_limits.maxScalarBytes && bytes > m_limits.maxScalarBytes)
+    throw LimitException("scalar bytes", m_limits.maxScalarBytes, m_line);
+}
+
+/**
+ * @brief Checks the copy an alias or merge key is about to make against the limits
+ * @param value The alias, e.g. "*base"
+ * @param mergeInto Mapping a merge key is applied to, or null for a plain alias
+ * @throws LimitException if the copy would exceed the alias expansion, node count or depth limit
+ * @details The anchored subtree is measured before anything is copied, and
+ *          measuring stops as soon as a node limit is exceeded, so an alias
+ *          bomb fails after a bounded amount of work. Missing anchors and
+ *          merges of non-mappings are left to parseAlias() and parseMergeKey().
+ */
+void YamlParser::checkAliasExpansion(const std::string &value, const YamlMap *mergeInto) {
+  if (!m_limits.maxAliasNodes && !m_limits.maxNodes && !m_limits.maxDepth)
+    return;
+  auto anchor = m_anchors.find(value.substr(1));
+  if (anchor == m_anchors.end() || (mergeInto && !anchor->second.value.isMap()))
+    return;
+
+  size_t budget = static_cast<size_t>(-1);
+  if (m_limits.maxAliasNodes)
+    budget = m_limits.maxAliasNodes > m_aliasNodes ? m_limits.maxAliasNodes - m_aliasNodes : 0;
+  if (m_limits.maxNodes)
+    budget = std::min(budget, m_limits.maxNodes > m_nodes ? m_limits.maxNodes - m_nodes : 0);
+
+  // A merge copies the entries its target lacks, one level below the mapping
+  size_t nodes = 0, deepest = 0;
+  if (mergeInto) {
+    for (const auto &entry : anchor->second.value.asMap()) {
+      if (mergeInto->find(entry.first) != mergeInto->end())
+        continue;
+      deepest = std::max(deepest, m_depth + measureSubtree(entry.second, budget, nodes));
+      if (nodes > budget)
+        break;
     }
-    idx++;
-    return true;
+  } else {
+    deepest = m_depth + measureSubtree(anchor->second, budget, nodes);
   }
 
-  // Parse key-value pair
-  std::string key, value;
-  validateMapStructure(processedLine, idx, key, value);
-  // Check for duplicate key
-  if (map.find(key) != map.end()) {
-    throw SyntaxException("Duplicate mapping key: '" + key + "'", idx + 1);
+  m_aliasNodes += nodes;
+  if (m_limits.maxAliasNodes && m_aliasNodes > m_limits.maxAliasNodes)
+    throw LimitException("alias expansion nodes", m_limits.maxAliasNodes, m_line);
+  addNodes(nodes);
+  if (m_limits.maxDepth && deepest > m_limits.maxDepth)
+    throw LimitException("nesting depth", m_limits.maxDepth, m_line);
+}
+
+/**
+ * @brief Validates the structure of a mapping line and extracts key-value pair
+ * @param tokens Token stream of the document
+ * @param token The line to validate and parse
+ * @param key Output parameter for the extracted key
+ * @param value Output parameter for the extracted value
+ * @throws SyntaxException if line structure is invalid
+ */
+void YamlParser::validateMapStructure(const YamlScanner &tokens, const YamlToken &token, std::string &key,
+                                      std::string &value) {
+  if (!token.hasColon) {
+    throw SyntaxException("Missing ':' in key-value pair: '" + tokens.str(tokens.content(token)) + "'", token.line);
+  }
+  if (tokens.key(token).empty()) {
+    throw SyntaxException("Empty key in key-value pair", token.line);
   }
 
-  // Handle different value types
-  if (value.empty() || value == "" || value == "\n" || value == "\r" || value == "\r\n") {
-    // Check for nested content
-    size_t lookahead = idx + 1;
-    if (lookahead < lines.size() && lines[lookahead].find_first_not_of(" \t") > curIndent) {
-      std::string nextLine    = lines[lookahead];
-      auto        nextIndent  = nextLine.find_first_not_of(" \t");
-      std::string nextContent = nextLine.substr(nextIndent);
+  key   = tokens.str(tokens.key(token));
+  value = tokens.str(tokens.value(token));
+}
 
-      idx++;
-      if (nextContent[0] == '-') {
-        map[key] = YamlItem(YamlElement(parseSeq(lines, idx, static_cast<int>(nextIndent))));
-      } else {
-        map[key] = YamlItem(YamlElement(parseMap(lines, idx, static_cast<int>(nextIndent))));
-      }
-    } else {
-      // Treat as explicit null (empty string)
-      map[key] = YamlItem(YamlElement(std::string("")));
-      idx++;
-    }
-  } else if (isMultilineLiteral(value)) {
-    map[key] = parseMultilineLiteral(lines, idx, static_cast<int>(curIndent), value[0]);
-  } else if (isAnchor(value)) {
-    map[key] = parseAnchor(value, lines, idx, m_anchors, *this);
-  } else if (isMergeKey(key, value)) {
-    parseMergeKey(value, map, m_anchors);
-    idx++;
-  } else if (isAlias(value)) {
-    map[key] = parseAlias(value, m_anchors);
-    idx++;
-  } else if (isInlineSeq(value)) {
-    map[key] = parseInlineSeq(value);
-    idx++;
-  } else if (!value.empty() && value.front() == '[' && value.back() != ']') {
-    throw SyntaxException("Malformed inline sequence: missing closing bracket");
-  } else {
-    map[key] = YamlItem(YamlElement(parseScalar(value)));
-    idx++;
+/**
+ * @brief Handles syntax errors during map parsing with context information
+ * @param error The error message
+ * @param context Additional context about the error
+ * @param lineNumber The line number where the error occurred
+ * @throws SyntaxException with detailed error information
+ */
+void YamlParser::handleMapSyntaxError(const std::string &error, const std::string &context, size_t lineNumber) {
+  std::string detailedError = error;
+  if (!context.empty()) {
+    detailedError += " (Context: " + context + ")";
   }
-
-  return true;
+  throw SyntaxException(detailedError, lineNumber + 1);
 }
 
 /**
- * @brief Parses a YAML mapping (dictionary/object) from a sequence of lines
- * @param lines Vector of all lines in the YAML content
+ * @brief Parses a YAML mapping (dictionary/object) from the token stream
+ * @param tokens Token stream of the document
  * @param idx Current parsing position (modified as parsing progresses)
  * @param indent Expected indentation level for this mapping
  * @return YamlMap containing the parsed key-value pairs
@@ -240,46 +597,39 @@ bool YamlParser::parseMapEntry(const std::vector<std::string> &lines, size_t &id
  *          - Inline sequences
  *          - Empty/null values
  *          - Proper indentation-based nesting
+ *          Blank lines between a key and its nested block are skipped.
  */
-YamlMap YamlParser::parseMap(const std::vector<std::string> &lines, size_t &idx, int indent) {
+YamlMap YamlParser::parseMap(const YamlScanner &tokens, size_t &idx, int indent) {
+  DepthGuard depth(m_depth);
+  enterCollection(idx + 1);
   YamlMap map;
   // Track explicitly defined keys in this mapping block (not merged)
   std::set<std::string> explicitKeys;
 
-  while (idx < lines.size()) {
-    std::string            line      = lines[idx];
-    std::string::size_type curIndent = line.find_first_not_of(" \t");
+  while (idx < tokens.size()) {
+    const YamlToken &token = tokens[idx];
+    m_line                 = idx + 1;
 
-    // Custom parseMapEntry logic to allow explicit key tracking
-    // (inlined from parseMapEntry for this block)
-    // ...existing code...
-    // Skip empty lines
-    if (line.empty() || line.find_first_not_of(" \t") == std::string::npos) {
-      idx++;
-      continue;
-    }
-    // Skip comment lines
-    std::string trimmed_line = trim(line);
-    if (!trimmed_line.empty() && trimmed_line[0] == '#') {
+    // Skip empty and comment lines
+    if (token.kind == YamlTokenKind::Blank || token.kind == YamlTokenKind::Comment) {
       idx++;
       continue;
     }
     // Check indentation level
-    if (static_cast<int>(curIndent) < indent) {
+    if (static_cast<int>(token.indent) < indent) {
       break;
     }
-    std::string processedLine = line.substr(curIndent);
-    // Handle sequence lines within a map
-    if (processedLine[0] == '-') {
-      if (idx > 0) {
-        std::string prevLine = lines[idx - 1].substr(lines[idx - 1].find_first_not_of(" \t"));
-        auto        prevPos  = prevLine.find(":");
-        if (prevPos != std::string::npos) {
-          std::string key = trim(prevLine.substr(0, prevPos));
-          if (map.find(key) == map.end()) {
-            map[key] = YamlItem(YamlElement(parseSeq(lines, idx, static_cast<int>(curIndent))));
-            explicitKeys.insert(key);
-          }
+    reportProgress(tokens, idx);
+    // Handle sequence lines within a map: they belong to the key of the closest line above
+    if (token.kind == YamlTokenKind::SequenceItem) {
+      size_t prev = idx;
+      while (prev > 0 && tokens[prev - 1].kind == YamlTokenKind::Blank)
+        prev--;
+      if (prev > 0 && tokens[prev - 1].hasColon) {
+        std::string key = tokens.str(tokens.key(tokens[prev - 1]));
+        if (map.find(key) == map.end()) {
+          map[key] = YamlItem(YamlElement(parseSeq(tokens, idx, static_cast<int>(token.indent))));
+          explicitKeys.insert(key);
         }
       }
       idx++;
@@ -287,56 +637,75 @@ YamlMap YamlParser::parseMap(const std::vector<std::string> &lines, size_t &idx,
     }
     // Parse key-value pair
     std::string key, value;
-    validateMapStructure(processedLine, idx, key, value);
+    validateMapStructure(tokens, token, key, value);
+    checkScalar(key.size());
     // Check for duplicate key: only error if explicitly defined in this block
     if (explicitKeys.find(key) != explicitKeys.end()) {
       throw SyntaxException("Duplicate mapping key: '" + key + "'", idx + 1);
     }
+    // Entries near the top get a trace event spanning their lines
+    YamlTraceSpan section(sectionTracer(), "section", key, idx + 1);
     // Handle different value types
-    if (value.empty() || value == "" || value == "\n" || value == "\r" || value == "\r\n") {
+    if (value.empty()) {
       // Check for nested content
-      size_t lookahead = idx + 1;
-      if (lookahead < lines.size() && lines[lookahead].find_first_not_of(" \t") > curIndent) {
-        std::string nextLine    = lines[lookahead];
-        auto        nextIndent  = nextLine.find_first_not_of(" \t");
-        std::string nextContent = nextLine.substr(nextIndent);
-        idx++;
-        if (nextContent[0] == '-') {
-          map[key] = YamlItem(YamlElement(parseSeq(lines, idx, static_cast<int>(nextIndent))));
+      size_t next = tokens.nextNonBlank(idx + 1);
+      if (next < tokens.size() && tokens[next].indent > token.indent) {
+        const YamlToken &nested = tokens[next];
+        idx                     = next;
+        if (nested.kind == YamlTokenKind::SequenceItem) {
+          map[key] = YamlItem(YamlElement(parseSeq(tokens, idx, static_cast<int>(nested.indent))));
         } else {
-          map[key] = YamlItem(YamlElement(parseMap(lines, idx, static_cast<int>(nextIndent))));
+          map[key] = YamlItem(YamlElement(parseMap(tokens, idx, static_cast<int>(nested.indent))));
         }
       } else {
         // Treat as explicit null (empty string)
+        addNodes(1);
         map[key] = YamlItem(YamlElement(std::string("")));
         idx++;
       }
       explicitKeys.insert(key);
     } else if (isMultilineLiteral(value)) {
-      map[key] = parseMultilineLiteral(lines, idx, static_cast<int>(curIndent), value[0]);
+      map[key] = typeBlockScalar(tokens, idx, token.indent, value);
       explicitKeys.insert(key);
     } else if (isAnchor(value)) {
-      map[key] = parseAnchor(value, lines, idx, m_anchors, *this);
+      map[key] = parseAnchor(value, tokens, idx, m_anchors, *this);
+      if (m_stats)
+        m_stats->anchors++;
       explicitKeys.insert(key);
     } else if (isMergeKey(key, value)) {
-      parseMergeKey(value, map, m_anchors);
+      {
+        YamlTraceSpan span(m_tracer, "resolve", "merge", idx + 1);
+        span.setDetail(value);
+        checkAliasExpansion(value, &map);
+        parseMergeKey(value, map, m_anchors);
+      }
+      if (m_stats)
+        m_stats->mergeKeys++;
       idx++;
       // Do not add '<<' to explicitKeys
     } else if (isAlias(value)) {
-      map[key] = parseAlias(value, m_anchors);
+      {
+        YamlTraceSpan span(m_tracer, "resolve", "alias", idx + 1);
+        span.setDetail(value);
+        checkAliasExpansion(value, nullptr);
+        map[key] = parseAlias(value, m_anchors);
+      }
+      if (m_stats)
+        m_stats->aliases++;
       idx++;
       explicitKeys.insert(key);
-    } else if (isInlineSeq(value)) {
-      map[key] = parseInlineSeq(value);
+    } else if (isFlowCollection(value)) {
+      map[key] = typeFlowCollection(value);
       idx++;
       explicitKeys.insert(key);
     } else if (!value.empty() && value.front() == '[' && value.back() != ']') {
       throw SyntaxException("Malformed inline sequence: missing closing bracket");
     } else {
-      map[key] = YamlItem(YamlElement(parseScalar(value)));
+      map[key] = YamlItem(YamlElement(typeScalar(value)));
       idx++;
       explicitKeys.insert(key);
     }
+    section.setLastLine(idx);
   }
   return map;
 }
@@ -374,85 +743,83 @@ void YamlParser::handleSeqSyntaxError(const std::string &error, const std::strin
 
 /**
  * @brief Parses a single sequence element and adds it to the sequence
- * @param lines Vector of all lines in the YAML content
+ * @param tokens Token stream of the document
  * @param idx Current parsing position (modified as parsing progresses)
  * @param indent Current indentation level
- * @param curIndent Indentation of the current line
- * @param line The current line content
  * @param seq The sequence to add the element to
  * @return true if element was processed, false if parsing should break
  */
-bool YamlParser::parseSeqElement(const std::vector<std::string> &lines, size_t &idx, int indent,
-                                 std::string::size_type curIndent, const std::string &line, YamlSeq &seq) {
-  // Skip empty lines
-  if (line.empty() || line.find_first_not_of(" \t") == std::string::npos) {
-    idx++;
-    return true;
-  }
+bool YamlParser::parseSeqElement(const YamlScanner &tokens, size_t &idx, int indent, YamlSeq &seq) {
+  const YamlToken &token = tokens[idx];
 
-  // Skip comment lines
-  std::string trimmed_line = trim(line);
-  if (!trimmed_line.empty() && trimmed_line[0] == '#') {
+  // Skip empty and comment lines
+  if (token.kind == YamlTokenKind::Blank || token.kind == YamlTokenKind::Comment) {
     idx++;
     return true;
   }
 
   // Check indentation level
-  if (static_cast<int>(curIndent) < indent) {
+  if (static_cast<int>(token.indent) < indent) {
     return false; // Break from parsing
   }
 
-  std::string processedLine = line.substr(curIndent);
-
   // Validate sequence structure
-  if (processedLine[0] != '-') {
+  if (token.kind != YamlTokenKind::SequenceItem) {
     return false; // Not a sequence line, break parsing
   }
+  reportProgress(tokens, idx);
 
-  std::string value = trim(processedLine.substr(1));
+  // A block scalar item ("- |") owns the more indented lines below it
+  YamlSpan item = tokens.item(token);
+  if (!item.empty() && (tokens.source()[item.offset] == '|' || tokens.source()[item.offset] == '>')) {
+    seq.push_back(typeBlockScalar(tokens, idx, token.indent, tokens.str(item)));
+    return true;
+  }
 
   // Check if this is a mapping block (next line is more indented)
   size_t lookahead = idx + 1;
-  if (lookahead < lines.size()) {
-    std::string nextLine   = lines[lookahead];
-    auto        nextIndent = nextLine.find_first_not_of(" \t");
+  if (lookahead < tokens.size()) {
+    const YamlToken &next = tokens[lookahead];
 
-    if (nextIndent != std::string::npos && nextIndent > curIndent) {
+    if (next.kind != YamlTokenKind::Blank && next.indent > token.indent) {
       // This is a mapping block. Handle case where sequence item has content
       YamlMap itemMap;
 
       // If the sequence item has content, parse it as the first key-value pair
-      if (!value.empty()) {
-        auto pos = value.find(":");
-        if (pos != std::string::npos) {
-          std::string key = trim(value.substr(0, pos));
-          std::string val = trim(value.substr(pos + 1));
-          itemMap[key]    = YamlItem(parseScalar(val));
-        }
+      if (!tokens.item(token).empty() && token.hasColon) {
+        std::string key = tokens.str(tokens.itemKey(token));
+        checkScalar(key.size());
+        itemMap[key] = YamlItem(typeScalar(tokens.str(tokens.value(token))));
       }
 
       // Parse the indented lines as additional key-value pairs
       idx++;
-      YamlMap indentedMap = parseMap(lines, idx, static_cast<int>(nextIndent));
+      YamlMap indentedMap = parseMap(tokens, idx, static_cast<int>(next.indent));
 
-      // Merge the indented map into the item map
-      for (const auto &pair : indentedMap) {
-        itemMap[pair.first] = pair.second;
+      // Merge the indented map into the item map; entries are moved, not copied
+      if (itemMap.empty()) {
+        itemMap = std::move(indentedMap);
+      } else {
+        for (auto &pair : indentedMap) {
+          itemMap[pair.first] = std::move(pair.second);
+        }
       }
 
-      seq.push_back(YamlItem(YamlElement(itemMap)));
+      seq.push_back(YamlItem(YamlElement(std::move(itemMap))));
       return true; // parseMap will have updated idx
     }
   }
 
   // Not a mapping block, parse as scalar or inline sequence if not empty
-  if (!value.empty()) {
-    if (isInlineSeq(value)) {
-      seq.push_back(parseInlineSeq(value));
+  if (!item.empty()) {
+    std::string value = tokens.str(item);
+    if (isFlowCollection(value)) {
+      seq.push_back(typeFlowCollection(value));
     } else {
-      seq.push_back(YamlItem(parseScalar(value)));
+      seq.push_back(YamlItem(typeScalar(value)));
     }
   } else {
+    addNodes(1);
     seq.push_back(YamlItem(YamlElement(std::string(""))));
   }
   idx++;
@@ -460,8 +827,8 @@ bool YamlParser::parseSeqElement(const std::vector<std::string> &lines, size_t &
 }
 
 /**
- * @brief Parses a YAML sequence (array/list) from a sequence of lines
- * @param lines Vector of all lines in the YAML content
+ * @brief Parses a YAML sequence (array/list) from the token stream
+ * @param tokens Token stream of the document
  * @param idx Current parsing position (modified as parsing progresses)
  * @param indent Expected indentation level for this sequence
  * @return YamlSeq containing the parsed sequence items
@@ -471,14 +838,25 @@ bool YamlParser::parseSeqElement(const std::vector<std::string> &lines, size_t &
  *          - Empty elements
  *          - Proper indentation-based nesting
  */
-YamlSeq YamlParser::parseSeq(const std::vector<std::string> &lines, size_t &idx, int indent) {
+YamlSeq YamlParser::parseSeq(const YamlScanner &tokens, size_t &idx, int indent) {
+  DepthGuard depth(m_depth);
+  enterCollection(idx + 1);
   YamlSeq seq;
 
-  while (idx < lines.size()) {
-    std::string            line      = lines[idx];
-    std::string::size_type curIndent = line.find_first_not_of(" \t");
-
-    if (!parseSeqElement(lines, idx, indent, curIndent, line, seq)) {
+  while (idx < tokens.size()) {
+    m_line = idx + 1;
+
+    // Items near the top get a trace event spanning their lines; skipped lines get none
+    size_t        count = seq.size();
+    YamlTraceSpan section(sectionTracer(), "section", "", idx + 1);
+    bool          more = parseSeqElement(tokens, idx, indent, seq);
+    if (seq.size() == count) {
+      section.cancel();
+    } else if (section.active()) {
+      section.setName("[" + std::to_string(count) + "]");
+      section.setLastLine(idx);
+    }
+    if (!more) {
       break;
     }
   }
@@ -491,14 +869,14 @@ YamlSeq YamlParser::parseSeq(const std::vector<std::string> &lines, size_t &idx,
  * @return YamlElement containing the parsed value
  * @details Handles these scalar types:
  *          - Booleans (true/false)
- *          - Integers (matched by regex ^-?\d+$)
- *          - Floating point numbers (matched by regex ^-?\d*\.\d+$)
+ *          - Integers (an optional sign and digits)
+ *          - Floating point numbers (decimal, with optional fraction and exponent)
  *          - Quoted strings (both single and double quotes)
  *          - Plain strings (anything else)
  *          Also handles:
  *          - Comment removal (strips everything after #)
  *          - Whitespace trimming
- *          - Quote stripping from quoted strings
+ *          - Quote stripping from quoted strings, with escapes decoded
  */
 YamlElement YamlParser::parseScalar(const std::string &value) {
   std::string cleanValue = preprocessScalarValue(value);
@@ -561,11 +939,8 @@ YamlElement YamlParser::tryParsePrimitive(const std::string &cleanValue) {
  * @return Parsed numeric element or string if not numeric
  */
 YamlElement YamlParser::parseNumericValue(const std::string &value) {
-  static const std::regex int_re("^[+-]?\\d+$");
-  static const std::regex double_re("^[+-]?(?:\\d+\\.\\d*|\\.\\d+|\\d+)(?:[eE][+-]?\\d+)?$");
-
   // Try integer parsing
-  if (std::regex_match(value, int_re)) {
+  if (isIntegerText(value)) {
     try {
       return YamlElement(std::stoi(value));
     } catch (const std::out_of_range &) {
@@ -576,7 +951,7 @@ YamlElement YamlParser::parseNumericValue(const std::string &value) {
   }
 
   // Try double parsing
-  if (std::regex_match(value, double_re)) {
+  if (isDoubleText(value)) {
     try {
       return YamlElement(std::stod(value));
     } catch (const std::out_of_range &) {
@@ -591,16 +966,16 @@ YamlElement YamlParser::parseNumericValue(const std::string &value) {
 }
 
 /**
- * @brief Process quoted strings by removing surrounding quotes
+ * @brief Process quoted strings by removing surrounding quotes and decoding escapes
  * @param value String that may have surrounding quotes
- * @return String with quotes removed if present
+ * @return String with quotes removed and escapes decoded if quoted, else value itself
+ * @throws SyntaxException if a double-quoted string has an invalid escape sequence
  */
 std::string YamlParser::processQuotedString(const std::string &value) {
-  // Strip surrounding quotes if present
-  if ((value.size() >= 2) &&
-      ((value.front() == '\'' && value.back() == '\'') || (value.front() == '"' && value.back() == '"'))) {
-    return value.substr(1, value.size() - 2);
-  }
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    return unescapeDoubleQuoted(value.data() + 1, value.size() - 2);
+  if (value.size() >= 2 && value.front() == '\'' && value.back() == '\'')
+    return unescapeSingleQuoted(value.data() + 1, value.size() - 2);
   return value;
 }
 
@@ -627,4 +1002,14 @@ const YamlItem &YamlParser::get(const std::string &key) const {
   throw KeyException(key);
 }
 
+/**
+ * @brief Measures the heap usage of the parsed document
+ * @param largestCount Number of largest subtrees to list by path (0 skips the list)
+ * @return Usage breakdown of the root mapping or sequence
+ */
+YamlMemoryUsage YamlParser::memoryUsage(size_t largestCount) const {
+  return m_sequenceRoot ? yamlparser::memoryUsage(m_sequenceData, largestCount)
+                        : yamlparser::memoryUsage(m_data, largestCount);
+}
+
 } // namespace yamlparser
@@ -0,0 +1,144 @@
+#include "YamlPooledTree.hpp"
+#include <cstdint>
+#include <cstring>
+
+// YamlPooledTree implementation - parsed trees copied into a memory resource
+// Key features:
+// - The tree is serialized with YamlSnapshot::build() and the image copied
+//   into one block of the resource, so the copy costs a single allocation
+//   and holds no pointers into the global heap
+// - Lookups are answered by a YamlSnapshotView over that block
+
+namespace yamlparser {
+
+/**
+ * @brief Copies a mapping into a block of a memory resource
+ * @param map Tree to copy
+ * @param resource Resource to allocate from; null selects the default resource
+ * @throws std::bad_alloc if the resource cannot provide the block
+ * @throws SnapshotException if the tree is too large for the image format
+ */
+YamlPooledTree::YamlPooledTree(const YamlMap &map, YamlMemoryResource *resource)
+    : YamlPooledTree(YamlSnapshot::build(map), resource) {}
+
+/**
+ * @brief Copies a sequence into a block of a memory resource
+ * @param seq Tree to copy
+ * @param resource Resource to allocate from; null selects the default resource
+ * @throws std::bad_alloc if the resource cannot provide the block
+ * @throws SnapshotException if the tree is too large for the image format
+ */
+YamlPooledTree::YamlPooledTree(const YamlSeq &seq, YamlMemoryResource *resource)
+    : YamlPooledTree(YamlSnapshot::build(seq), resource) {}
+
+/**
+ * @brief Copies a snapshot image into the resource and attaches a view to it
+ * @param image Image built by YamlSnapshot::build()
+ * @param resource Resource to allocate from; null selects the default resource
+ */
+YamlPooledTree::YamlPooledTree(const std::string &image, YamlMemoryResource *resource)
+    : m_block(image, resource), m_view(m_block.memory, m_block.size) {}
+
+/**
+ * @brief Check if the root element is a sequence
+ * @return true if the root is a sequence, false otherwise
+ */
+bool YamlPooledTree::isSequenceRoot() const {
+  return m_view.isSequenceRoot();
+}
+
+/**
+ * @brief Get the root node
+ * @return Handle to the root
+ * @throws SnapshotException if the tree was moved from
+ */
+YamlSnapshotNode YamlPooledTree::root() const {
+  return m_view.root();
+}
+
+/**
+ * @brief Look up a key of the root mapping
+ * @param key The key to look up
+ * @return Handle to the value
+ * @throws TypeException if the root is not a mapping
+ * @throws KeyException if the key is not present
+ */
+YamlSnapshotNode YamlPooledTree::get(const std::string &key) const {
+  return m_view.get(key);
+}
+
+/**
+ * @brief Get the number of nodes in the tree
+ * @return Node count, including the root
+ */
+size_t YamlPooledTree::nodeCount() const {
+  return m_view.nodeCount();
+}
+
+/**
+ * @brief Get the memory taken from the resource
+ * @return Size of the block in bytes
+ */
+size_t YamlPooledTree::bytes() const {
+  return m_block.size;
+}
+
+/**
+ * @brief Get the resource holding the tree
+ * @return Resource the block was allocated from
+ */
+YamlMemoryResource *YamlPooledTree::resource() const {
+  return m_block.resource;
+}
+
+/**
+ * @brief Allocates a block and copies the image into it
+ * @param image Bytes to copy
+ * @param from Resource to allocate from; null selects the default resource
+ */
+YamlPooledTree::Block::Block(const std::string &image, YamlMemoryResource *from)
+    : resource(from ? from : defaultMemoryResource()), memory(nullptr), size(image.size()) {
+  // Snapshot views read the node table in place and need 8-byte alignment
+  memory = resource->allocate(size, alignof(std::uint64_t));
+  std::memcpy(memory, image.data(), size);
+}
+
+/**
+ * @brief Destructor - returns the block to its resource
+ */
+YamlPooledTree::Block::~Block() {
+  release();
+}
+
+/**
+ * @brief Move constructor - transfers ownership of the block
+ */
+YamlPooledTree::Block::Block(Block &&other) noexcept
+    : resource(other.resource), memory(other.memory), size(other.size) {
+  other.memory = nullptr;
+  other.size   = 0;
+}
+
+/**
+ * @brief Move assignment - returns the current block and takes the other one
+ */
+YamlPooledTree::Block &YamlPooledTree::Block::operator=(Block &&other) noexcept {
+  if (this != &other) {
+    release();
+    resource     = other.resource;
+    memory       = other.memory;
+    size         = other.size;
+    other.memory = nullptr;
+    other.size   = 0;
+  }
+  return *this;
+}
+
+void YamlPooledTree::Block::release() noexcept {
+  if (memory)
+    resource->deallocate(memory, size, alignof(std::uint64_t));
+  memory = nullptr;
+  size   = 0;
+}
+
+} // namespace yamlparser
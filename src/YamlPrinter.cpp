@@ -1,4 +1,6 @@
 #include "YamlPrinter.hpp"
+#include "YamlHelperFunctions.hpp"
+#include "YamlTrace.hpp"
 #include <ostream>
 
 // YamlPrinter implementation - Converts YAML data structures to formatted text
@@ -7,52 +9,14 @@
 // - Consistent 2-space indentation for nested levels
 // - Special handling of null values and empty strings
 // - YAML-compliant formatting for all scalar types
-// - Stream-based output for efficiency
+// - Rendering into a YamlOutputBuffer; stream overloads write in large chunks
 
 namespace yamlparser {
 
-namespace {
-bool needsQuoting(const std::string &s) {
-  if (s.empty())
-    return true; // for empty string, "null" will be print
-  if (s.front() == ' ' || s.back() == ' ')
-    return true;
-  // special leading characters or YAML syntax chars
-  if (s.front() == '-' || s.front() == '?' || s.front() == ':')
-    return true;
-  return s.find_first_of(":#{}[],&*!?|>'\"%@`") != std::string::npos;
-}
-
-std::string quoteIfNeeded(const std::string &s) {
-  if (!needsQuoting(s))
-    return s;
-  // simple single-quote strategy: double single-quotes inside
-  std::string out;
-  out.reserve(s.size() + 2);
-  out.push_back('\'');
-  for (char c : s) {
-    out.push_back(c);
-    if (c == '\'')
-      out.push_back('\''); // escape by doubling
-  }
-  out.push_back('\'');
-  return out;
-}
-} // anonymous namespace
-
-/**
- * @brief Creates an indentation string with specified number of spaces
- * @param n Number of spaces to generate
- * @return A string containing n spaces
- */
-std::string makeIndent(int n) {
-  return std::string(static_cast<std::string::size_type>(n), ' ');
-}
-
 /**
- * @brief Prints a YAML mapping to an output stream
+ * @brief Prints a YAML mapping to an output buffer
  * @param map The YAML mapping to print
- * @param os The output stream to write to
+ * @param out The output buffer to write to
  * @param indent Current indentation level (number of spaces)
  * @details Handles:
  *          - Key-value pair formatting
@@ -60,44 +24,45 @@ std::string makeIndent(int n) {
  *          - Special handling of null values
  *          - Empty string conversion to null
  */
-void YamlPrinter::print(const YamlMap &map, std::ostream &os, int indent) {
-  std::string indentStr = makeIndent(indent);
+void YamlPrinter::print(const YamlMap &map, YamlOutputBuffer &out, int indent) {
   for (const auto &kv : map) {
-    os << indentStr << quoteIfNeeded(kv.first) << ": ";
+    out.appendIndent(indent);
+    writeQuotedIfNeeded(kv.first, out);
+    out.append(": ", 2);
     const YamlElement &v = kv.second.value;
     if (v.isString() && v.asString().empty()) {
       // empty string prints as null
-      os << "null" << std::endl;
+      out.append("null\n", 5);
     } else if (v.type == YamlElement::ElementType::NONE) {
-      os << "null" << std::endl;
+      out.append("null\n", 5);
     } else {
-      print(kv.second, os, indent + 2);
+      print(kv.second, out, indent + 2);
     }
   }
 }
 
 /**
- * @brief Prints a YAML sequence to an output stream
+ * @brief Prints a YAML sequence to an output buffer
  * @param seq The YAML sequence to print
- * @param os The output stream to write to
+ * @param out The output buffer to write to
  * @param indent Current indentation level (number of spaces)
  * @details Handles:
  *          - Sequence item formatting with '-' prefix
  *          - Proper indentation of nested items
  *          - Recursive printing of complex items
  */
-void YamlPrinter::print(const YamlSeq &seq, std::ostream &os, int indent) {
-  std::string indentStr = makeIndent(indent);
+void YamlPrinter::print(const YamlSeq &seq, YamlOutputBuffer &out, int indent) {
   for (const auto &item : seq) {
-    os << indentStr << "- ";
-    print(item, os, indent + 2);
+    out.appendIndent(indent);
+    out.append("- ", 2);
+    print(item, out, indent + 2);
   }
 }
 
 /**
- * @brief Prints a YAML item to an output stream
+ * @brief Prints a YAML item to an output buffer
  * @param item The YAML item to print
- * @param os The output stream to write to
+ * @param out The output buffer to write to
  * @param indent Current indentation level (number of spaces)
  * @details Handles all YAML element types:
  *          - Strings (including empty strings as null)
@@ -106,32 +71,103 @@ void YamlPrinter::print(const YamlSeq &seq, std::ostream &os, int indent) {
  *          - Null values
  *          - Nested maps and sequences
  */
-void YamlPrinter::print(const YamlItem &item, std::ostream &os, int indent) {
+void YamlPrinter::print(const YamlItem &item, YamlOutputBuffer &out, int indent) {
   const YamlElement &v = item.value;
   switch (v.type) {
   case YamlElement::ElementType::STRING:
-    os << quoteIfNeeded(v.asString()) << std::endl;
+    writeQuotedIfNeeded(v.asString(), out);
+    out.append('\n');
     break;
   case YamlElement::ElementType::DOUBLE:
-    os << v.asDouble() << std::endl;
+    writeDouble(v.asDouble(), out);
+    out.append('\n');
     break;
   case YamlElement::ElementType::INT:
-    os << v.asInt() << std::endl;
+    writeInt(v.asInt(), out);
+    out.append('\n');
     break;
   case YamlElement::ElementType::BOOL:
-    os << (v.asBool() ? "true" : "false") << std::endl;
+    if (v.asBool())
+      out.append("true\n", 5);
+    else
+      out.append("false\n", 6);
     break;
   case YamlElement::ElementType::SEQ:
-    os << std::endl;
-    print(v.asSeq(), os, indent + 2);
+    out.append('\n');
+    print(v.asSeq(), out, indent + 2);
     break;
   case YamlElement::ElementType::MAP:
-    os << std::endl;
-    print(v.asMap(), os, indent + 2);
+    out.append('\n');
+    print(v.asMap(), out, indent + 2);
     break;
   default:
-    os << "null" << std::endl;
+    out.append("null\n", 5);
     break;
   }
 }
+
+/**
+ * @brief Prints a YAML mapping to an output stream
+ * @param map The YAML mapping to print
+ * @param os The output stream to write to
+ * @param indent Current indentation level (number of spaces)
+ * @details Output is collected in a YamlOutputBuffer and written in large
+ *          chunks; the stream is not flushed.
+ */
+void YamlPrinter::print(const YamlMap &map, std::ostream &os, int indent) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlPrinter::print");
+  YamlOutputBuffer out(os);
+  print(map, out, indent);
+  out.flush();
+}
+
+/**
+ * @brief Prints a YAML sequence to an output stream
+ * @param seq The YAML sequence to print
+ * @param os The output stream to write to
+ * @param indent Current indentation level (number of spaces)
+ */
+void YamlPrinter::print(const YamlSeq &seq, std::ostream &os, int indent) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlPrinter::print");
+  YamlOutputBuffer out(os);
+  print(seq, out, indent);
+  out.flush();
+}
+
+/**
+ * @brief Prints a YAML item to an output stream
+ * @param item The YAML item to print
+ * @param os The output stream to write to
+ * @param indent Current indentation level (number of spaces)
+ */
+void YamlPrinter::print(const YamlItem &item, std::ostream &os, int indent) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlPrinter::print");
+  YamlOutputBuffer out(os);
+  print(item, out, indent);
+  out.flush();
+}
+
+/**
+ * @brief Renders a YAML mapping into a string
+ * @param map The YAML mapping to render
+ * @return The formatted YAML text
+ */
+std::string YamlPrinter::toString(const YamlMap &map) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlPrinter::toString");
+  YamlOutputBuffer out;
+  print(map, out);
+  return out.str();
+}
+
+/**
+ * @brief Renders a YAML sequence into a string
+ * @param seq The YAML sequence to render
+ * @return The formatted YAML text
+ */
+std::string YamlPrinter::toString(const YamlSeq &seq) {
+  YamlTraceSpan    span(currentTracer(), "print", "YamlPrinter::toString");
+  YamlOutputBuffer out;
+  print(seq, out);
+  return out.str();
+}
 } // namespace yamlparser
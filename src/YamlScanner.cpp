@@ -0,0 +1,224 @@
+#include "YamlScanner.hpp"
+#include "YamlException.hpp"
+#include <algorithm>
+#include <cstring>
+
+// YamlScanner implementation - one pass from raw text to line tokens
+// Key features:
+// - Line ends and the first ':' are found with memchr, which the C library
+//   vectorizes; every other byte of a line is looked at most once more while
+//   trimming
+// - Tokens store offsets, so scanning allocates only the token vector, sized
+//   up front from the number of line breaks
+// - Positions within a line are 32 bits wide, which keeps a token at 40 bytes
+
+namespace yamlparser {
+
+namespace {
+
+const size_t MAX_LINE_BYTES = UINT32_MAX;
+
+inline bool isBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Tokenizes a document
+ * @param source YAML text; must outlive the scanner
+ * @throws LimitException if a line is 4 GiB or longer
+ */
+YamlScanner::YamlScanner(const std::string &source) : m_source(source) {
+  const char *data = source.data();
+  m_tokens.reserve(static_cast<size_t>(std::count(source.begin(), source.end(), '\n')) + 1);
+
+  size_t start = 0;
+  while (start < source.size()) {
+    const void *newline = std::memchr(data + start, '\n', source.size() - start);
+    size_t      end     = newline ? static_cast<size_t>(static_cast<const char *>(newline) - data) : source.size();
+    scanLine(start, end);
+    start = end + 1;
+  }
+}
+
+/**
+ * @brief Get the number of lines
+ * @return Number of tokens
+ */
+size_t YamlScanner::size() const {
+  return m_tokens.size();
+}
+
+/**
+ * @brief Get the token of a line
+ * @param index 0-based line index
+ * @return The token; index must be less than size()
+ */
+const YamlToken &YamlScanner::operator[](size_t index) const {
+  return m_tokens[index];
+}
+
+/**
+ * @brief Get the scanned document
+ * @return The source passed to the constructor
+ */
+const std::string &YamlScanner::source() const {
+  return m_source;
+}
+
+/**
+ * @brief Copies the text of a span
+ * @param span Span returned by one of the accessors
+ * @return The bytes of the span
+ */
+std::string YamlScanner::str(const YamlSpan &span) const {
+  return m_source.substr(span.offset, span.length);
+}
+
+/**
+ * @brief Get the line from its first non-blank character to its end, trailing blanks included
+ * @param token A token of this scanner
+ * @return The span; empty for blank lines
+ */
+YamlSpan YamlScanner::content(const YamlToken &token) const {
+  if (token.kind == YamlTokenKind::Blank)
+    return {token.offset, 0};
+  size_t begin = token.offset + token.indent;
+  size_t end   = m_source.find('\n', token.offset + token.textEnd);
+  if (end == std::string::npos)
+    end = m_source.size();
+  return {begin, end - begin};
+}
+
+/**
+ * @brief Get the line without leading and trailing blanks
+ * @param token A token of this scanner
+ * @return The span; empty for blank lines
+ */
+YamlSpan YamlScanner::text(const YamlToken &token) const {
+  return {token.offset + token.indent, token.textEnd - token.indent};
+}
+
+/**
+ * @brief Get the trimmed text before the first ':'
+ * @param token A token with hasColon set
+ * @return The span
+ */
+YamlSpan YamlScanner::key(const YamlToken &token) const {
+  return {token.offset + token.indent, token.keyEnd - token.indent};
+}
+
+/**
+ * @brief Get the trimmed text after the first ':'
+ * @param token A token with hasColon set
+ * @return The span
+ */
+YamlSpan YamlScanner::value(const YamlToken &token) const {
+  return {token.offset + token.valueBegin, token.textEnd - token.valueBegin};
+}
+
+/**
+ * @brief Get the trimmed text after the '-' of a sequence item
+ * @param token A sequence item
+ * @return The span; empty for a lone '-'
+ */
+YamlSpan YamlScanner::item(const YamlToken &token) const {
+  return {token.offset + token.itemBegin, token.textEnd - token.itemBegin};
+}
+
+/**
+ * @brief Get the key of a sequence item that starts a mapping, as in "- key: value"
+ * @param token A sequence item with hasColon set
+ * @return Trimmed text between the dash and the first ':'
+ */
+YamlSpan YamlScanner::itemKey(const YamlToken &token) const {
+  // "- : value" has an empty item key; the line key is just the dash
+  if (token.keyEnd < token.itemBegin)
+    return {token.offset + token.itemBegin, 0};
+  return {token.offset + token.itemBegin, token.keyEnd - token.itemBegin};
+}
+
+/**
+ * @brief Skips blank lines
+ * @param index 0-based line index to start at
+ * @return Index of the first line at or after index that is not blank, or size() if none
+ */
+size_t YamlScanner::nextNonBlank(size_t index) const {
+  while (index < m_tokens.size() && m_tokens[index].kind == YamlTokenKind::Blank)
+    index++;
+  return index;
+}
+
+/**
+ * @brief Check if the root of the document is a sequence
+ * @return true if the first line that is neither blank nor a comment is a sequence item
+ */
+bool YamlScanner::startsWithSequence() const {
+  for (const auto &token : m_tokens) {
+    if (token.kind == YamlTokenKind::Blank || token.kind == YamlTokenKind::Comment)
+      continue;
+    return token.kind == YamlTokenKind::SequenceItem;
+  }
+  return false;
+}
+
+/**
+ * @brief Tokenizes one line and appends its token
+ * @param begin Offset of the first byte of the line
+ * @param end Offset of the line end ('\n' or the end of the source)
+ * @throws LimitException if the line is too long for 32-bit positions
+ */
+void YamlScanner::scanLine(size_t begin, size_t end) {
+  const char *line = m_source.data() + begin;
+  size_t      size = end - begin;
+  if (size >= MAX_LINE_BYTES)
+    throw LimitException("line bytes", MAX_LINE_BYTES - 1, m_tokens.size() + 1);
+
+  YamlToken token;
+  token.offset = begin;
+  token.line   = static_cast<uint32_t>(m_tokens.size() + 1);
+
+  size_t first = 0;
+  while (first < size && isBlank(line[first]))
+    first++;
+  if (first == size) {
+    m_tokens.push_back(token);
+    return;
+  }
+  size_t last = size;
+  while (isBlank(line[last - 1]))
+    last--;
+
+  token.indent  = static_cast<uint32_t>(first);
+  token.textEnd = static_cast<uint32_t>(last);
+  if (line[first] == '#')
+    token.kind = YamlTokenKind::Comment;
+  else if (line[first] == '-')
+    token.kind = YamlTokenKind::SequenceItem;
+  else
+    token.kind = YamlTokenKind::Entry;
+
+  const void *colon = std::memchr(line + first, ':', last - first);
+  if (colon) {
+    size_t pos        = static_cast<size_t>(static_cast<const char *>(colon) - line);
+    size_t keyEnd     = pos;
+    size_t valueBegin = pos + 1;
+    while (keyEnd > first && isBlank(line[keyEnd - 1]))
+      keyEnd--;
+    while (valueBegin < last && isBlank(line[valueBegin]))
+      valueBegin++;
+    token.hasColon   = true;
+    token.keyEnd     = static_cast<uint32_t>(keyEnd);
+    token.valueBegin = static_cast<uint32_t>(valueBegin);
+  }
+  if (token.kind == YamlTokenKind::SequenceItem) {
+    size_t itemBegin = first + 1;
+    while (itemBegin < last && isBlank(line[itemBegin]))
+      itemBegin++;
+    token.itemBegin = static_cast<uint32_t>(itemBegin);
+  }
+  m_tokens.push_back(token);
+}
+
+} // namespace yamlparser
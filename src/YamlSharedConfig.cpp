@@ -0,0 +1,431 @@
+#include "YamlSharedConfig.hpp"
+#include "YamlException.hpp"
+#include <atomic>
+#include <cstring>
+
+#if defined(__linux__)
+#define YAMLPARSER_HAVE_SHM 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// YamlSharedConfig implementation - snapshot images published in POSIX shared memory
+// Key features:
+// - Every generation gets its own segment that is written once and never
+//   modified, so readers need no locking
+// - A control segment holds the current generation; the publisher advances
+//   it with a release store after the image is complete
+// - The control header is valid once its magic word is set. ftruncate()
+//   zero-fills the segment and the magic is stored last with release, so a
+//   subscriber that attaches in between sees zero and waits, rather than
+//   mistaking the segment for a foreign one
+// - Subscribers retry when the generation they read is replaced before they
+//   open it (its name is unlinked once a newer one is published)
+
+namespace yamlparser {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared generation counter must be lock-free");
+
+/**
+ * @brief Control segment shared by the publisher and all subscribers
+ */
+struct YamlSharedPublisher::Control {
+  /** @brief controlMagic() once the header is initialized, 0 before */
+  std::atomic<std::uint64_t> magic;
+  std::atomic<std::uint64_t> generation;
+};
+
+namespace {
+const char          MAGIC_PREFIX[7] = {'Y', 'A', 'M', 'L', 'S', 'H', 'M'};
+const unsigned char CONTROL_VERSION = 1;
+
+using Control = YamlSharedPublisher::Control;
+
+std::uint64_t controlMagic() {
+  char bytes[8];
+  std::memcpy(bytes, MAGIC_PREFIX, sizeof(MAGIC_PREFIX));
+  bytes[7] = static_cast<char>(CONTROL_VERSION);
+  std::uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+/**
+ * @brief Checks the magic word of a control segment
+ * @param magic Value read from the segment
+ * @param path Segment name, for the error message
+ * @return false if the header is not written yet (magic is 0)
+ * @throws SnapshotException if the segment is foreign or from another layout version
+ */
+bool checkMagic(std::uint64_t magic, const std::string &path) {
+  if (magic == 0)
+    return false;
+  if (magic == controlMagic())
+    return true;
+  char bytes[8];
+  std::memcpy(bytes, &magic, sizeof(bytes));
+  if (std::memcmp(bytes, MAGIC_PREFIX, sizeof(MAGIC_PREFIX)) == 0)
+    throw SnapshotException("segment '" + path + "' uses control layout version " +
+                            std::to_string(static_cast<unsigned char>(bytes[7])) + ", expected " +
+                            std::to_string(CONTROL_VERSION));
+  throw SnapshotException("segment '" + path + "' is not a published document");
+}
+
+void checkName(const std::string &name) {
+  if (name.empty() || name.size() > 200 || name.find('/') != std::string::npos)
+    throw SnapshotException("invalid publication name: '" + name + "'");
+#if !defined(YAMLPARSER_HAVE_SHM)
+  throw SnapshotException("shared memory publication is not supported on this platform");
+#endif
+}
+
+std::string controlName(const std::string &name) {
+  return "/" + name;
+}
+
+std::string segmentName(const std::string &name, std::uint64_t generation) {
+  return "/" + name + "." + std::to_string(generation);
+}
+} // anonymous namespace
+
+/**
+ * @brief Opens (or creates) the control segment of a publication
+ * @param name Publication name (no '/' characters)
+ * @throws SnapshotException if the name is invalid or the platform is unsupported
+ * @throws OutputException if the control segment cannot be created
+ * @details A publisher restarted under the same name continues with the
+ *          next generation number.
+ */
+YamlSharedPublisher::YamlSharedPublisher(const std::string &name) : m_name(name) {
+  checkName(name);
+#if defined(YAMLPARSER_HAVE_SHM)
+  std::string path = controlName(name);
+  int         fd   = ::shm_open(path.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0)
+    throw OutputException("cannot create shared memory segment: " + path);
+  struct stat st;
+  bool        fresh = ::fstat(fd, &st) == 0 && st.st_size == 0;
+  if ((fresh && ::ftruncate(fd, sizeof(Control)) != 0) ||
+      (!fresh && static_cast<size_t>(st.st_size) < sizeof(Control))) {
+    ::close(fd);
+    throw OutputException("cannot size shared memory segment: " + path);
+  }
+  void *mapping = ::mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    throw OutputException("cannot map shared memory segment: " + path);
+
+  // The zero-filled segment is a valid header with generation 0 and no
+  // magic yet. Whichever publisher gets here first publishes the magic; a
+  // segment left half-created by a crashed publisher is completed the same way.
+  m_control           = static_cast<Control *>(mapping);
+  std::uint64_t magic = 0;
+  m_control->magic.compare_exchange_strong(magic, controlMagic(), std::memory_order_acq_rel);
+  try {
+    checkMagic(m_control->magic.load(std::memory_order_acquire), path);
+  } catch (...) {
+    ::munmap(mapping, sizeof(Control));
+    m_control = nullptr;
+    throw;
+  }
+#endif
+}
+
+/**
+ * @brief Destructor - unmaps the control segment; published data stays available
+ */
+YamlSharedPublisher::~YamlSharedPublisher() {
+#if defined(YAMLPARSER_HAVE_SHM)
+  if (m_control)
+    ::munmap(m_control, sizeof(Control));
+#endif
+}
+
+/**
+ * @brief Publishes a mapping as the next generation
+ * @param map The mapping to publish
+ * @return The new generation number
+ * @throws OutputException if the segment cannot be created or written
+ */
+std::uint64_t YamlSharedPublisher::publish(const YamlMap &map) {
+  return publishImage(YamlSnapshot::build(map));
+}
+
+/**
+ * @brief Publishes a sequence as the next generation
+ * @param seq The sequence to publish
+ * @return The new generation number
+ * @throws OutputException if the segment cannot be created or written
+ */
+std::uint64_t YamlSharedPublisher::publish(const YamlSeq &seq) {
+  return publishImage(YamlSnapshot::build(seq));
+}
+
+/**
+ * @brief Publishes the document held by a parser as the next generation
+ * @param parser Parser holding a parsed document
+ * @return The new generation number
+ * @throws OutputException if the segment cannot be created or written
+ */
+std::uint64_t YamlSharedPublisher::publish(const YamlParser &parser) {
+  return parser.isSequenceRoot() ? publish(parser.sequenceRoot()) : publish(parser.root());
+}
+
+/**
+ * @brief Get the most recently published generation
+ * @return Generation number (0 if nothing has been published yet)
+ */
+std::uint64_t YamlSharedPublisher::generation() const {
+  return m_control ? m_control->generation.load(std::memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Writes an image into a new segment and makes it the current generation
+ * @param image Snapshot image bytes
+ * @return The new generation number
+ * @throws OutputException if the segment cannot be created or written
+ */
+std::uint64_t YamlSharedPublisher::publishImage(const std::string &image) {
+#if defined(YAMLPARSER_HAVE_SHM)
+  std::uint64_t previous = m_control->generation.load(std::memory_order_acquire);
+  std::uint64_t next     = previous + 1;
+  std::string   path     = segmentName(m_name, next);
+
+  int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0 && errno == EEXIST) {
+    ::shm_unlink(path.c_str()); // left behind by a publisher that died mid-publish
+    fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (fd < 0)
+    throw OutputException("cannot create shared memory segment: " + path);
+  if (::ftruncate(fd, static_cast<off_t>(image.size())) != 0) {
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    throw OutputException("cannot size shared memory segment: " + path);
+  }
+  void *mapping = ::mmap(nullptr, image.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    throw OutputException("cannot map shared memory segment: " + path);
+  }
+  std::memcpy(mapping, image.data(), image.size());
+  ::munmap(mapping, image.size());
+
+  m_control->generation.store(next, std::memory_order_release);
+  if (previous != 0)
+    ::shm_unlink(segmentName(m_name, previous).c_str());
+  return next;
+#else
+  (void)image;
+  return 0;
+#endif
+}
+
+/**
+ * @brief Deletes the control segment and the current image of a publication
+ * @param name Publication name
+ * @throws SnapshotException if the name is invalid or the platform is unsupported
+ * @details Processes that still map the segments keep their copies.
+ */
+void YamlSharedPublisher::remove(const std::string &name) {
+  checkName(name);
+#if defined(YAMLPARSER_HAVE_SHM)
+  std::string path = controlName(name);
+  int         fd   = ::shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd >= 0) {
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Control)) {
+      void *mapping = ::mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, fd, 0);
+      if (mapping != MAP_FAILED) {
+        const Control *control = static_cast<const Control *>(mapping);
+        std::uint64_t  current = control->generation.load(std::memory_order_acquire);
+        if (current != 0)
+          ::shm_unlink(segmentName(name, current).c_str());
+        ::munmap(mapping, sizeof(Control));
+      }
+    }
+    ::close(fd);
+  }
+  ::shm_unlink(path.c_str());
+#endif
+}
+
+/**
+ * @brief Wraps a mapped image segment
+ * @param generation Generation number of the image
+ * @param mapping Read-only mapping of the segment (owned from now on)
+ * @param size Size of the mapping in bytes
+ * @throws SnapshotException if the image is invalid (the caller unmaps it)
+ */
+YamlSharedDocument::YamlSharedDocument(std::uint64_t generation, void *mapping, size_t size)
+    : m_generation(generation), m_mapping(mapping), m_size(size), m_view(mapping, size) {}
+
+/**
+ * @brief Destructor - unmaps the image
+ */
+YamlSharedDocument::~YamlSharedDocument() {
+#if defined(YAMLPARSER_HAVE_SHM)
+  ::munmap(m_mapping, m_size);
+#endif
+}
+
+/**
+ * @brief Get the generation this document was published as
+ * @return Generation number
+ */
+std::uint64_t YamlSharedDocument::generation() const {
+  return m_generation;
+}
+
+/**
+ * @brief Get the view over the mapped image
+ * @return Reference to the view
+ */
+const YamlSnapshotView &YamlSharedDocument::view() const {
+  return m_view;
+}
+
+/**
+ * @brief Get the root node of the document
+ * @return Handle to the root
+ */
+YamlSnapshotNode YamlSharedDocument::root() const {
+  return m_view.root();
+}
+
+/**
+ * @brief Look up a key of the root mapping
+ * @param key The key to look up
+ * @return Handle to the value
+ * @throws TypeException if the root is not a mapping
+ * @throws KeyException if the key is not present
+ */
+YamlSnapshotNode YamlSharedDocument::get(const std::string &key) const {
+  return m_view.get(key);
+}
+
+/**
+ * @brief Creates a subscriber for a publication name
+ * @param name Publication name (the publisher does not need to exist yet)
+ * @throws SnapshotException if the name is invalid or the platform is unsupported
+ */
+YamlSharedSubscriber::YamlSharedSubscriber(const std::string &name) : m_name(name) {
+  checkName(name);
+}
+
+/**
+ * @brief Destructor - unmaps the control segment; returned documents stay valid
+ */
+YamlSharedSubscriber::~YamlSharedSubscriber() {
+#if defined(YAMLPARSER_HAVE_SHM)
+  if (m_control)
+    ::munmap(const_cast<Control *>(m_control), sizeof(Control));
+#endif
+}
+
+/**
+ * @brief Maps the control segment once the publisher has created it
+ * @return true if the control segment is mapped and initialized
+ * @throws SnapshotException if the segment exists but is not a publication,
+ *         or was created by an incompatible version
+ * @details A segment whose header is not written yet counts as not published;
+ *          the next call tries again.
+ */
+bool YamlSharedSubscriber::attachControl() {
+#if defined(YAMLPARSER_HAVE_SHM)
+  if (m_control)
+    return true;
+  std::string path = controlName(m_name);
+  int         fd   = ::shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Control)) {
+    ::close(fd); // publisher is still creating it
+    return false;
+  }
+  void *mapping = ::mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+  const Control *control = static_cast<const Control *>(mapping);
+  bool           ready   = false;
+  try {
+    ready = checkMagic(control->magic.load(std::memory_order_acquire), path);
+  } catch (...) {
+    ::munmap(mapping, sizeof(Control));
+    throw;
+  }
+  if (!ready) {
+    ::munmap(mapping, sizeof(Control)); // publisher is still initializing it
+    return false;
+  }
+  m_control = control;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Get the generation currently announced by the publisher
+ * @return Generation number (0 if nothing has been published yet)
+ */
+std::uint64_t YamlSharedSubscriber::publishedGeneration() {
+  return attachControl() ? m_control->generation.load(std::memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Get the latest published document, mapping it if it changed
+ * @return The current document, or null if nothing has been published yet
+ * @throws FileException if the announced segment cannot be opened
+ * @throws SnapshotException if the segment does not hold a valid image
+ */
+std::shared_ptr<const YamlSharedDocument> YamlSharedSubscriber::current() {
+#if defined(YAMLPARSER_HAVE_SHM)
+  std::uint64_t generation = publishedGeneration();
+  if (generation == 0)
+    return nullptr;
+  if (m_document && m_document->generation() == generation)
+    return m_document;
+
+  for (;;) {
+    std::string path = segmentName(m_name, generation);
+    int         fd   = ::shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      // Replaced by a newer generation between reading the counter and opening it
+      std::uint64_t latest = m_control->generation.load(std::memory_order_acquire);
+      if (errno == ENOENT && latest != generation) {
+        generation = latest;
+        continue;
+      }
+      throw FileException(path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      throw FileException(path);
+    }
+    size_t size    = static_cast<size_t>(st.st_size);
+    void  *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+      throw FileException(path);
+    try {
+      m_document.reset(new YamlSharedDocument(generation, mapping, size));
+    } catch (...) {
+      ::munmap(mapping, size);
+      throw;
+    }
+    return m_document;
+  }
+#else
+  return nullptr;
+#endif
+}
+
+} // namespace yamlparser
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YAMLPARSER_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @file YamlSimd.hpp
+ * @brief Internal vectorized byte-scanning kernels
+ *
+ * Small scanning primitives used on hot serialization and parsing paths.
+ * Each kernel has an SSE2 implementation that inspects 16 bytes per step
+ * and a portable scalar fallback with identical results.
+ *
+ * This header is private to the library sources.
+ */
+
+namespace yamlparser {
+namespace simd {
+
+/**
+ * @brief Index of the lowest set bit of a non-zero mask
+ */
+inline unsigned int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned int>(index);
+#else
+  return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief Check if a byte must be escaped inside a JSON string
+ */
+inline bool needsJsonEscape(unsigned char c) {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+/**
+ * @brief Finds the first byte that must be escaped in a JSON string
+ * @param data Bytes to scan
+ * @param size Number of bytes
+ * @return Offset of the first control character, '"' or '\\', or size if none
+ */
+inline size_t findJsonEscape(const char *data, size_t size) {
+  size_t i = 0;
+#if defined(YAMLPARSER_HAVE_SSE2)
+  const __m128i quote     = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control   = _mm_set1_epi8(0x1F);
+  for (; i + 16 <= size; i += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    // c <= 0x1F (unsigned) <=> max(c, 0x1F) == 0x1F
+    __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));
+    if (mask != 0)
+      return i + lowestBit(mask);
+  }
+#endif
+  for (; i < size; ++i) {
+    if (needsJsonEscape(static_cast<unsigned char>(data[i])))
+      return i;
+  }
+  return size;
+}
+
+/**
+ * @brief Finds the first byte that is not ASCII
+ * @param data Bytes to scan
+ * @param size Number of bytes
+ * @return Offset of the first byte with the high bit set, or size if none
+ */
+inline size_t findNonAscii(const char *data, size_t size) {
+  size_t i = 0;
+#if defined(YAMLPARSER_HAVE_SSE2)
+  for (; i + 16 <= size; i += 16) {
+    // The sign bit of each byte is the high bit, which movemask gathers directly
+    __m128i      chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    unsigned int mask  = static_cast<unsigned int>(_mm_movemask_epi8(chunk));
+    if (mask != 0)
+      return i + lowestBit(mask);
+  }
+#endif
+  for (; i < size; ++i) {
+    if (static_cast<unsigned char>(data[i]) >= 0x80)
+      return i;
+  }
+  return size;
+}
+
+} // namespace simd
+} // namespace yamlparser
@@ -0,0 +1,714 @@
+#include "YamlSnapshot.hpp"
+#include "YamlAtomicFile.hpp"
+#include "YamlException.hpp"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define YAMLPARSER_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// YamlSnapshot implementation - binary images of parsed documents
+// Key features:
+// - build() lays the tree out breadth-first so every collection's children
+//   form one contiguous run of records, and map children stay sorted by key
+// - Strings and keys are interned in a single pool and referenced by offset,
+//   which keeps the image position-independent
+// - YamlSnapshotView validates an image once, then answers lookups straight
+//   from the mapped bytes (binary search over the sorted map children)
+
+namespace yamlparser {
+
+/**
+ * @brief One node of a snapshot image
+ *
+ * payload holds the first child index (SEQ/MAP), the pool offset of the
+ * value (STRING), the value itself (INT/BOOL) or the bit pattern of the
+ * value (DOUBLE). count holds the number of children or the string length.
+ */
+struct YamlSnapshot::Record {
+  std::uint8_t  type;
+  std::uint8_t  reserved[3];
+  std::uint32_t keyOffset;
+  std::uint32_t keySize;
+  std::uint32_t count;
+  std::uint64_t payload;
+};
+
+namespace {
+const char          MAGIC[8]       = {'Y', 'A', 'M', 'L', 'S', 'N', 'A', 'P'};
+const std::uint32_t VERSION        = 1;
+const std::uint32_t BYTE_ORDER_TAG = 0x01020304;
+
+struct Header {
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t nodeCount;
+  std::uint32_t reserved;
+  std::uint64_t poolSize;
+};
+
+static_assert(sizeof(Header) == 32, "snapshot header must be 32 bytes");
+static_assert(sizeof(YamlSnapshot::Record) == 24, "snapshot record must be 24 bytes");
+
+using Record = YamlSnapshot::Record;
+
+std::uint8_t typeCode(YamlElement::ElementType type) {
+  return static_cast<std::uint8_t>(type);
+}
+
+// Collects records and interned strings while walking a tree breadth-first
+class ImageBuilder {
+public:
+  ImageBuilder() {
+    m_pool.push_back('\0'); // offset 0 is the empty string used for "no key"
+  }
+
+  // Queues the root container or value; children are added by run()
+  void addRoot(YamlElement::ElementType type, const YamlSeq *seq, const YamlMap *map, const YamlElement *element) {
+    m_nodes.push_back(Record());
+    m_sources.push_back({type, seq, map, element});
+  }
+
+  std::string run() {
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+      Source src      = m_sources[i]; // copied: adding children reallocates
+      m_nodes[i].type = typeCode(src.type);
+      switch (src.type) {
+      case YamlElement::ElementType::SEQ: {
+        size_t first = m_nodes.size();
+        for (const auto &item : *src.seq)
+          addChild(nullptr, item.value);
+        setChildren(i, first, src.seq->size());
+        break;
+      }
+      case YamlElement::ElementType::MAP: {
+        size_t first = m_nodes.size();
+        for (const auto &kv : *src.map)
+          addChild(&kv.first, kv.second.value);
+        setChildren(i, first, src.map->size());
+        break;
+      }
+      case YamlElement::ElementType::STRING: {
+        const std::string &s = src.element->asString();
+        m_nodes[i].payload   = intern(s);
+        m_nodes[i].count     = checkedSize(s.size());
+        break;
+      }
+      case YamlElement::ElementType::DOUBLE: {
+        double d = src.element->asDouble();
+        std::memcpy(&m_nodes[i].payload, &d, sizeof(d));
+        break;
+      }
+      case YamlElement::ElementType::INT:
+        m_nodes[i].payload = static_cast<std::uint64_t>(static_cast<std::int64_t>(src.element->asInt()));
+        break;
+      case YamlElement::ElementType::BOOL:
+        m_nodes[i].payload = src.element->asBool() ? 1 : 0;
+        break;
+      default:
+        break;
+      }
+    }
+    return serialize();
+  }
+
+private:
+  struct Source {
+    YamlElement::ElementType type;
+    const YamlSeq           *seq;
+    const YamlMap           *map;
+    const YamlElement       *element;
+  };
+
+  static std::uint32_t checkedSize(size_t size) {
+    if (size > std::numeric_limits<std::uint32_t>::max())
+      throw OutputException("document too large for a snapshot image");
+    return static_cast<std::uint32_t>(size);
+  }
+
+  void addChild(const std::string *key, const YamlElement &value) {
+    Record rec = Record();
+    if (key) {
+      rec.keyOffset = intern(*key);
+      rec.keySize   = checkedSize(key->size());
+    }
+    m_nodes.push_back(rec);
+    m_sources.push_back({value.type, value.type == YamlElement::ElementType::SEQ ? &value.asSeq() : nullptr,
+                         value.type == YamlElement::ElementType::MAP ? &value.asMap() : nullptr, &value});
+  }
+
+  void setChildren(size_t index, size_t first, size_t count) {
+    m_nodes[index].payload = first;
+    m_nodes[index].count   = checkedSize(count);
+  }
+
+  std::uint32_t intern(const std::string &s) {
+    if (s.empty())
+      return 0;
+    auto it = m_offsets.find(s);
+    if (it != m_offsets.end())
+      return it->second;
+    std::uint32_t offset = checkedSize(m_pool.size());
+    m_pool.insert(m_pool.end(), s.begin(), s.end());
+    m_pool.push_back('\0');
+    checkedSize(m_pool.size());
+    m_offsets.emplace(s, offset);
+    return offset;
+  }
+
+  std::string serialize() const {
+    Header header = Header();
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version   = VERSION;
+    header.byteOrder = BYTE_ORDER_TAG;
+    header.nodeCount = checkedSize(m_nodes.size());
+    header.poolSize  = m_pool.size();
+
+    std::string image;
+    image.reserve(sizeof(Header) + m_nodes.size() * sizeof(Record) + m_pool.size());
+    image.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    image.append(reinterpret_cast<const char *>(m_nodes.data()), m_nodes.size() * sizeof(Record));
+    image.append(m_pool.data(), m_pool.size());
+    return image;
+  }
+
+  std::vector<Record>                            m_nodes;
+  std::vector<Source>                            m_sources;
+  std::vector<char>                              m_pool;
+  std::unordered_map<std::string, std::uint32_t> m_offsets;
+};
+
+// Checks that [offset, offset + size] lies inside the pool and ends in a NUL
+bool validString(const char *pool, std::uint64_t poolSize, std::uint64_t offset, std::uint64_t size) {
+  return offset < poolSize && size < poolSize - offset && pool[offset + size] == '\0';
+}
+} // anonymous namespace
+
+/**
+ * @brief Builds a snapshot image of a mapping
+ * @param map The mapping to serialize
+ * @return The image bytes
+ * @throws OutputException if the document exceeds the 4 GiB format limits
+ */
+std::string YamlSnapshot::build(const YamlMap &map) {
+  ImageBuilder builder;
+  builder.addRoot(YamlElement::ElementType::MAP, nullptr, &map, nullptr);
+  return builder.run();
+}
+
+/**
+ * @brief Builds a snapshot image of a sequence
+ * @param seq The sequence to serialize
+ * @return The image bytes
+ * @throws OutputException if the document exceeds the 4 GiB format limits
+ */
+std::string YamlSnapshot::build(const YamlSeq &seq) {
+  ImageBuilder builder;
+  builder.addRoot(YamlElement::ElementType::SEQ, &seq, nullptr, nullptr);
+  return builder.run();
+}
+
+/**
+ * @brief Builds a snapshot image of a single item (scalar or collection)
+ * @param item The item to serialize
+ * @return The image bytes
+ * @throws OutputException if the document exceeds the 4 GiB format limits
+ */
+std::string YamlSnapshot::build(const YamlItem &item) {
+  const YamlElement &v = item.value;
+  ImageBuilder       builder;
+  builder.addRoot(v.type, v.isSeq() ? &v.asSeq() : nullptr, v.isMap() ? &v.asMap() : nullptr, &v);
+  return builder.run();
+}
+
+/**
+ * @brief Writes a snapshot image of a mapping to a file
+ * @param map The mapping to serialize
+ * @param filename Destination file, replaced atomically: readers that already mapped it keep the old image
+ * @throws OutputException if the file cannot be written
+ */
+void YamlSnapshot::save(const YamlMap &map, const std::string &filename) {
+  replaceFileAtomically(build(map), filename, "snapshot file");
+}
+
+/**
+ * @brief Writes a snapshot image of a sequence to a file
+ * @param seq The sequence to serialize
+ * @param filename Destination file, replaced atomically: readers that already mapped it keep the old image
+ * @throws OutputException if the file cannot be written
+ */
+void YamlSnapshot::save(const YamlSeq &seq, const std::string &filename) {
+  replaceFileAtomically(build(seq), filename, "snapshot file");
+}
+
+/**
+ * @brief Creates a handle for one record of an image
+ * @param nodes Start of the node table
+ * @param pool Start of the string pool
+ * @param record The record this handle refers to
+ */
+YamlSnapshotNode::YamlSnapshotNode(const Record *nodes, const char *pool, const Record *record)
+    : m_nodes(nodes), m_pool(pool), m_record(record) {}
+
+/**
+ * @brief Get the type of the node
+ * @return The element type stored in the image
+ */
+YamlElement::ElementType YamlSnapshotNode::type() const {
+  return static_cast<YamlElement::ElementType>(m_record->type);
+}
+
+bool YamlSnapshotNode::isNull() const {
+  return type() == YamlElement::ElementType::NONE;
+}
+
+bool YamlSnapshotNode::isString() const {
+  return type() == YamlElement::ElementType::STRING;
+}
+
+bool YamlSnapshotNode::isDouble() const {
+  return type() == YamlElement::ElementType::DOUBLE;
+}
+
+bool YamlSnapshotNode::isInt() const {
+  return type() == YamlElement::ElementType::INT;
+}
+
+bool YamlSnapshotNode::isBool() const {
+  return type() == YamlElement::ElementType::BOOL;
+}
+
+bool YamlSnapshotNode::isSeq() const {
+  return type() == YamlElement::ElementType::SEQ;
+}
+
+bool YamlSnapshotNode::isMap() const {
+  return type() == YamlElement::ElementType::MAP;
+}
+
+bool YamlSnapshotNode::isScalar() const {
+  return !isSeq() && !isMap();
+}
+
+/**
+ * @brief Get the string value as a new std::string
+ * @return Copy of the string value
+ * @throws TypeException if node is not a string
+ */
+std::string YamlSnapshotNode::asString() const {
+  return std::string(c_str(), stringSize());
+}
+
+/**
+ * @brief Get the string value without copying it
+ * @return Pointer to the NUL-terminated value inside the image
+ * @throws TypeException if node is not a string
+ */
+const char *YamlSnapshotNode::c_str() const {
+  if (!isString())
+    throw TypeException("Expected string, but element is not a string");
+  return m_pool + m_record->payload;
+}
+
+/**
+ * @brief Get the length of the string value
+ * @return Length in bytes, excluding the terminating NUL
+ * @throws TypeException if node is not a string
+ */
+size_t YamlSnapshotNode::stringSize() const {
+  if (!isString())
+    throw TypeException("Expected string, but element is not a string");
+  return m_record->count;
+}
+
+/**
+ * @brief Get the double value
+ * @return The stored double
+ * @throws TypeException if node is not a double
+ */
+double YamlSnapshotNode::asDouble() const {
+  if (!isDouble())
+    throw TypeException("Expected double, but element is not a double");
+  double d;
+  std::memcpy(&d, &m_record->payload, sizeof(d));
+  return d;
+}
+
+/**
+ * @brief Get the integer value
+ * @return The stored integer
+ * @throws TypeException if node is not an integer
+ */
+int YamlSnapshotNode::asInt() const {
+  if (!isInt())
+    throw TypeException("Expected integer, but element is not an integer");
+  return static_cast<int>(static_cast<std::int64_t>(m_record->payload));
+}
+
+/**
+ * @brief Get the boolean value
+ * @return The stored boolean
+ * @throws TypeException if node is not a boolean
+ */
+bool YamlSnapshotNode::asBool() const {
+  if (!isBool())
+    throw TypeException("Expected boolean, but element is not a boolean");
+  return m_record->payload != 0;
+}
+
+/**
+ * @brief Get the number of children of a collection
+ * @return Number of entries (0 for scalars)
+ */
+size_t YamlSnapshotNode::size() const {
+  return isScalar() ? 0 : m_record->count;
+}
+
+/**
+ * @brief Access a child of a sequence (or a map entry in key order) by index
+ * @param index Zero-based child index
+ * @return Handle to the child
+ * @throws TypeException if node is not a collection
+ * @throws IndexException if index is out of bounds
+ */
+YamlSnapshotNode YamlSnapshotNode::at(size_t index) const {
+  if (isScalar())
+    throw TypeException("Expected sequence, but element is not a sequence");
+  if (index >= m_record->count)
+    throw IndexException(index, m_record->count);
+  return YamlSnapshotNode(m_nodes, m_pool, m_nodes + m_record->payload + index);
+}
+
+/**
+ * @brief Access a map entry by key
+ * @param key The key to look up
+ * @return Handle to the value
+ * @throws TypeException if node is not a mapping
+ * @throws KeyException if the key is not present
+ */
+YamlSnapshotNode YamlSnapshotNode::at(const std::string &key) const {
+  const Record *found = find(key.data(), key.size());
+  if (!found)
+    throw KeyException(key);
+  return YamlSnapshotNode(m_nodes, m_pool, found);
+}
+
+/**
+ * @brief Check whether a map contains a key
+ * @param key The key to look up
+ * @return true if the key is present
+ * @throws TypeException if node is not a mapping
+ */
+bool YamlSnapshotNode::contains(const std::string &key) const {
+  return find(key.data(), key.size()) != nullptr;
+}
+
+/**
+ * @brief Get the key of a map entry by index (keys are in sorted order)
+ * @param index Zero-based entry index
+ * @return Copy of the key
+ * @throws TypeException if node is not a mapping
+ * @throws IndexException if index is out of bounds
+ */
+std::string YamlSnapshotNode::keyAt(size_t index) const {
+  if (!isMap())
+    throw TypeException("Expected mapping, but element is not a mapping");
+  const Record *child = at(index).m_record;
+  return std::string(m_pool + child->keyOffset, child->keySize);
+}
+
+/**
+ * @brief Binary search over the sorted children of a map
+ * @param key Key bytes
+ * @param keySize Key length
+ * @return Matching child record, or null if absent
+ * @throws TypeException if node is not a mapping
+ */
+const YamlSnapshot::Record *YamlSnapshotNode::find(const char *key, size_t keySize) const {
+  if (!isMap())
+    throw TypeException("Expected mapping, but element is not a mapping");
+  const Record *lo = m_nodes + m_record->payload;
+  const Record *hi = lo + m_record->count;
+  while (lo < hi) {
+    const Record *mid    = lo + (hi - lo) / 2;
+    size_t        common = mid->keySize < keySize ? mid->keySize : keySize;
+    int           cmp    = std::memcmp(m_pool + mid->keyOffset, key, common);
+    if (cmp == 0)
+      cmp = mid->keySize < keySize ? -1 : (mid->keySize > keySize ? 1 : 0);
+    if (cmp == 0)
+      return mid;
+    if (cmp < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Converts the subtree rooted at this node into an ordinary tree
+ * @return A deep copy of the subtree as a YamlItem
+ */
+YamlItem YamlSnapshotNode::toItem() const {
+  switch (type()) {
+  case YamlElement::ElementType::STRING:
+    return YamlItem(YamlElement(asString()));
+  case YamlElement::ElementType::DOUBLE:
+    return YamlItem(YamlElement(asDouble()));
+  case YamlElement::ElementType::INT:
+    return YamlItem(YamlElement(asInt()));
+  case YamlElement::ElementType::BOOL:
+    return YamlItem(YamlElement(asBool()));
+  case YamlElement::ElementType::SEQ: {
+    // Fill the element's own storage so that no level is copied twice
+    YamlItem item{YamlElement(YamlSeq())};
+    YamlSeq &seq = *item.value.data.seq;
+    seq.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+      seq.push_back(at(i).toItem());
+    return item;
+  }
+  case YamlElement::ElementType::MAP: {
+    YamlItem item{YamlElement(YamlMap())};
+    YamlMap &map = *item.value.data.map;
+    for (size_t i = 0; i < size(); ++i)
+      map.emplace_hint(map.end(), keyAt(i), at(i).toItem());
+    return item;
+  }
+  default:
+    return YamlItem();
+  }
+}
+
+/**
+ * @brief Opens a snapshot file, mapping it read-only into memory
+ * @param filename Path of the image file
+ * @throws FileException if the file cannot be opened or read
+ * @throws SnapshotException if the image is invalid
+ * @details Falls back to reading the file into memory on platforms
+ *          without mmap.
+ */
+YamlSnapshotView::YamlSnapshotView(const std::string &filename) {
+#if defined(YAMLPARSER_HAVE_MMAP)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw FileException(filename);
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    throw FileException(filename);
+  }
+  size_t size    = static_cast<size_t>(st.st_size);
+  void  *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    throw FileException(filename);
+  m_mapping = mapping;
+  try {
+    attach(mapping, size);
+  } catch (...) {
+    release();
+    throw;
+  }
+#else
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw FileException(filename);
+  std::streamoff end = file.tellg();
+  if (end <= 0)
+    throw FileException(filename);
+  size_t size = static_cast<size_t>(end);
+  m_heapCopy.reset(new std::uint64_t[(size + 7) / 8]);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(m_heapCopy.get()), end))
+    throw FileException(filename);
+  attach(m_heapCopy.get(), size);
+#endif
+}
+
+/**
+ * @brief Creates a view over an image held in caller-owned memory
+ * @param data Start of the image (8-byte aligned, must outlive the view)
+ * @param size Size of the image in bytes
+ * @throws SnapshotException if the image is invalid
+ */
+YamlSnapshotView::YamlSnapshotView(const void *data, size_t size) {
+  attach(data, size);
+}
+
+/**
+ * @brief Destructor - unmaps the file if the view owns a mapping
+ */
+YamlSnapshotView::~YamlSnapshotView() {
+  release();
+}
+
+/**
+ * @brief Move constructor - transfers ownership of the mapping
+ */
+YamlSnapshotView::YamlSnapshotView(YamlSnapshotView &&other) noexcept
+    : m_data(other.m_data), m_size(other.m_size), m_nodeCount(other.m_nodeCount), m_mapping(other.m_mapping),
+      m_heapCopy(std::move(other.m_heapCopy)) {
+  other.m_data      = nullptr;
+  other.m_size      = 0;
+  other.m_nodeCount = 0;
+  other.m_mapping   = nullptr;
+}
+
+/**
+ * @brief Move assignment - releases the current image and takes the other one
+ */
+YamlSnapshotView &YamlSnapshotView::operator=(YamlSnapshotView &&other) noexcept {
+  if (this != &other) {
+    release();
+    m_data            = other.m_data;
+    m_size            = other.m_size;
+    m_nodeCount       = other.m_nodeCount;
+    m_mapping         = other.m_mapping;
+    m_heapCopy        = std::move(other.m_heapCopy);
+    other.m_data      = nullptr;
+    other.m_size      = 0;
+    other.m_nodeCount = 0;
+    other.m_mapping   = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Validates an image and records its location
+ * @param data Start of the image
+ * @param size Size of the image in bytes
+ * @throws SnapshotException if any header field, node or string reference is invalid
+ * @details Children must come after their parent in the node table, which
+ *          rules out cycles and makes every traversal terminate.
+ */
+void YamlSnapshotView::attach(const void *data, size_t size) {
+  if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t) != 0)
+    throw SnapshotException("image is not 8-byte aligned");
+  if (size < sizeof(Header))
+    throw SnapshotException("image is truncated");
+  Header header;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw SnapshotException("not a snapshot image");
+  if (header.version != VERSION)
+    throw SnapshotException("unsupported version " + std::to_string(header.version));
+  if (header.byteOrder != BYTE_ORDER_TAG)
+    throw SnapshotException("image was written with a different byte order");
+  if (header.nodeCount == 0)
+    throw SnapshotException("image has no root node");
+
+  std::uint64_t tableSize = static_cast<std::uint64_t>(header.nodeCount) * sizeof(Record);
+  if (header.poolSize == 0 || size - sizeof(Header) < tableSize ||
+      size - sizeof(Header) - tableSize != header.poolSize)
+    throw SnapshotException("image size does not match its header");
+
+  const char   *bytes = static_cast<const char *>(data);
+  const Record *nodes = reinterpret_cast<const Record *>(static_cast<const void *>(bytes + sizeof(Header)));
+  const char   *pool  = bytes + sizeof(Header) + tableSize;
+  if (pool[header.poolSize - 1] != '\0')
+    throw SnapshotException("string pool is not terminated");
+
+  for (std::uint64_t i = 0; i < header.nodeCount; ++i) {
+    const Record &rec = nodes[i];
+    if (!validString(pool, header.poolSize, rec.keyOffset, rec.keySize))
+      throw SnapshotException("key of node " + std::to_string(i) + " is out of range");
+    switch (static_cast<YamlElement::ElementType>(rec.type)) {
+    case YamlElement::ElementType::NONE:
+    case YamlElement::ElementType::DOUBLE:
+    case YamlElement::ElementType::INT:
+    case YamlElement::ElementType::BOOL:
+      break;
+    case YamlElement::ElementType::STRING:
+      if (!validString(pool, header.poolSize, rec.payload, rec.count))
+        throw SnapshotException("string of node " + std::to_string(i) + " is out of range");
+      break;
+    case YamlElement::ElementType::SEQ:
+    case YamlElement::ElementType::MAP:
+      if (rec.payload <= i || rec.payload > header.nodeCount || rec.count > header.nodeCount - rec.payload)
+        throw SnapshotException("children of node " + std::to_string(i) + " are out of range");
+      break;
+    default:
+      throw SnapshotException("node " + std::to_string(i) + " has an unknown type");
+    }
+  }
+
+  m_data      = bytes;
+  m_size      = size;
+  m_nodeCount = header.nodeCount;
+}
+
+/**
+ * @brief Unmaps the file or frees the heap copy
+ */
+void YamlSnapshotView::release() {
+#if defined(YAMLPARSER_HAVE_MMAP)
+  if (m_mapping)
+    ::munmap(m_mapping, m_size);
+#endif
+  m_mapping = nullptr;
+  m_heapCopy.reset();
+  m_data      = nullptr;
+  m_size      = 0;
+  m_nodeCount = 0;
+}
+
+/**
+ * @brief Check if the root element is a sequence
+ * @return true if the root is a sequence, false otherwise
+ */
+bool YamlSnapshotView::isSequenceRoot() const {
+  return root().isSeq();
+}
+
+/**
+ * @brief Get the root node of the image
+ * @return Handle to the root
+ * @throws SnapshotException if the view holds no image (e.g. after a move)
+ */
+YamlSnapshotNode YamlSnapshotView::root() const {
+  if (!m_data)
+    throw SnapshotException("view holds no image");
+  const Record *nodes = reinterpret_cast<const Record *>(static_cast<const void *>(m_data + sizeof(Header)));
+  const char   *pool  = m_data + sizeof(Header) + m_nodeCount * sizeof(Record);
+  return YamlSnapshotNode(nodes, pool, nodes);
+}
+
+/**
+ * @brief Look up a key of the root mapping
+ * @param key The key to look up
+ * @return Handle to the value
+ * @throws TypeException if the root is not a mapping
+ * @throws KeyException if the key is not present
+ */
+YamlSnapshotNode YamlSnapshotView::get(const std::string &key) const {
+  return root().at(key);
+}
+
+/**
+ * @brief Get the number of nodes in the image
+ * @return Node count, including the root
+ */
+size_t YamlSnapshotView::nodeCount() const {
+  return m_nodeCount;
+}
+
+/**
+ * @brief Get the size of the image
+ * @return Size in bytes
+ */
+size_t YamlSnapshotView::imageSize() const {
+  return m_size;
+}
+
+} // namespace yamlparser
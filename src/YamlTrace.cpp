@@ -0,0 +1,218 @@
+#include "YamlTrace.hpp"
+#include "YamlException.hpp"
+#include "YamlJsonPrinter.hpp"
+#include <algorithm>
+#include <fstream>
+
+// YamlTrace implementation - event collection and Chrome trace-event output
+// Key features:
+// - The current tracer is a thread-local pointer, like the current memory
+//   resource, so disabled trace points cost one load and a branch
+// - Spans take their timestamps from the tracer's steady clock and take the
+//   lock only once, when the event is recorded
+// - Output is the JSON object format of the trace-event specification:
+//   complete ("X") events plus process and thread name metadata
+
+namespace yamlparser {
+
+namespace {
+thread_local YamlTracer *t_tracer = nullptr;
+
+// Trace viewers group events by process and thread id; one process is enough
+const int TRACE_PID = 1;
+
+int lineArg(size_t line) {
+  return static_cast<int>(std::min(line, static_cast<size_t>(2147483647)));
+}
+
+void writeMetadata(YamlJsonEmitter &json, const char *name, unsigned thread, const std::string &value) {
+  json.beginMap();
+  json.key("name").value(name);
+  json.key("ph").value("M");
+  json.key("pid").value(TRACE_PID);
+  json.key("tid").value(static_cast<int>(thread));
+  json.key("args").beginMap().key("name").value(value).end();
+  json.end();
+}
+
+void writeEvent(YamlJsonEmitter &json, const YamlTraceEvent &event) {
+  json.beginMap();
+  json.key("name").value(event.name);
+  json.key("cat").value(event.category);
+  json.key("ph").value("X");
+  json.key("ts").value(event.startMicros);
+  json.key("dur").value(event.durationMicros);
+  json.key("pid").value(TRACE_PID);
+  json.key("tid").value(static_cast<int>(event.thread));
+  json.key("args").beginMap();
+  if (event.firstLine > 0) {
+    json.key("first_line").value(lineArg(event.firstLine));
+    json.key("last_line").value(lineArg(std::max(event.lastLine, event.firstLine)));
+  }
+  if (!event.detail.empty())
+    json.key("detail").value(event.detail);
+  json.end();
+  json.end();
+}
+} // anonymous namespace
+
+/**
+ * @brief Constructs an empty tracer; its creation time is the trace's time origin
+ * @param sectionDepth Nesting depth down to which mapping and sequence entries get their own event
+ */
+YamlTracer::YamlTracer(size_t sectionDepth)
+    : m_sectionDepth(sectionDepth), m_origin(std::chrono::steady_clock::now()) {}
+
+/**
+ * @brief Get the nesting depth down to which entries are traced
+ * @return Depth (1 = top-level entries only, 0 = none)
+ */
+size_t YamlTracer::sectionDepth() const {
+  return m_sectionDepth;
+}
+
+/**
+ * @brief Get the current time on the trace's clock
+ * @return Microseconds since the tracer was created
+ */
+double YamlTracer::nowMicros() const {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+/**
+ * @brief Adds a completed event
+ * @param event Event to add; its thread number is assigned here
+ */
+void YamlTracer::record(YamlTraceEvent event) {
+  std::thread::id             self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto                        it = std::find(m_threads.begin(), m_threads.end(), self);
+  if (it == m_threads.end())
+    it = m_threads.insert(m_threads.end(), self);
+  event.thread = static_cast<unsigned>(it - m_threads.begin()) + 1;
+  m_events.push_back(std::move(event));
+}
+
+/**
+ * @brief Get a copy of the recorded events
+ * @return Events in order of completion (nested events precede their parents)
+ */
+std::vector<YamlTraceEvent> YamlTracer::events() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_events;
+}
+
+/**
+ * @brief Discards all recorded events; the time origin is kept
+ */
+void YamlTracer::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.clear();
+}
+
+/**
+ * @brief Writes the events as a Chrome trace-event JSON object
+ * @param os Stream to write to
+ * @throws OutputException if the stream fails
+ */
+void YamlTracer::write(std::ostream &os) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  {
+    YamlJsonEmitter json(os);
+    json.beginMap();
+    json.key("displayTimeUnit").value("ms");
+    json.key("traceEvents").beginSeq();
+    writeMetadata(json, "process_name", 0, "yamlparser");
+    for (size_t i = 0; i < m_threads.size(); ++i)
+      writeMetadata(json, "thread_name", static_cast<unsigned>(i + 1), "thread " + std::to_string(i + 1));
+    for (const auto &event : m_events)
+      writeEvent(json, event);
+    json.end();
+    json.end();
+  }
+  os << '\n';
+  if (!os)
+    throw OutputException("failed to write trace events");
+}
+
+/**
+ * @brief Writes the events as a Chrome trace-event JSON file
+ * @param filename File to create or overwrite
+ * @throws FileException if the file cannot be written
+ */
+void YamlTracer::writeFile(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw FileException(filename);
+  write(file);
+  file.close();
+  if (!file)
+    throw FileException(filename);
+}
+
+/**
+ * @brief Get the tracer of the calling thread
+ * @return The innermost YamlTraceScope's tracer, or null when not tracing
+ */
+YamlTracer *currentTracer() noexcept {
+  return t_tracer;
+}
+
+/**
+ * @brief Makes a tracer current for the calling thread
+ * @param tracer Tracer to record into; null disables tracing
+ */
+YamlTraceScope::YamlTraceScope(YamlTracer *tracer) noexcept : m_previous(t_tracer) {
+  t_tracer = tracer;
+}
+
+/**
+ * @brief Restores the previously current tracer
+ */
+YamlTraceScope::~YamlTraceScope() {
+  t_tracer = m_previous;
+}
+
+/**
+ * @brief Renames the event
+ * @param name New name; only worth building when active() is true
+ */
+void YamlTraceSpan::setName(const std::string &name) {
+  if (m_tracer)
+    m_event.name = name;
+}
+
+/**
+ * @brief Attaches additional information to the event
+ * @param detail Text shown in the event's arguments
+ */
+void YamlTraceSpan::setDetail(const std::string &detail) {
+  if (m_tracer)
+    m_event.detail = detail;
+}
+
+/**
+ * @brief Drops the event; nothing is recorded
+ */
+void YamlTraceSpan::cancel() {
+  m_tracer = nullptr;
+}
+
+void YamlTraceSpan::start(const char *category, const std::string &name, size_t firstLine) {
+  m_event.name        = name;
+  m_event.category    = category;
+  m_event.firstLine   = firstLine;
+  m_event.lastLine    = firstLine;
+  m_event.startMicros = m_tracer->nowMicros();
+}
+
+void YamlTraceSpan::finish() noexcept {
+  m_event.durationMicros = m_tracer->nowMicros() - m_event.startMicros;
+  try {
+    m_tracer->record(std::move(m_event));
+  } catch (...) {
+    // Losing an event is preferable to terminating from a destructor
+  }
+}
+
+} // namespace yamlparser
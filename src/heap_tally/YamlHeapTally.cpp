@@ -0,0 +1,82 @@
+#include "YamlMemory.hpp"
+#include <cstdlib>
+#include <new>
+
+// Heap tally - reports every global heap allocation to YamlAllocationTally
+// Key features:
+// - Replaces global operator new/delete for the program it is linked into,
+//   so tallies (and ParseStats) also see the standard containers and strings
+//   of the tree, which do not allocate from a YamlMemoryResource
+// - Each block carries a small header with its size so that frees can be
+//   subtracted from the live byte count
+// - Built as a separate object library that programs opt into; the library
+//   itself never replaces the allocator of its users
+
+namespace {
+// Header size keeps the returned pointer aligned for any fundamental type
+const size_t HEADER_SIZE = 16;
+
+void *tallyAlloc(size_t size) noexcept {
+  void *block = std::malloc(size + HEADER_SIZE);
+  if (!block)
+    return nullptr;
+  *static_cast<size_t *>(block) = size;
+  yamlparser::tallyHeapAllocation(size);
+  return static_cast<char *>(block) + HEADER_SIZE;
+}
+
+void tallyFree(void *ptr) noexcept {
+  if (!ptr)
+    return;
+  void *block = static_cast<char *>(ptr) - HEADER_SIZE;
+  yamlparser::tallyHeapDeallocation(*static_cast<size_t *>(block));
+  std::free(block);
+}
+
+void *throwingAlloc(size_t size) {
+  void *ptr = tallyAlloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+} // anonymous namespace
+
+void *operator new(size_t size) {
+  return throwingAlloc(size);
+}
+
+void *operator new[](size_t size) {
+  return throwingAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return tallyAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return tallyAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  tallyFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  tallyFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  tallyFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  tallyFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  tallyFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  tallyFree(ptr);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "YamlAsyncParse.hpp"
+#include "YamlException.hpp"
+#include "YamlTrace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlAsyncParseTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  // An executor that queues tasks until the test runs them, like an event loop
+  struct ManualExecutor {
+    std::vector<std::function<void()>> tasks;
+
+    YamlExecutor executor() {
+      return [this](std::function<void()> task) { tasks.push_back(std::move(task)); };
+    }
+
+    void runAll() {
+      for (auto &task : tasks)
+        task();
+      tasks.clear();
+    }
+  };
+
+  static std::string document(size_t entries) {
+    std::string text;
+    for (size_t i = 0; i < entries; ++i)
+      text += "key" + std::to_string(i) + ":\n  value: " + std::to_string(i) + "\n";
+    return text;
+  }
+};
+
+TEST_F(YamlAsyncParseTest, ParsesOnSharedPool) {
+  std::future<YamlParser> pending = parseStringAsync("name: api\nports: [80, 443]\n");
+  YamlParser              parser  = pending.get();
+  EXPECT_EQ(parser.root().at("name").value.asString(), "api");
+  EXPECT_EQ(parser.root().at("ports").value.asSeq()[1].value.asInt(), 443);
+
+  std::string path = "async_parse_test.yaml";
+  {
+    std::ofstream out(path);
+    out << "- a\n- b\n";
+  }
+  parser = parseAsync(path).get();
+  std::remove(path.c_str());
+  EXPECT_TRUE(parser.isSequenceRoot());
+  EXPECT_EQ(parser.sequenceRoot().size(), 2u);
+
+  EXPECT_THROW(parseAsync("does_not_exist.yaml").get(), FileException);
+  EXPECT_THROW(parseStringAsync("a: 1\nb\n").get(), SyntaxException);
+}
+
+TEST_F(YamlAsyncParseTest, RunsOnUserExecutor) {
+  ManualExecutor    loop;
+  AsyncParseOptions options;
+  options.executor        = loop.executor();
+  options.limits.maxNodes = 3;
+
+  std::future<YamlParser> small = parseStringAsync("a: 1\n", options);
+  std::future<YamlParser> large = parseStringAsync(document(10), options);
+  EXPECT_EQ(small.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+  ASSERT_EQ(loop.tasks.size(), 2u);
+
+  loop.runAll();
+  EXPECT_EQ(small.get().root().at("a").value.asInt(), 1);
+  EXPECT_THROW(large.get(), LimitException);
+
+  YamlThreadPool pool(2);
+  EXPECT_EQ(pool.size(), 2u);
+  options.executor = pool.executor();
+  options.limits   = ParseLimits();
+  EXPECT_EQ(parseStringAsync(document(100), options).get().root().size(), 100u);
+}
+
+TEST_F(YamlAsyncParseTest, ReportsProgressBetweenTopLevelEntries) {
+  ManualExecutor      loop;
+  AsyncParseOptions   options;
+  std::vector<size_t> consumed;
+  size_t              total = 0;
+  options.executor          = loop.executor();
+  options.onProgress        = [&](size_t done, size_t size) {
+    consumed.push_back(done);
+    total = size;
+  };
+
+  std::string             text    = "\xEF\xBB\xBF" + document(5);
+  std::future<YamlParser> pending = parseStringAsync(text, options);
+  loop.runAll();
+  EXPECT_EQ(pending.get().root().size(), 5u);
+
+  // One call per entry of the root mapping, then one at the end
+  EXPECT_EQ(total, text.size() - 3);
+  ASSERT_EQ(consumed.size(), 6u);
+  EXPECT_EQ(consumed.front(), 0u);
+  EXPECT_TRUE(std::is_sorted(consumed.begin(), consumed.end()));
+  EXPECT_EQ(consumed.back(), total);
+}
+
+TEST_F(YamlAsyncParseTest, CancelsBeforeAndDuringTheParse) {
+  ManualExecutor    loop;
+  AsyncParseOptions options;
+  options.executor = loop.executor();
+
+  std::future<YamlParser> before = parseStringAsync(document(3), options);
+  options.cancellation.cancel();
+  loop.runAll();
+  EXPECT_THROW(before.get(), CancelledException);
+
+  // Cancelling from the progress handler stops at the next top-level entry
+  AsyncParseOptions during;
+  YamlCancellation  cancel = during.cancellation;
+  size_t            calls  = 0;
+  during.executor          = loop.executor();
+  during.onProgress        = [&](size_t, size_t) {
+    if (++calls == 2)
+      cancel.cancel();
+  };
+  std::future<YamlParser> pending = parseStringAsync(document(50), during);
+  loop.runAll();
+  EXPECT_THROW(pending.get(), CancelledException);
+  EXPECT_EQ(calls, 2u);
+  EXPECT_TRUE(cancel.cancelled());
+}
+
+TEST_F(YamlAsyncParseTest, WorkerUsesCallersTracer) {
+  YamlTracer        tracer;
+  YamlThreadPool    pool(1);
+  AsyncParseOptions options;
+  options.executor = pool.executor();
+
+  YamlParser parser;
+  {
+    YamlTraceScope traceScope(&tracer);
+    parser = parseStringAsync("service:\n  ports: [80, 443]\n", options).get();
+  }
+  EXPECT_EQ(parser.root().at("service").value.asMap().size(), 1u);
+  EXPECT_FALSE(tracer.events().empty());
+
+  // Without a scope at launch, the worker does not trace
+  size_t events = tracer.events().size();
+  parser        = parseStringAsync("a: {b: 1}\n", options).get();
+  EXPECT_EQ(tracer.events().size(), events);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "YamlBlockScalar.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <string>
+
+using namespace yamlparser;
+
+class YamlBlockScalarTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  std::string value(const std::string &text, const std::string &key = "a") {
+    parser.parseString(text);
+    return parser.root().at(key).value.asString();
+  }
+
+  YamlParser parser;
+};
+
+TEST_F(YamlBlockScalarTest, ChompingIndicators) {
+  EXPECT_EQ(value("a: |\n  x\n  y\n\n\nb: 1\n"), "x\ny\n");
+  EXPECT_EQ(value("a: |-\n  x\n  y\n\nb: 1\n"), "x\ny");
+  EXPECT_EQ(value("a: |+\n  x\n  y\n\n\nb: 1\n"), "x\ny\n\n\n");
+  EXPECT_EQ(value("a: >\n  x\n  y\n\nb: 1\n"), "x y\n");
+  EXPECT_EQ(value("a: >\n  a\n  b\n"), "a b\n");
+  EXPECT_EQ(value("a: >-\n  x\n  y\nb: 1\n"), "x y");
+  EXPECT_EQ(value("a: >+\n  x\n  y\n\n"), "x y\n\n");
+  EXPECT_EQ(value("a: |+\n\n\nb: 1\n"), "\n\n");
+  EXPECT_EQ(value("a: |\nb: 1\n"), "");
+}
+
+TEST_F(YamlBlockScalarTest, KeepsRelativeIndentationAndBlankLines) {
+  EXPECT_EQ(value("a: |\n  def f():\n      return 1\n\n  f()  \nb: 2\n"), "def f():\n    return 1\n\nf()  \n");
+  EXPECT_EQ(value("a: |\n\n  # not a comment\n  x\n"), "\n# not a comment\nx\n");
+  EXPECT_EQ(parser.root().size(), 1u);
+}
+
+TEST_F(YamlBlockScalarTest, IndentationIndicator) {
+  EXPECT_EQ(value("a: |2\n    leading\n  x\nb: 1\n"), "  leading\nx\n");
+  EXPECT_EQ(value("a: |1-\n   x\n"), "  x");
+  EXPECT_EQ(value("a: >-2 # comment\n    x\n  y\n"), "  x\ny");
+}
+
+TEST_F(YamlBlockScalarTest, FoldingKeepsBreaksAroundBlankAndMoreIndentedLines) {
+  EXPECT_EQ(value("a: >-\n  one\n  two\n\n  three\n    code\n  four\n"), "one two\nthree\n  code\nfour");
+  EXPECT_EQ(value("a: >-\n\n  x\n\n\n  y\n"), "\nx\n\ny");
+}
+
+TEST_F(YamlBlockScalarTest, SequenceItems) {
+  parser.parseString("steps:\n  - |\n    make\n      all\n  - >-\n    a\n    b\n  - plain\n");
+  const YamlSeq &steps = parser.root().at("steps").value.asSeq();
+  ASSERT_EQ(steps.size(), 3u);
+  EXPECT_EQ(steps[0].value.asString(), "make\n  all\n");
+  EXPECT_EQ(steps[1].value.asString(), "a b");
+  EXPECT_EQ(steps[2].value.asString(), "plain");
+}
+
+TEST_F(YamlBlockScalarTest, MalformedHeaders) {
+  EXPECT_THROW(parser.parseString("a: |x\n  y\n"), SyntaxException);
+  EXPECT_THROW(parser.parseString("a: |--\n  y\n"), SyntaxException);
+  EXPECT_THROW(parser.parseString("a: |0\n  y\n"), SyntaxException);
+  EXPECT_THROW(parser.parseString("a: >text\n  y\n"), SyntaxException);
+  EXPECT_NO_THROW(parser.parseString("a: |+9 #note\n          y\n"));
+}
+
+TEST_F(YamlBlockScalarTest, MeasuresBeforeCopying) {
+  std::string     text = "a: |-\n  x\n\n    y\nb: 1\n";
+  YamlScanner     tokens(text);
+  YamlBlockScalar block(tokens, 0, 0, "|-");
+  EXPECT_EQ(block.style(), '|');
+  EXPECT_EQ(block.chomping(), YamlChomping::Strip);
+  EXPECT_EQ(block.indent(), 2u);
+  EXPECT_EQ(block.end(), 4u);
+  EXPECT_EQ(block.size(), 6u);
+  EXPECT_EQ(block.str(), "x\n\n  y");
+
+  // A block over the scalar limit is rejected from its measured size
+  ParseLimits limits;
+  limits.maxScalarBytes = 1024;
+  YamlParser  limited(limits);
+  std::string big = "cert: |\n";
+  for (int i = 0; i < 100; ++i)
+    big += "  MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA\n";
+  EXPECT_THROW(limited.parseString(big), LimitException);
+
+  parser.parseString(big);
+  EXPECT_EQ(parser.root().at("cert").value.asString().size(), 100u * 45u);
+}
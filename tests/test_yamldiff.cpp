@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "YamlDiff.hpp"
+#include "YamlElement.hpp"
+#include <string>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlDiffTest : public ::testing::Test {
+protected:
+  // Build a small config tree: { server: { host, port }, hosts: [a, b], debug }
+  YamlMap makeConfig() {
+    YamlMap server;
+    server["host"] = YamlItem(YamlElement(std::string("localhost")));
+    server["port"] = YamlItem(YamlElement(8080));
+
+    YamlSeq hosts;
+    hosts.push_back(YamlItem(YamlElement(std::string("a"))));
+    hosts.push_back(YamlItem(YamlElement(std::string("b"))));
+
+    YamlMap root;
+    root["server"] = YamlItem(YamlElement(server));
+    root["hosts"]  = YamlItem(YamlElement(hosts));
+    root["debug"]  = YamlItem(YamlElement(false));
+    return root;
+  }
+};
+
+TEST_F(YamlDiffTest, IdenticalTreesHaveEqualHashesAndNoDiff) {
+  YamlMap a = makeConfig();
+  YamlMap b = makeConfig();
+
+  YamlHashTree ha(a);
+  YamlHashTree hb(b);
+  EXPECT_EQ(ha.hash(), hb.hash());
+  EXPECT_TRUE(diff(ha, hb).empty());
+}
+
+TEST_F(YamlDiffTest, HashDistinguishesTypesAndValues) {
+  // Same textual value, different types
+  EXPECT_NE(YamlHashTree::hashOf(YamlItem(YamlElement(1))), YamlHashTree::hashOf(YamlItem(YamlElement(1.0))));
+  EXPECT_NE(YamlHashTree::hashOf(YamlItem(YamlElement(std::string("1")))),
+            YamlHashTree::hashOf(YamlItem(YamlElement(1))));
+  // Empty sequence vs empty map
+  EXPECT_NE(YamlHashTree::hashOf(YamlItem(YamlElement(YamlSeq()))),
+            YamlHashTree::hashOf(YamlItem(YamlElement(YamlMap()))));
+
+  // Sequence order matters
+  YamlSeq ab, ba;
+  ab.push_back(YamlItem(YamlElement(std::string("a"))));
+  ab.push_back(YamlItem(YamlElement(std::string("b"))));
+  ba.push_back(YamlItem(YamlElement(std::string("b"))));
+  ba.push_back(YamlItem(YamlElement(std::string("a"))));
+  EXPECT_NE(YamlHashTree(ab).hash(), YamlHashTree(ba).hash());
+
+  // Keys are part of a map's hash, not just the values
+  YamlMap m1, m2;
+  m1["x"] = YamlItem(YamlElement(1));
+  m2["y"] = YamlItem(YamlElement(1));
+  EXPECT_NE(YamlHashTree(m1).hash(), YamlHashTree(m2).hash());
+}
+
+TEST_F(YamlDiffTest, HashTreeMirrorsSourceShape) {
+  YamlMap      root = makeConfig();
+  YamlHashTree tree(root);
+
+  const auto &node = tree.root();
+  EXPECT_EQ(node.type, YamlElement::ElementType::MAP);
+  EXPECT_EQ(node.map, &root);
+  ASSERT_EQ(node.children.size(), 3u);
+  // std::map order: debug, hosts, server
+  EXPECT_EQ(node.children[0].type, YamlElement::ElementType::BOOL);
+  EXPECT_EQ(node.children[1].type, YamlElement::ElementType::SEQ);
+  EXPECT_EQ(node.children[1].children.size(), 2u);
+  EXPECT_EQ(node.children[2].type, YamlElement::ElementType::MAP);
+  EXPECT_EQ(node.children[2].element, &root.at("server").value);
+}
+
+TEST_F(YamlDiffTest, ReportsChangedNestedScalar) {
+  YamlMap a = makeConfig();
+  YamlMap b = makeConfig();
+  b["server"].value.data.map->at("port") = YamlItem(YamlElement(9090));
+
+  auto changes = diff(a, b);
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].kind, YamlDiffEntry::Kind::CHANGED);
+  EXPECT_EQ(changes[0].path, "server.port");
+}
+
+TEST_F(YamlDiffTest, ReportsAddedAndRemovedKeys) {
+  YamlMap a = makeConfig();
+  YamlMap b = makeConfig();
+  b.erase("debug");
+  b["timeout"] = YamlItem(YamlElement(30));
+  b["server"].value.data.map->erase("host");
+
+  auto changes = diff(a, b);
+  ASSERT_EQ(changes.size(), 3u);
+  EXPECT_EQ(changes[0].kind, YamlDiffEntry::Kind::REMOVED);
+  EXPECT_EQ(changes[0].path, "debug");
+  EXPECT_EQ(changes[1].kind, YamlDiffEntry::Kind::REMOVED);
+  EXPECT_EQ(changes[1].path, "server.host");
+  EXPECT_EQ(changes[2].kind, YamlDiffEntry::Kind::ADDED);
+  EXPECT_EQ(changes[2].path, "timeout");
+}
+
+TEST_F(YamlDiffTest, ReportsSequenceChangesByIndex) {
+  YamlMap a = makeConfig();
+  YamlMap b = makeConfig();
+  YamlSeq &hosts = *b["hosts"].value.data.seq;
+  hosts[1]       = YamlItem(YamlElement(std::string("c")));
+  hosts.push_back(YamlItem(YamlElement(std::string("d"))));
+
+  auto changes = diff(a, b);
+  ASSERT_EQ(changes.size(), 2u);
+  EXPECT_EQ(changes[0].kind, YamlDiffEntry::Kind::CHANGED);
+  EXPECT_EQ(changes[0].path, "hosts[1]");
+  EXPECT_EQ(changes[1].kind, YamlDiffEntry::Kind::ADDED);
+  EXPECT_EQ(changes[1].path, "hosts[2]");
+
+  // Shrinking reports the removed tail
+  auto reverse = diff(b, a);
+  ASSERT_EQ(reverse.size(), 2u);
+  EXPECT_EQ(reverse[1].kind, YamlDiffEntry::Kind::REMOVED);
+  EXPECT_EQ(reverse[1].path, "hosts[2]");
+}
+
+TEST_F(YamlDiffTest, ReportsTypeChangeAtCollectionLevel) {
+  YamlMap a = makeConfig();
+  YamlMap b = makeConfig();
+  b["server"] = YamlItem(YamlElement(std::string("disabled")));
+
+  auto changes = diff(a, b);
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].kind, YamlDiffEntry::Kind::CHANGED);
+  EXPECT_EQ(changes[0].path, "server");
+}
+
+TEST_F(YamlDiffTest, SequenceRootsAndRootTypeChange) {
+  YamlSeq s1, s2;
+  s1.push_back(YamlItem(YamlElement(1)));
+  s2.push_back(YamlItem(YamlElement(2)));
+
+  auto changes = diff(YamlHashTree(s1), YamlHashTree(s2));
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0].path, "[0]");
+
+  YamlMap m;
+  auto    rootChange = diff(YamlHashTree(s1), YamlHashTree(m));
+  ASSERT_EQ(rootChange.size(), 1u);
+  EXPECT_EQ(rootChange[0].kind, YamlDiffEntry::Kind::CHANGED);
+  EXPECT_EQ(rootChange[0].path, "");
+}
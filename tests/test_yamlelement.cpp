@@ -141,6 +141,36 @@ TEST_F(YamlElementTest, MapConstructorSetsMap) {
   EXPECT_TRUE(element.isMap());
 }
 
+TEST_F(YamlElementTest, MoveSeqConstructorTakesItems) {
+  YamlSeq seq;
+  seq.push_back(YamlItem(YamlElement(std::string("first"))));
+  seq.push_back(YamlItem(YamlElement(2)));
+  const YamlItem *items = seq.data();
+
+  YamlElement element(std::move(seq));
+
+  EXPECT_TRUE(element.isSeq());
+  ASSERT_EQ(element.asSeq().size(), 2u);
+  EXPECT_EQ(element.asSeq()[0].value.asString(), "first");
+  // The items were taken over, not copied
+  EXPECT_EQ(element.asSeq().data(), items);
+}
+
+TEST_F(YamlElementTest, MoveMapConstructorTakesEntries) {
+  YamlMap inner;
+  inner["x"] = YamlItem(YamlElement(1));
+  YamlMap map;
+  map["inner"]         = YamlItem(YamlElement(std::move(inner)));
+  const YamlMap *child = &map["inner"].value.asMap();
+
+  YamlElement element(std::move(map));
+
+  EXPECT_TRUE(element.isMap());
+  ASSERT_EQ(element.asMap().size(), 1u);
+  EXPECT_EQ(&element.asMap().at("inner").value.asMap(), child);
+  EXPECT_EQ(element.asMap().at("inner").value.asMap().at("x").value.asInt(), 1);
+}
+
 TEST_F(YamlElementTest, CopyConstructorCopiesValue) {
   // Test copy constructor functionality
   // Verifies that YamlElement copy constructor creates an independent copy
@@ -520,4 +550,4 @@ TEST_F(YamlElementTest, DeeplyNestedSequencesAndMaps) {
   auto &deepSeq = nestedSeq[0].value.asSeq();
   ASSERT_FALSE(deepSeq.empty());
   EXPECT_EQ(deepSeq[0].value.asInt(), 42);
-}
\ No newline at end of file
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "YamlEmitter.hpp"
+#include "YamlPrinter.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlEmitterTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(YamlEmitterTest, OutputMatchesPrinterForEquivalentTree) {
+  // Build the tree that the emitter calls below describe
+  YamlMap server;
+  server["host"] = YamlItem(YamlElement(std::string("localhost")));
+  server["port"] = YamlItem(YamlElement(8080));
+  YamlSeq tags;
+  tags.push_back(YamlItem(YamlElement(std::string("a: b"))));
+  tags.push_back(YamlItem(YamlElement(2.5)));
+  tags.push_back(YamlItem(YamlElement(std::string(""))));
+  YamlMap nestedItem;
+  nestedItem["id"] = YamlItem(YamlElement(1));
+  tags.push_back(YamlItem(YamlElement(nestedItem)));
+  YamlMap root;
+  root["debug"]  = YamlItem(YamlElement(true));
+  root["empty"]  = YamlItem(YamlElement(std::string("")));
+  root["server"] = YamlItem(YamlElement(server));
+  root["tags"]   = YamlItem(YamlElement(tags));
+
+  std::stringstream ss;
+  {
+    YamlEmitter emitter(ss);
+    emitter.beginMap();
+    emitter.key("debug").value(true);
+    emitter.key("empty").value("");
+    emitter.key("server").beginMap();
+    emitter.key("host").value("localhost");
+    emitter.key("port").value(8080);
+    emitter.end();
+    emitter.key("tags").beginSeq();
+    emitter.value("a: b").value(2.5).value(std::string(""));
+    emitter.beginMap().key("id").value(1).end();
+    emitter.end();
+    emitter.end();
+    EXPECT_TRUE(emitter.complete());
+  }
+  EXPECT_EQ(ss.str(), YamlPrinter::toString(root));
+}
+
+TEST_F(YamlEmitterTest, SequenceRootAndEmbeddedSubtree) {
+  YamlSeq inner;
+  inner.push_back(YamlItem(YamlElement(1)));
+  inner.push_back(YamlItem(YamlElement(2)));
+  YamlSeq expected;
+  expected.push_back(YamlItem(YamlElement(std::string("x"))));
+  expected.push_back(YamlItem(YamlElement(inner)));
+  expected.push_back(YamlItem(YamlElement()));
+
+  YamlOutputBuffer out;
+  YamlEmitter      emitter(out);
+  emitter.beginSeq().value("x").value(YamlItem(YamlElement(inner))).null().end();
+  EXPECT_EQ(out.str(), YamlPrinter::toString(expected));
+  EXPECT_EQ(emitter.depth(), 0u);
+}
+
+TEST_F(YamlEmitterTest, EmittedDocumentParsesBack) {
+  const std::string fname = "test_emitter_roundtrip.yaml";
+  {
+    std::ofstream ofs(fname);
+    YamlEmitter   emitter(ofs);
+    emitter.beginMap();
+    emitter.key("name").value("export");
+    emitter.key("count").value(3);
+    emitter.key("ratio").value(0.5);
+    emitter.key("note").value("has # hash");
+    emitter.end();
+  }
+  YamlParser parser;
+  parser.parse(fname);
+  const auto &root = parser.root();
+  EXPECT_EQ(root.at("name").value.asString(), "export");
+  EXPECT_EQ(root.at("count").value.asInt(), 3);
+  EXPECT_DOUBLE_EQ(root.at("ratio").value.asDouble(), 0.5);
+  EXPECT_EQ(root.at("note").value.asString(), "has # hash");
+  std::remove(fname.c_str());
+}
+
+TEST_F(YamlEmitterTest, MisuseThrowsStructureException) {
+  YamlOutputBuffer out;
+
+  YamlEmitter noRoot(out);
+  EXPECT_THROW(noRoot.value(1), StructureException);
+  EXPECT_THROW(noRoot.key("k"), StructureException);
+  EXPECT_THROW(noRoot.end(), StructureException);
+
+  YamlEmitter missingKey(out);
+  missingKey.beginMap();
+  EXPECT_THROW(missingKey.value("v"), StructureException);
+  EXPECT_THROW(missingKey.beginSeq(), StructureException);
+  missingKey.key("k");
+  EXPECT_THROW(missingKey.key("k2"), StructureException);
+  EXPECT_THROW(missingKey.end(), StructureException);
+
+  YamlEmitter keyInSeq(out);
+  keyInSeq.beginSeq();
+  EXPECT_THROW(keyInSeq.key("k"), StructureException);
+
+  YamlEmitter twoRoots(out);
+  twoRoots.beginMap().end();
+  EXPECT_THROW(twoRoots.beginMap(), StructureException);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "YamlFlowParser.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <string>
+
+using namespace yamlparser;
+
+class YamlFlowParserTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(YamlFlowParserTest, NestedSequencesAndMappings) {
+  YamlParser parser;
+  parser.parseString("service: {name: api, ports: [80, 443], tls: {enabled: true}}\n"
+                     "mixed: [1, [2, 3], {x: 1.5}]\n"
+                     "empty_seq: []\n"
+                     "empty_map: { }\n"
+                     "items:\n"
+                     "  - {id: 7}\n");
+
+  const YamlMap &service = parser.root().at("service").value.asMap();
+  EXPECT_EQ(service.at("name").value.asString(), "api");
+  EXPECT_EQ(service.at("ports").value.asSeq()[1].value.asInt(), 443);
+  EXPECT_TRUE(service.at("tls").value.asMap().at("enabled").value.asBool());
+
+  const YamlSeq &mixed = parser.root().at("mixed").value.asSeq();
+  ASSERT_EQ(mixed.size(), 3u);
+  EXPECT_EQ(mixed[1].value.asSeq()[0].value.asInt(), 2);
+  EXPECT_DOUBLE_EQ(mixed[2].value.asMap().at("x").value.asDouble(), 1.5);
+
+  EXPECT_TRUE(parser.root().at("empty_seq").value.asSeq().empty());
+  EXPECT_TRUE(parser.root().at("empty_map").value.asMap().empty());
+  EXPECT_EQ(parser.root().at("items").value.asSeq()[0].value.asMap().at("id").value.asInt(), 7);
+}
+
+TEST_F(YamlFlowParserTest, ScalarsAreTypedLikeBlockScalars) {
+  YamlFlowParser flow;
+  YamlItem       item = flow.parse("[1, -2, 3.5, 1e3, true, 'a, b', \"[x]\", a[0], http://h:80, "
+                                   "plain # note, , last,]");
+  const YamlSeq &seq  = item.value.asSeq();
+  ASSERT_EQ(seq.size(), 12u);
+  EXPECT_EQ(seq[0].value.asInt(), 1);
+  EXPECT_EQ(seq[1].value.asInt(), -2);
+  EXPECT_DOUBLE_EQ(seq[2].value.asDouble(), 3.5);
+  EXPECT_DOUBLE_EQ(seq[3].value.asDouble(), 1000.0);
+  EXPECT_TRUE(seq[4].value.asBool());
+  EXPECT_EQ(seq[5].value.asString(), "a, b");
+  EXPECT_EQ(seq[6].value.asString(), "[x]");
+  EXPECT_EQ(seq[7].value.asString(), "a[0]");
+  EXPECT_EQ(seq[8].value.asString(), "http://h:80");
+  EXPECT_EQ(seq[9].value.asString(), "plain");
+  EXPECT_EQ(seq[10].value.asString(), "");
+  EXPECT_EQ(seq[11].value.asString(), "last");
+
+  item = flow.parse("{'key: 1': v, url: http://h:80, flag}");
+  const YamlMap &map = item.value.asMap();
+  EXPECT_EQ(map.at("key: 1").value.asString(), "v");
+  EXPECT_EQ(map.at("url").value.asString(), "http://h:80");
+  EXPECT_EQ(map.at("flag").value.asString(), "");
+}
+
+TEST_F(YamlFlowParserTest, CountsNodesAndDepth) {
+  YamlFlowParser flow;
+  flow.parse("[1, [2, 3], {a: 4}]");
+  EXPECT_EQ(flow.nodes(), 7u);
+  EXPECT_EQ(flow.depth(), 2u);
+  flow.parse("[]");
+  EXPECT_EQ(flow.nodes(), 1u);
+  EXPECT_EQ(flow.depth(), 1u);
+}
+
+TEST_F(YamlFlowParserTest, MalformedCollections) {
+  YamlFlowParser flow;
+  EXPECT_THROW(flow.parse("[1, 2"), SyntaxException);
+  EXPECT_THROW(flow.parse("{a: 1"), SyntaxException);
+  EXPECT_THROW(flow.parse("[1] [2]"), SyntaxException);
+  EXPECT_THROW(flow.parse("[[1] x]"), SyntaxException);
+  EXPECT_THROW(flow.parse("[a}"), SyntaxException);
+  EXPECT_THROW(flow.parse("['open]"), SyntaxException);
+  EXPECT_THROW(flow.parse("{[a]: 1}"), SyntaxException);
+  EXPECT_THROW(flow.parse("{: 1}"), SyntaxException);
+  EXPECT_THROW(flow.parse("{a: 1, a: 2}"), SyntaxException);
+  EXPECT_THROW(flow.parse("plain"), SyntaxException);
+  EXPECT_THROW(flow.parse("[99999999999]"), ConversionException);
+
+  YamlParser parser;
+  try {
+    parser.parseString("a: 1\nb: [1, 2}]\n");
+    FAIL() << "Expected SyntaxException";
+  } catch (const SyntaxException &e) {
+    EXPECT_NE(std::string(e.what()).find("at line 2"), std::string::npos) << e.what();
+  }
+}
+
+TEST_F(YamlFlowParserTest, DepthLimit) {
+  EXPECT_NO_THROW(YamlFlowParser(3).parse("[[{a: 1}]]"));
+  EXPECT_THROW(YamlFlowParser(3).parse("[[[[1]]]]"), LimitException);
+  EXPECT_THROW(YamlFlowParser(3, 2).parse("[[1]]"), LimitException);
+
+  // Without parse limits the default cap still keeps the recursion off the end of the stack
+  std::string deep = "a: " + std::string(100000, '[') + std::string(100000, ']') + "\n";
+  YamlParser  parser;
+  EXPECT_THROW(parser.parseString(deep), LimitException);
+}
+
+TEST_F(YamlFlowParserTest, LongNumericArray) {
+  std::string text = "values: [";
+  for (int i = 0; i < 10000; ++i)
+    text += (i ? ", " : "") + std::to_string(i * 3);
+  text += "]\n";
+
+  YamlParser parser;
+  parser.parseString(text);
+  const YamlSeq &values = parser.root().at("values").value.asSeq();
+  ASSERT_EQ(values.size(), 10000u);
+  EXPECT_EQ(values[9999].value.asInt(), 29997);
+}
+
+TEST_F(YamlFlowParserTest, NumericScalarForms) {
+  YamlParser parser;
+  parser.parseString("values: [+7, 007, 1., .5, -1.5e-3, 2E2, 1e, ., -, 1.2.3, 0x10, 5 ]\n");
+  const YamlSeq &values = parser.root().at("values").value.asSeq();
+  ASSERT_EQ(values.size(), 12u);
+  EXPECT_EQ(values[0].value.asInt(), 7);
+  EXPECT_EQ(values[1].value.asInt(), 7);
+  EXPECT_DOUBLE_EQ(values[2].value.asDouble(), 1.0);
+  EXPECT_DOUBLE_EQ(values[3].value.asDouble(), 0.5);
+  EXPECT_DOUBLE_EQ(values[4].value.asDouble(), -0.0015);
+  EXPECT_DOUBLE_EQ(values[5].value.asDouble(), 200.0);
+  for (size_t i = 6; i < 11; ++i)
+    EXPECT_TRUE(values[i].value.isString()) << i;
+  EXPECT_EQ(values[11].value.asInt(), 5);
+}
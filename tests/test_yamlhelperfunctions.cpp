@@ -107,8 +107,9 @@ TEST_F(YamlHelperFunctionsTest, MultilineLiteralParsing) {
   // Verifies that parseMultilineLiteral correctly processes block scalar content
 
   // Setup: Create test lines with multiline literal (pipe style - preserves newlines)
-  std::vector<std::string> lines = {"key: |", "  line1", "  line2", "other: value"};
-  size_t                   idx   = 0;
+  std::string text = "key: |\n  line1\n  line2\nother: value\n";
+  YamlScanner lines(text);
+  size_t      idx = 0;
 
   // Action: Parse multiline literal with indent of 1
   auto result = parseMultilineLiteral(lines, idx, 1, '|');
@@ -117,14 +118,15 @@ TEST_F(YamlHelperFunctionsTest, MultilineLiteralParsing) {
   EXPECT_EQ(result.value.asString(), "line1\nline2\n");
 
   // Test folded block scalar (covers lines 115-117)
-  std::vector<std::string> foldedLines = {"key: >", "  line1", "  line2", "other: value"};
-  size_t                   foldedIdx   = 0;
+  std::string foldedText = "key: >\n  line1\n  line2\nother: value\n";
+  YamlScanner foldedLines(foldedText);
+  size_t      foldedIdx = 0;
 
   // Action: Parse folded multiline literal (> style - folds newlines to spaces)
   auto foldedResult = parseMultilineLiteral(foldedLines, foldedIdx, 1, '>');
 
-  // Assertion: Should combine lines with spaces (folded style)
-  EXPECT_EQ(foldedResult.value.asString(), "line1 line2");
+  // Assertion: Should combine lines with spaces and keep one final break (clip)
+  EXPECT_EQ(foldedResult.value.asString(), "line1 line2\n");
 }
 
 TEST_F(YamlHelperFunctionsTest, AnchorParsing) {
@@ -136,8 +138,9 @@ TEST_F(YamlHelperFunctionsTest, AnchorParsing) {
   std::map<std::string, YamlItem> anchors;
 
   // Test anchor with map content (covers line 143)
-  std::vector<std::string> mapLines = {"key: &anchor", "  subkey1: value1", "  subkey2: value2", "next: value"};
-  size_t                   mapIdx   = 0;
+  std::string mapText = "key: &anchor\n  subkey1: value1\n  subkey2: value2\nnext: value\n";
+  YamlScanner mapLines(mapText);
+  size_t      mapIdx = 0;
 
   // Action: Parse anchor that points to a map
   auto mapResult = parseAnchor("&anchor", mapLines, mapIdx, anchors, parser);
@@ -267,32 +270,36 @@ TEST_F(YamlHelperFunctionsTest, MergeKeyDetectionWithMalformedInput) {
 
 TEST_F(YamlHelperFunctionsTest, ParseMultilineLiteralWithEmptyOrWhitespaceLines) {
   // This test checks that parseMultilineLiteral handles empty/whitespace-only lines correctly.
-  std::vector<std::string> lines1  = {"key: |", "   ", "   ", "other: value"};
-  size_t                   idx1    = 0;
-  auto                     result1 = parseMultilineLiteral(lines1, idx1, 1, '|');
+  std::string text1 = "key: |\n   \n   \nother: value\n";
+  YamlScanner lines1(text1);
+  size_t      idx1    = 0;
+  auto        result1 = parseMultilineLiteral(lines1, idx1, 1, '|');
   EXPECT_EQ(result1.value.asString(), "");
 
-  std::vector<std::string> lines2  = {"key: |", "other: value"};
-  size_t                   idx2    = 0;
-  auto                     result2 = parseMultilineLiteral(lines2, idx2, 1, '|');
+  std::string text2 = "key: |\nother: value\n";
+  YamlScanner lines2(text2);
+  size_t      idx2    = 0;
+  auto        result2 = parseMultilineLiteral(lines2, idx2, 1, '|');
   EXPECT_EQ(result2.value.asString(), "");
 }
 
 TEST_F(YamlHelperFunctionsTest, ParseMultilineLiteralWithMissingBlockIndicator) {
   // This test checks that parseMultilineLiteral does not crash if block indicator is missing.
-  std::vector<std::string> lines = {"key:", "  line1", "  line2"};
-  size_t                   idx   = 0;
-  // Should not crash, returns joined lines
+  std::string text = "key:\n  line1\n  line2\n";
+  YamlScanner lines(text);
+  size_t      idx = 0;
+  // Should not crash, returns joined lines read as a clipped folded block
   auto result = parseMultilineLiteral(lines, idx, 1, ' ');
-  EXPECT_EQ(result.value.asString(), "line1 line2");
+  EXPECT_EQ(result.value.asString(), "line1 line2\n");
 }
 
 TEST_F(YamlHelperFunctionsTest, ParseAnchorWithMissingOrUnknownAnchor) {
   // This test checks that parseAnchor throws for malformed or missing anchor names.
   yamlparser::YamlParser          parser;
   std::map<std::string, YamlItem> anchors;
-  std::vector<std::string>        lines = {"key: &", "  value"};
-  size_t                          idx   = 0;
+  std::string                     text = "key: &\n  value\n";
+  YamlScanner                     lines(text);
+  size_t                          idx = 0;
   // Should throw due to malformed anchor
   EXPECT_THROW(parseAnchor("&", lines, idx, anchors, parser), std::exception);
 }
@@ -316,3 +323,28 @@ TEST_F(YamlHelperFunctionsTest, ParseInlineSeqWithEmptyOrMalformedInput) {
   EXPECT_TRUE(result3.value.isSeq());
   EXPECT_EQ(result3.value.asSeq().size(), 3);
 }
+
+TEST_F(YamlHelperFunctionsTest, UnescapeDoubleQuoted) {
+  auto decode = [](const std::string &s) { return unescapeDoubleQuoted(s.data(), s.size()); };
+  EXPECT_EQ(decode("plain text"), "plain text");
+  EXPECT_EQ(decode("a\\tb\\nc\\\\d\\\"e\\/f\\ g"), "a\tb\nc\\d\"e/f g");
+  EXPECT_EQ(decode("\\0\\a\\b\\v\\f\\r\\e"), std::string("\0\a\b\v\f\r\x1B", 7));
+  EXPECT_EQ(decode("\\x41\\u00e9\\u20AC\\U0001F600"), "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+  EXPECT_EQ(decode("\\uD83D\\uDE00"), "\xF0\x9F\x98\x80"); // surrogate pair
+  EXPECT_EQ(decode("\\N\\_\\L\\P"), "\xC2\x85\xC2\xA0\xE2\x80\xA8\xE2\x80\xA9");
+
+  EXPECT_THROW(decode("C:\\Users"), SyntaxException);
+  EXPECT_THROW(decode("trailing\\"), SyntaxException);
+  EXPECT_THROW(decode("\\x4"), SyntaxException);
+  EXPECT_THROW(decode("\\u12G4"), SyntaxException);
+  EXPECT_THROW(decode("\\uD800"), SyntaxException);
+  EXPECT_THROW(decode("\\U00110000"), SyntaxException);
+}
+
+TEST_F(YamlHelperFunctionsTest, UnescapeSingleQuoted) {
+  auto decode = [](const std::string &s) { return unescapeSingleQuoted(s.data(), s.size()); };
+  EXPECT_EQ(decode("no quotes \\n"), "no quotes \\n");
+  EXPECT_EQ(decode("it''s"), "it's");
+  EXPECT_EQ(decode("''''"), "''");
+  EXPECT_EQ(decode("lone ' kept"), "lone ' kept");
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "YamlInput.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <string>
+
+using namespace yamlparser;
+
+class YamlInputTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static size_t invalidAt(const std::string &text) {
+    return findInvalidUtf8(text.data(), text.size());
+  }
+};
+
+TEST_F(YamlInputTest, AcceptsWellFormedUtf8) {
+  std::string ascii(100, 'a');
+  EXPECT_EQ(invalidAt(ascii), ascii.size());
+  std::string mixed = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xEF\xBF\xBD \xF4\x8F\xBF\xBF";
+  EXPECT_EQ(invalidAt(mixed), mixed.size());
+  EXPECT_EQ(invalidAt(""), 0u);
+}
+
+TEST_F(YamlInputTest, FindsFirstInvalidByte) {
+  // Invalid bytes at the end of a 16-byte chunk, in the tail and after a valid sequence
+  EXPECT_EQ(invalidAt(std::string(15, 'a') + "\x80" + std::string(20, 'b')), 15u);
+  EXPECT_EQ(invalidAt(std::string(33, 'a') + "\xFF"), 33u);
+  EXPECT_EQ(invalidAt("\xC3\xA9\xC3"), 2u);         // truncated
+  EXPECT_EQ(invalidAt("\xC0\xAF"), 0u);             // overlong '/'
+  EXPECT_EQ(invalidAt("\xE0\x80\xAF"), 0u);         // overlong
+  EXPECT_EQ(invalidAt("\xF0\x80\x80\xAF"), 0u);     // overlong
+  EXPECT_EQ(invalidAt("x\xED\xA0\x80"), 1u);        // surrogate U+D800
+  EXPECT_EQ(invalidAt("\xF4\x90\x80\x80"), 0u);     // above U+10FFFF
+  EXPECT_EQ(invalidAt("\xE2\x82x"), 0u);            // missing continuation byte
+  EXPECT_EQ(invalidAt("\xC3\xA9\xA9"), 2u);         // stray continuation byte
+}
+
+TEST_F(YamlInputTest, PassesCleanSourceThrough) {
+  std::string source = "a: 1\nb: \xC3\xA9\n";
+  YamlInput   input(source);
+  EXPECT_FALSE(input.normalized());
+  EXPECT_FALSE(input.hasBom());
+  EXPECT_EQ(&input.text(), &source);
+}
+
+TEST_F(YamlInputTest, DropsBomAndNormalizesLineBreaks) {
+  std::string source = "\xEF\xBB\xBF"
+                       "a: 1\r\nb: 2\rc: 3\r\n\r\n";
+  YamlInput   input(source);
+  EXPECT_TRUE(input.hasBom());
+  EXPECT_TRUE(input.normalized());
+  EXPECT_EQ(input.text(), "a: 1\nb: 2\nc: 3\n\n");
+
+  std::string bomOnly = "\xEF\xBB\xBF";
+  EXPECT_EQ(YamlInput(bomOnly).text(), "");
+}
+
+TEST_F(YamlInputTest, ReportsLineAndOffset) {
+  std::string source = "a: 1\nb: caf\xE9\n";
+  try {
+    YamlInput input(source);
+    FAIL() << "Expected EncodingException";
+  } catch (const EncodingException &e) {
+    EXPECT_EQ(e.offset(), 11u);
+    EXPECT_NE(std::string(e.what()).find("at line 2"), std::string::npos) << e.what();
+    EXPECT_NE(std::string(e.what()).find("0xE9"), std::string::npos) << e.what();
+  }
+
+  std::string utf16 = std::string("\xFF\xFE" "a\0:\0", 6);
+  try {
+    YamlInput input(utf16);
+    FAIL() << "Expected EncodingException";
+  } catch (const EncodingException &e) {
+    EXPECT_NE(std::string(e.what()).find("UTF-16"), std::string::npos) << e.what();
+  }
+}
+
+TEST_F(YamlInputTest, ParserReadsCrlfDocuments) {
+  YamlParser parser;
+  parser.parseString("\xEF\xBB\xBF"
+                     "name: api\r\n"
+                     "ports:\r\n"
+                     "  - 80\r\n"
+                     "  - 443\r\n"
+                     "script: |\r\n"
+                     "  make\r\n"
+                     "  test\r\n"
+                     "tags: [a, b]\r\n"
+                     "empty:\r\n");
+  EXPECT_EQ(parser.root().at("name").value.asString(), "api");
+  EXPECT_EQ(parser.root().at("ports").value.asSeq()[1].value.asInt(), 443);
+  EXPECT_EQ(parser.root().at("script").value.asString(), "make\ntest\n");
+  EXPECT_EQ(parser.root().at("tags").value.asSeq()[1].value.asString(), "b");
+  EXPECT_TRUE(parser.root().at("empty").value.isString());
+
+  EXPECT_THROW(parser.parseString("key: \xC3\x28\n"), EncodingException);
+}
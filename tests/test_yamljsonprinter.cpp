@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "YamlJsonPrinter.hpp"
+#include "YamlException.hpp"
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlJsonPrinterTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static std::string escaped(const std::string &s) {
+    YamlOutputBuffer out;
+    YamlJsonPrinter::writeString(s, out);
+    return out.str();
+  }
+};
+
+TEST_F(YamlJsonPrinterTest, PrintsAllElementTypes) {
+  YamlSeq seq;
+  seq.push_back(YamlItem(YamlElement(1)));
+  seq.push_back(YamlItem(YamlElement(-2)));
+  seq.push_back(YamlItem(YamlElement(true)));
+  seq.push_back(YamlItem(YamlElement()));
+  YamlMap nested;
+  nested["k"] = YamlItem(YamlElement(std::string("v")));
+  YamlMap map;
+  map["b"]      = YamlItem(YamlElement(false));
+  map["d"]      = YamlItem(YamlElement(0.5));
+  map["empty"]  = YamlItem(YamlElement(std::string("")));
+  map["nested"] = YamlItem(YamlElement(nested));
+  map["seq"]    = YamlItem(YamlElement(seq));
+
+  EXPECT_EQ(YamlJsonPrinter::toString(map),
+            "{\"b\":false,\"d\":0.5,\"empty\":\"\",\"nested\":{\"k\":\"v\"},\"seq\":[1,-2,true,null]}");
+  EXPECT_EQ(YamlJsonPrinter::toString(YamlMap()), "{}");
+  EXPECT_EQ(YamlJsonPrinter::toString(YamlSeq()), "[]");
+
+  std::ostringstream os;
+  YamlJsonPrinter::print(map, os);
+  EXPECT_EQ(os.str(), YamlJsonPrinter::toString(map));
+}
+
+TEST_F(YamlJsonPrinterTest, EscapesSpecialCharacters) {
+  EXPECT_EQ(escaped("plain"), "\"plain\"");
+  EXPECT_EQ(escaped("a\"b\\c"), "\"a\\\"b\\\\c\"");
+  EXPECT_EQ(escaped("\n\r\t\b\f"), "\"\\n\\r\\t\\b\\f\"");
+  EXPECT_EQ(escaped(std::string("\x01\x1f", 2)), "\"\\u0001\\u001f\"");
+  EXPECT_EQ(escaped(std::string("nul\0byte", 8)), "\"nul\\u0000byte\"");
+  // UTF-8 and DEL pass through unchanged
+  EXPECT_EQ(escaped("caf\xc3\xa9\x7f"), "\"caf\xc3\xa9\x7f\"");
+}
+
+TEST_F(YamlJsonPrinterTest, EscapesAcrossVectorBlockBoundaries) {
+  // Place escapable characters at every offset around 16-byte blocks
+  for (size_t pos = 0; pos < 40; ++pos) {
+    std::string s(40, 'x');
+    s[pos]               = '"';
+    std::string expected = "\"" + s.substr(0, pos) + "\\\"" + s.substr(pos + 1) + "\"";
+    EXPECT_EQ(escaped(s), expected) << "position " << pos;
+  }
+  // High bytes must not be mistaken for control characters
+  std::string high(64, '\xff');
+  EXPECT_EQ(escaped(high), "\"" + high + "\"");
+}
+
+TEST_F(YamlJsonPrinterTest, DoublesRoundTripAndNonFiniteBecomeNull) {
+  YamlSeq seq;
+  seq.push_back(YamlItem(YamlElement(0.1)));
+  seq.push_back(YamlItem(YamlElement(std::numeric_limits<double>::infinity())));
+  seq.push_back(YamlItem(YamlElement(std::numeric_limits<double>::quiet_NaN())));
+  std::string json = YamlJsonPrinter::toString(seq);
+
+  ASSERT_EQ(json.front(), '[');
+  double parsed = std::stod(json.substr(1, json.find(',') - 1));
+  EXPECT_EQ(parsed, 0.1);
+  EXPECT_NE(json.find(",null,null]"), std::string::npos);
+}
+
+TEST_F(YamlJsonPrinterTest, EmitterMatchesPrinter) {
+  YamlSeq inner;
+  inner.push_back(YamlItem(YamlElement(1)));
+  YamlMap expected;
+  expected["a"]    = YamlItem(YamlElement(std::string("x\"y")));
+  expected["list"] = YamlItem(YamlElement(inner));
+  expected["n"]    = YamlItem(YamlElement());
+  expected["obj"]  = YamlItem(YamlElement(YamlMap()));
+
+  std::ostringstream os;
+  {
+    YamlJsonEmitter emitter(os);
+    emitter.beginMap();
+    emitter.key("a").value("x\"y");
+    emitter.key("list").beginSeq().value(1).end();
+    emitter.key("n").null();
+    emitter.key("obj").beginMap().end();
+    emitter.end();
+    EXPECT_TRUE(emitter.complete());
+  }
+  EXPECT_EQ(os.str(), YamlJsonPrinter::toString(expected));
+}
+
+TEST_F(YamlJsonPrinterTest, EmitterMisuseThrows) {
+  YamlOutputBuffer out;
+  YamlJsonEmitter  emitter(out);
+  EXPECT_THROW(emitter.value(1), StructureException);
+  emitter.beginMap();
+  EXPECT_THROW(emitter.value(1), StructureException);
+  emitter.key("k");
+  EXPECT_THROW(emitter.end(), StructureException);
+  emitter.value(YamlItem(YamlElement(2)));
+  emitter.end();
+  EXPECT_THROW(emitter.beginSeq(), StructureException);
+  EXPECT_EQ(out.str(), "{\"k\":2}");
+}
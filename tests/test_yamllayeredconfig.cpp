@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "YamlLayeredConfig.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlLayeredConfigTest : public ::testing::Test {
+protected:
+  // Named after the test, so tests run in parallel processes do not share files
+  const std::string testName = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  const std::string baseFile = "test_layer_" + testName + "_base.yaml";
+  const std::string hostFile = "test_layer_" + testName + "_host.yaml";
+
+  void SetUp() override {
+    write(baseFile, "server:\n"
+                    "  host: 0.0.0.0\n"
+                    "  port: 8080\n"
+                    "  tls:\n"
+                    "    enabled: false\n"
+                    "    ciphers: [a, b]\n"
+                    "db:\n"
+                    "  url: postgres://base\n"
+                    "  pool: 4\n"
+                    "tags:\n"
+                    "  - base\n"
+                    "name: base\n");
+    write(hostFile, "server:\n"
+                    "  port: 9090\n"
+                    "  tls:\n"
+                    "    enabled: true\n"
+                    "db: none\n"
+                    "tags:\n"
+                    "  - host\n"
+                    "  - canary\n"
+                    "extra: 1\n");
+  }
+
+  void TearDown() override {
+    std::remove(baseFile.c_str());
+    std::remove(hostFile.c_str());
+  }
+
+  static void write(const std::string &file, const std::string &text) {
+    std::ofstream ofs(file);
+    ofs << text;
+  }
+
+  static std::shared_ptr<const YamlMap> layer(const std::string &text) {
+    auto parser = std::make_shared<YamlParser>();
+    parser->parseString(text);
+    return std::shared_ptr<const YamlMap>(parser, &parser->root());
+  }
+};
+
+TEST_F(YamlLayeredConfigTest, HigherLayersOverrideAndMappingsMerge) {
+  YamlLayeredConfig config;
+  config.addFile(baseFile);
+  config.addFile(hostFile);
+  ASSERT_EQ(config.layerCount(), 2u);
+
+  YamlLayeredNode server = config.get("server");
+  EXPECT_TRUE(server.isMap());
+  EXPECT_EQ(server.at("port").asInt(), 9090);
+  EXPECT_EQ(config.layerName(server.at("port").layer()), hostFile);
+  EXPECT_EQ(server.at("host").asString(), "0.0.0.0");
+  EXPECT_EQ(config.layerName(server.at("host").layer()), baseFile);
+  EXPECT_TRUE(server.at("tls").at("enabled").asBool());
+  EXPECT_EQ(server.at("tls").at("ciphers").size(), 2u);
+  EXPECT_EQ(server.keys(), (std::vector<std::string>{"host", "port", "tls"}));
+  EXPECT_EQ(config.root().size(), 5u);
+  EXPECT_EQ(config.get("extra").asInt(), 1);
+  EXPECT_EQ(config.get("name").asString(), "base");
+}
+
+TEST_F(YamlLayeredConfigTest, PlainValuesReplaceWholeSubtrees) {
+  YamlLayeredConfig config;
+  config.addFile(baseFile);
+  config.addFile(hostFile);
+
+  // A scalar above a mapping hides all of its keys
+  YamlLayeredNode db = config.get("db");
+  EXPECT_FALSE(db.isMap());
+  EXPECT_EQ(db.asString(), "none");
+  EXPECT_THROW(db.at("url"), TypeException);
+
+  // Sequences are replaced, not concatenated
+  EXPECT_EQ(config.get("tags").size(), 2u);
+  EXPECT_EQ(config.get("tags").asSeq()[0].value.asString(), "host");
+
+  // A mapping above a scalar ignores the scalar
+  config.addLayer("top", layer("db:\n  url: postgres://top\n"));
+  db = config.get("db");
+  ASSERT_TRUE(db.isMap());
+  EXPECT_EQ(db.keys(), std::vector<std::string>{"url"});
+  EXPECT_EQ(db.layer(), 2u);
+}
+
+TEST_F(YamlLayeredConfigTest, LookupsReferToTheSharedLayers) {
+  auto base = YamlLayeredConfig::load(baseFile);
+  YamlLayeredConfig first, second;
+  first.addLayer("base", base);
+  second.addLayer("base", base);
+  second.addLayer("override", layer("name: second\n"));
+  EXPECT_EQ(base.use_count(), 3);
+
+  EXPECT_EQ(&first.get("name").value(), &base->at("name").value);
+  EXPECT_EQ(&second.get("server").at("port").value(), &base->at("server").value.asMap().at("port").value);
+  EXPECT_EQ(second.get("name").asString(), "second");
+  EXPECT_EQ(first.get("name").asString(), "base");
+}
+
+TEST_F(YamlLayeredConfigTest, FlattenMatchesTheView) {
+  YamlLayeredConfig config;
+  config.addFile(baseFile);
+  config.addFile(hostFile);
+  YamlMap flat = config.flatten();
+
+  ASSERT_EQ(flat.size(), 5u);
+  const YamlMap &server = flat.at("server").value.asMap();
+  EXPECT_EQ(server.at("port").value.asInt(), 9090);
+  EXPECT_EQ(server.at("host").value.asString(), "0.0.0.0");
+  EXPECT_TRUE(server.at("tls").value.asMap().at("enabled").value.asBool());
+  EXPECT_EQ(server.at("tls").value.asMap().at("ciphers").value.asSeq().size(), 2u);
+  EXPECT_EQ(flat.at("db").value.asString(), "none");
+  EXPECT_EQ(flat.at("tags").value.asSeq().size(), 2u);
+
+  YamlItem tls = config.get("server").at("tls").toItem();
+  EXPECT_EQ(tls.value.asMap().size(), 2u);
+}
+
+TEST_F(YamlLayeredConfigTest, EmptyStack) {
+  YamlLayeredConfig config;
+  EXPECT_TRUE(config.root().isMap());
+  EXPECT_TRUE(config.root().keys().empty());
+  EXPECT_FALSE(config.root().contains("a"));
+  EXPECT_TRUE(config.flatten().empty());
+  EXPECT_THROW(config.get("a"), KeyException);
+}
+
+TEST_F(YamlLayeredConfigTest, Errors) {
+  YamlLayeredConfig config;
+  EXPECT_THROW(config.addFile("no_such_layer.yaml"), FileException);
+  write(hostFile, "- a\n- b\n");
+  EXPECT_THROW(config.addFile(hostFile), TypeException);
+  EXPECT_THROW(config.addLayer("null", nullptr), StructureException);
+  EXPECT_THROW(config.layerName(0), IndexException);
+
+  config.addFile(baseFile);
+  EXPECT_THROW(config.get("missing"), KeyException);
+  EXPECT_THROW(config.get("server").at("missing"), KeyException);
+  EXPECT_THROW(config.get("server").asInt(), TypeException);
+  EXPECT_THROW(config.get("name").keys(), TypeException);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "YamlLinter.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlLinterTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {
+    for (const auto &path : files)
+      std::remove(path.c_str());
+  }
+
+  std::string writeFile(const std::string &name, const std::string &content) {
+    std::string   path = "lint_test_" + name + ".yaml";
+    std::ofstream out(path);
+    out << content;
+    files.push_back(path);
+    return path;
+  }
+
+  YamlLinter               linter;
+  std::vector<std::string> files;
+};
+
+TEST_F(YamlLinterTest, ValidDocumentsHaveNoDiagnostics) {
+  EXPECT_TRUE(linter.lintString("base: &base\n  a: 1\nderived:\n  <<: *base\n  b: [1, {c: 2}]\n"
+                                "text: |\n  x\nlist:\n  - name: x\n    port: 80\n  - \"y\\n\"\n")
+                  .empty());
+  EXPECT_TRUE(linter.lintString("").empty());
+  EXPECT_TRUE(linter.lintString("- a\n- b: 1\n  c: 2\n").empty());
+}
+
+TEST_F(YamlLinterTest, ReportsEveryProblemWithItsLine) {
+  std::string text = "a: 1\n"
+                     "missing colon\n"
+                     "  child: ignored\n" // owned by the bad line above, skipped
+                     "b:\n"
+                     "  c: [1, 2\n"
+                     "  d: \"bad \\q\"\n"
+                     "  e: ok\n"
+                     "a: 2\n"
+                     "f: *nowhere\n"
+                     "g: |x\n"
+                     "list:\n"
+                     "  - 99999999999\n"
+                     "  - fine\n";
+  auto diagnostics = linter.lintString(text, "app.yaml");
+  ASSERT_EQ(diagnostics.size(), 7u);
+  std::vector<size_t> lines;
+  for (const auto &diagnostic : diagnostics)
+    lines.push_back(diagnostic.line);
+  EXPECT_EQ(lines, (std::vector<size_t>{2, 5, 6, 8, 9, 10, 12}));
+  EXPECT_EQ(diagnostics[0].str(), "app.yaml:2: Missing ':' in key-value pair: 'missing colon'");
+  EXPECT_NE(diagnostics[3].message.find("Duplicate mapping key: 'a'"), std::string::npos);
+  EXPECT_NE(diagnostics[4].message.find("Undefined alias '*nowhere'"), std::string::npos);
+  EXPECT_NE(diagnostics[6].message.find("Cannot convert"), std::string::npos);
+}
+
+TEST_F(YamlLinterTest, FirstDiagnosticMatchesTheParser) {
+  const char *documents[] = {"a: 1\nb\n", "a:\n  - x\n  - {y: }\n  - [z\n", "k: \"\\x4\"\nz: 1\n",
+                             "a: 1\n  b: 2\nc: &x 1\n<<: *x\n", "seq:\n  - |9-\n    x\n"};
+  for (const char *document : documents) {
+    auto diagnostics = linter.lintString(document);
+    try {
+      YamlParser parser;
+      parser.parseString(document);
+      EXPECT_TRUE(diagnostics.empty()) << document;
+    } catch (const SyntaxException &e) {
+      ASSERT_FALSE(diagnostics.empty()) << document;
+      if (e.line() > 0) {
+        EXPECT_EQ(diagnostics[0].line, e.line()) << document;
+      }
+    } catch (const YamlException &) {
+      EXPECT_FALSE(diagnostics.empty()) << document;
+    }
+  }
+}
+
+TEST_F(YamlLinterTest, AcceptsExactlyWhatTheParserAccepts) {
+  // The linter repeats the parser's walk; check the two agree on the test
+  // cases and on copies broken one line at a time
+  const char *names[] = {"01_nested_types",       "02_multiline_formats",  "03_dates_and_numbers",
+                         "04_anchors_and_merging", "05_sequence_variations", "06_string_formats",
+                         "07_comments_and_docs",   "08_mapping_patterns",   "09_basic_types",
+                         "10_common_features"};
+  const char *edits[] = {"", "x", "- ", ": ", "[", "\"", "&a ", "*a", "|9", "\t"};
+  size_t      checked = 0;
+  for (const char *name : names) {
+    std::ifstream in(std::string("test_cases/") + name + ".yaml");
+    ASSERT_TRUE(in.good()) << name;
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);)
+      lines.push_back(line);
+
+    for (size_t target = 0; target <= lines.size(); ++target) {
+      for (const char *edit : edits) {
+        std::string document;
+        for (size_t i = 0; i < lines.size(); ++i) {
+          if (i != target)
+            document += lines[i] + "\n";
+          else if (*edit != '\0')
+            document += std::string(edit) + lines[i] + "\n";
+        }
+        bool parses = true;
+        try {
+          YamlParser parser;
+          parser.parseString(document);
+        } catch (const YamlException &) {
+          parses = false;
+        }
+        EXPECT_EQ(linter.lintString(document).empty(), parses) << name << ", line " << target + 1 << ", edit '"
+                                                               << edit << "'";
+        checked++;
+      }
+    }
+  }
+  EXPECT_GT(checked, 1000u);
+}
+
+TEST_F(YamlLinterTest, EncodingAndDepth) {
+  auto diagnostics = linter.lintString("a: 1\nb: caf\xE9\n");
+  ASSERT_EQ(diagnostics.size(), 1u);
+  EXPECT_EQ(diagnostics[0].line, 2u);
+
+  YamlLinter  shallow(3);
+  std::string deep;
+  for (size_t i = 0; i < 6; ++i)
+    deep += std::string(2 * i, ' ') + "k" + std::to_string(i) + ":\n";
+  deep += std::string(12, ' ') + "v: 1\nnext: 1\n";
+  diagnostics = shallow.lintString(deep);
+  ASSERT_EQ(diagnostics.size(), 1u);
+  EXPECT_EQ(diagnostics[0].line, 4u);
+}
+
+TEST_F(YamlLinterTest, LintsFilesOnThreads) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 40; ++i)
+    paths.push_back(writeFile(std::to_string(i), i % 10 == 3 ? "a: 1\nbad line\n" : "a: 1\nb: [1, 2]\n"));
+  paths.push_back("lint_test_missing.yaml");
+
+  YamlLintReport report = linter.lintFiles(paths, 4);
+  EXPECT_EQ(report.files, 41u);
+  EXPECT_EQ(report.threads, 4u);
+  EXPECT_EQ(report.failedFiles, 5u);
+  ASSERT_EQ(report.diagnostics.size(), 5u);
+  EXPECT_FALSE(report.ok());
+  // Diagnostics keep the order of the files, whichever thread checked them
+  EXPECT_EQ(report.diagnostics[0].file, paths[3]);
+  EXPECT_EQ(report.diagnostics[0].line, 2u);
+  EXPECT_EQ(report.diagnostics[3].file, paths[33]);
+  EXPECT_EQ(report.diagnostics[4].file, "lint_test_missing.yaml");
+  EXPECT_EQ(report.diagnostics[4].line, 0u);
+  EXPECT_GT(report.bytes, 0u);
+  EXPECT_GT(report.megabytesPerSecond(), 0.0);
+
+  EXPECT_TRUE(linter.lintFiles(std::vector<std::string>(paths.begin(), paths.begin() + 3)).ok());
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "YamlException.hpp"
+#include "YamlMemory.hpp"
+#include "YamlParser.hpp"
+#include "YamlPooledTree.hpp"
+#include "YamlPrinter.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlMemoryTest : public ::testing::Test {
+protected:
+  static const char *document() {
+    return "server:\n"
+           "  host: localhost\n"
+           "  ports: [80, 443]\n"
+           "defaults: &defaults\n"
+           "  retries: 3\n"
+           "service:\n"
+           "  <<: *defaults\n"
+           "  hosts:\n"
+           "    - a\n"
+           "    - b\n";
+  }
+};
+
+TEST_F(YamlMemoryTest, DefaultResourceIsCurrentOutsideScopes) {
+  EXPECT_EQ(currentMemoryResource(), defaultMemoryResource());
+  CountingMemoryResource outer;
+  CountingMemoryResource inner;
+  {
+    YamlMemoryScope scope(&outer);
+    EXPECT_EQ(currentMemoryResource(), &outer);
+    {
+      YamlMemoryScope nested(&inner);
+      EXPECT_EQ(currentMemoryResource(), &inner);
+    }
+    EXPECT_EQ(currentMemoryResource(), &outer);
+  }
+  EXPECT_EQ(currentMemoryResource(), defaultMemoryResource());
+}
+
+TEST_F(YamlMemoryTest, ParsedTreeStaysOnTheHeap) {
+  // Scopes select the resource of pooled trees; the parser's own tree is standard
+  CountingMemoryResource counting;
+  YamlParser             parser;
+  {
+    YamlMemoryScope scope(&counting);
+    parser.parseString(document());
+  }
+  EXPECT_EQ(counting.allocations(), 0u);
+  EXPECT_EQ(parser.get("service").value.asMap().size(), 2u);
+}
+
+TEST_F(YamlMemoryTest, PooledTreeIsOneBlockOfTheResource) {
+  YamlParser parser;
+  parser.parseString(document());
+  CountingMemoryResource counting;
+  {
+    YamlPooledTree tree(parser.root(), &counting);
+    EXPECT_EQ(counting.allocations(), 1u);
+    EXPECT_EQ(counting.liveBytes(), tree.bytes());
+    EXPECT_EQ(tree.resource(), &counting);
+    EXPECT_FALSE(tree.isSequenceRoot());
+    EXPECT_EQ(tree.get("server").at("host").asString(), "localhost");
+    EXPECT_EQ(tree.get("server").at("ports").at(1).asInt(), 443);
+    EXPECT_EQ(tree.get("service").at("retries").asInt(), 3);
+    EXPECT_EQ(tree.get("service").at("hosts").size(), 2u);
+    EXPECT_EQ(YamlPrinter::toString(tree.root().toItem().value.asMap()), YamlPrinter::toString(parser.root()));
+  }
+  EXPECT_EQ(counting.liveBytes(), 0u);
+}
+
+TEST_F(YamlMemoryTest, PooledTreeUsesCurrentResourceAndMoves) {
+  YamlParser parser;
+  parser.parseString("- a\n- {b: 2}\n");
+  CountingMemoryResource counting;
+  {
+    std::unique_ptr<YamlPooledTree> tree;
+    {
+      YamlMemoryScope scope(&counting);
+      tree.reset(new YamlPooledTree(parser.sequenceRoot()));
+    }
+    EXPECT_EQ(tree->resource(), &counting);
+    EXPECT_TRUE(tree->isSequenceRoot());
+
+    YamlPooledTree moved(std::move(*tree));
+    EXPECT_EQ(moved.root().at(1).at("b").asInt(), 2);
+    EXPECT_THROW(tree->root(), SnapshotException);
+    tree.reset();
+    EXPECT_EQ(counting.allocations(), 1u);
+    EXPECT_EQ(counting.liveBytes(), moved.bytes());
+
+    YamlPooledTree other(parser.sequenceRoot(), &counting);
+    other = std::move(moved);
+    EXPECT_EQ(counting.liveBytes(), other.bytes());
+  }
+  EXPECT_EQ(counting.liveBytes(), 0u);
+}
+
+TEST_F(YamlMemoryTest, ArenaHoldsPooledTree) {
+  YamlArenaResource arena(256);
+  {
+    std::unique_ptr<YamlPooledTree> tree;
+    {
+      YamlParser parser;
+      parser.parseString(document());
+      tree.reset(new YamlPooledTree(parser.root(), &arena));
+    }
+    EXPECT_GE(arena.reservedBytes(), tree->bytes());
+    EXPECT_EQ(tree->get("server").at("ports").at(0).asInt(), 80);
+  }
+  arena.release();
+  EXPECT_EQ(arena.reservedBytes(), 0u);
+}
+
+TEST_F(YamlMemoryTest, ArenaServesLargeAndAlignedRequests) {
+  CountingMemoryResource upstream;
+  {
+    YamlArenaResource arena(64, &upstream);
+    void             *small = arena.allocate(8, 8);
+    void             *big   = arena.allocate(1000, 16);
+    EXPECT_NE(small, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 16, 0u);
+    EXPECT_GE(arena.reservedBytes(), 1000u);
+    arena.deallocate(big, 1000, 16); // no-op until release
+    EXPECT_GT(upstream.liveBytes(), 0u);
+  }
+  EXPECT_EQ(upstream.liveBytes(), 0u);
+}
+
+TEST_F(YamlMemoryTest, TallyCountsOnlyOutermostResource) {
+  CountingMemoryResource upstream;
+  CountingMemoryResource outer(&upstream);
+  YamlAllocationCounters counters;
+  {
+    YamlAllocationTally tally(counters);
+    void               *p = outer.allocate(100);
+    EXPECT_EQ(counters.allocations, 1u);
+    EXPECT_EQ(counters.allocatedBytes, 100u);
+    outer.deallocate(p, 100);
+  }
+  EXPECT_EQ(counters.liveBytes, 0);
+  EXPECT_EQ(counters.peakBytes, 100u);
+  EXPECT_EQ(upstream.allocations(), 1u);
+
+  // Allocations outside the tally are not counted
+  outer.deallocate(outer.allocate(10), 10);
+  EXPECT_EQ(counters.allocations, 1u);
+}
+
+TEST_F(YamlMemoryTest, TallyCountsHeapAllocations) {
+  // The unit tests link yamlparser_heap_tally, so plain new/delete is counted too
+  YamlAllocationCounters counters;
+  {
+    YamlAllocationTally tally(counters);
+    std::unique_ptr<std::string> text(new std::string(1000, 'x'));
+    EXPECT_GE(counters.allocatedBytes, 1000u);
+  }
+  EXPECT_GE(counters.allocations, 2u);
+  EXPECT_EQ(counters.liveBytes, 0);
+  EXPECT_GE(counters.peakBytes, 1000u);
+}
+
+TEST_F(YamlMemoryTest, ParseStatsReportAllocations) {
+  YamlParser parser;
+  ParseStats stats;
+  parser.parseString(document(), stats);
+  EXPECT_GT(stats.allocations, 0u);
+  EXPECT_GE(stats.allocatedBytes, stats.allocations);
+  EXPECT_GT(stats.peakAllocatedBytes, 0u);
+  EXPECT_LE(stats.peakAllocatedBytes, stats.allocatedBytes);
+}
+
+TEST_F(YamlMemoryTest, ParseStatsCountStringBuffers) {
+  std::string shortDoc = "a: x\n";
+  std::string longDoc  = "a: " + std::string(4096, 'x') + "\n";
+  ParseStats  stats[2];
+  for (int i = 0; i < 2; ++i) {
+    YamlParser parser;
+    parser.parseString(i == 0 ? shortDoc : longDoc, stats[i]);
+  }
+  EXPECT_GT(stats[0].allocatedBytes, 0u);
+  EXPECT_GE(stats[1].allocatedBytes, stats[0].allocatedBytes + 4096);
+}
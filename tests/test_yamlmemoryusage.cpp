@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "YamlMemory.hpp"
+#include "YamlMemoryUsage.hpp"
+#include "YamlParser.hpp"
+#include <string>
+
+using namespace yamlparser;
+
+class YamlMemoryUsageTest : public ::testing::Test {
+protected:
+  YamlParser parser;
+};
+
+TEST_F(YamlMemoryUsageTest, EmptyTreeUsesNothing) {
+  YamlMap         map;
+  YamlMemoryUsage usage = memoryUsage(map, 5);
+  EXPECT_EQ(usage.totalBytes(), 0u);
+  EXPECT_EQ(usage.nodes, 0u);
+  EXPECT_TRUE(usage.largest.empty());
+}
+
+TEST_F(YamlMemoryUsageTest, MatchesAllocationsOfParsedTree) {
+  // The unit tests count heap allocations (yamlparser_heap_tally); a copy of
+  // the tree made under a tally is the only thing alive in it afterwards
+  parser.parseString("server:\n"
+                     "  host: a-rather-long-host-name.example.com\n"
+                     "  ports: [80, 443, 8080]\n"
+                     "items:\n"
+                     "  - one\n"
+                     "  - two\n"
+                     "  - name: three\n"
+                     "    size: 3\n");
+  YamlAllocationCounters counters;
+  YamlMap                copy;
+  {
+    YamlAllocationTally tally(counters);
+    copy = parser.root();
+  }
+  YamlMemoryUsage usage = memoryUsage(copy);
+  EXPECT_EQ(static_cast<long long>(usage.totalBytes()), counters.liveBytes);
+  EXPECT_GT(usage.stringBytes, 0u);
+  EXPECT_EQ(usage.nodes, 12u);
+  EXPECT_EQ(usage.duplicateBytes, 0u);
+}
+
+TEST_F(YamlMemoryUsageTest, SequenceSlackIsReported) {
+  YamlSeq seq;
+  seq.reserve(10);
+  seq.push_back(YamlItem(YamlElement(1)));
+  seq.push_back(YamlItem(YamlElement(2)));
+  YamlMemoryUsage usage = memoryUsage(seq);
+  EXPECT_EQ(usage.sequenceBytes, 2 * sizeof(YamlItem));
+  EXPECT_EQ(usage.sequenceSlackBytes, 8 * sizeof(YamlItem));
+  EXPECT_EQ(usage.containerBytes, 0u); // the measured sequence itself is not heap-owned
+}
+
+TEST_F(YamlMemoryUsageTest, StringCapacityIsReported) {
+  std::string     text(100, 'x');
+  YamlElement     element(text);
+  YamlMemoryUsage usage = element.memoryUsage();
+  EXPECT_GE(usage.stringBytes, 101u);
+  EXPECT_EQ(usage.totalBytes(), usage.stringBytes);
+
+  YamlElement shortText(std::string("abc"));
+  EXPECT_EQ(shortText.memoryUsage().totalBytes(), 0u);
+}
+
+TEST_F(YamlMemoryUsageTest, AliasCopiesAreDuplicates) {
+  parser.parseString("defaults: &defaults\n"
+                     "  limits:\n"
+                     "    cpu: 2\n"
+                     "    memory: 512\n"
+                     "  region: eu\n"
+                     "copy: *defaults\n"
+                     "service:\n"
+                     "  <<: *defaults\n"
+                     "  name: api\n");
+  YamlMemoryUsage usage = parser.memoryUsage();
+
+  // "copy" repeats "defaults" entirely; the merge repeats the nested "limits" map
+  size_t copyBytes   = parser.get("copy").value.memoryUsage().totalBytes();
+  size_t limitsBytes = parser.get("service").value.asMap().at("limits").value.memoryUsage().totalBytes();
+  EXPECT_EQ(usage.duplicateBytes, copyBytes + limitsBytes);
+  EXPECT_LT(usage.duplicateBytes, usage.totalBytes());
+}
+
+TEST_F(YamlMemoryUsageTest, LargestSubtreesByPath) {
+  parser.parseString("small: 1\n"
+                     "big:\n"
+                     "  list: [1, 2, 3, 4, 5, 6, 7, 8]\n"
+                     "  more:\n"
+                     "    - x\n"
+                     "    - y\n"
+                     "medium:\n"
+                     "  a: 1\n");
+  YamlMemoryUsage usage = parser.memoryUsage(3);
+  ASSERT_EQ(usage.largest.size(), 3u);
+  EXPECT_EQ(usage.largest[0].path, "big");
+  EXPECT_EQ(usage.largest[1].path, "big.list");
+  EXPECT_GE(usage.largest[0].bytes, usage.largest[1].bytes);
+  EXPECT_GE(usage.largest[1].bytes, usage.largest[2].bytes);
+
+  // Sequence items are addressed by index
+  YamlMemoryUsage all = parser.memoryUsage(100);
+  bool            found = false;
+  for (const auto &subtree : all.largest)
+    found = found || subtree.path == "big.more";
+  EXPECT_TRUE(found);
+  EXPECT_NE(all.toString().find("big.list"), std::string::npos);
+}
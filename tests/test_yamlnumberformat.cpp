@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "YamlNumberFormat.hpp"
+#include "YamlPrinter.hpp"
+#include "YamlParser.hpp"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlNumberFormatTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(YamlNumberFormatTest, FormatsIntegers) {
+  EXPECT_EQ(YamlNumberFormat::toString(0), "0");
+  EXPECT_EQ(YamlNumberFormat::toString(7), "7");
+  EXPECT_EQ(YamlNumberFormat::toString(42), "42");
+  EXPECT_EQ(YamlNumberFormat::toString(-305), "-305");
+  EXPECT_EQ(YamlNumberFormat::toString(1000000), "1000000");
+  EXPECT_EQ(YamlNumberFormat::toString(INT_MAX), "2147483647");
+  EXPECT_EQ(YamlNumberFormat::toString(INT_MIN), "-2147483648");
+}
+
+TEST_F(YamlNumberFormatTest, FormatsDoublesWithShortestText) {
+  EXPECT_EQ(YamlNumberFormat::toString(0.1), "0.1");
+  EXPECT_EQ(YamlNumberFormat::toString(1.5), "1.5");
+  EXPECT_EQ(YamlNumberFormat::toString(-2.25), "-2.25");
+  EXPECT_EQ(YamlNumberFormat::toString(3.14159), "3.14159");
+  EXPECT_EQ(YamlNumberFormat::toString(0.1 + 0.2), "0.30000000000000004");
+  EXPECT_EQ(YamlNumberFormat::toString(1.0 / 3.0), "0.3333333333333333");
+  EXPECT_EQ(YamlNumberFormat::toString(1e20), "1e+20");
+  EXPECT_EQ(YamlNumberFormat::toString(1.5e-7), "1.5e-07");
+  EXPECT_EQ(YamlNumberFormat::toString(5e-324), "5e-324");
+  EXPECT_EQ(YamlNumberFormat::toString(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+}
+
+TEST_F(YamlNumberFormatTest, IntegralDoublesKeepDecimalPoint) {
+  EXPECT_EQ(YamlNumberFormat::toString(1.0), "1.0");
+  EXPECT_EQ(YamlNumberFormat::toString(-42.0), "-42.0");
+  EXPECT_EQ(YamlNumberFormat::toString(0.0), "0.0");
+  EXPECT_EQ(YamlNumberFormat::toString(-0.0), "-0.0");
+  EXPECT_EQ(YamlNumberFormat::toString(123456789012345.0), "123456789012345.0");
+}
+
+TEST_F(YamlNumberFormatTest, NonFiniteValuesUseYamlForms) {
+  EXPECT_EQ(YamlNumberFormat::toString(std::numeric_limits<double>::infinity()), ".inf");
+  EXPECT_EQ(YamlNumberFormat::toString(-std::numeric_limits<double>::infinity()), "-.inf");
+  EXPECT_EQ(YamlNumberFormat::toString(std::numeric_limits<double>::quiet_NaN()), ".nan");
+}
+
+TEST_F(YamlNumberFormatTest, RandomDoublesRoundTripExactly) {
+  std::mt19937_64 rng(20240611);
+  char            buf[YamlNumberFormat::BUFFER_SIZE + 1];
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t bits = rng();
+    double   value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (value != value || value - value != 0.0)
+      continue; // skip NaN and infinities
+    size_t len = YamlNumberFormat::formatDouble(value, buf);
+    ASSERT_LE(len, YamlNumberFormat::BUFFER_SIZE);
+    buf[len] = '\0';
+    ASSERT_EQ(std::strtod(buf, nullptr), value) << buf;
+  }
+}
+
+TEST_F(YamlNumberFormatTest, PrintedNumbersParseBackWithSameType) {
+  YamlMap map;
+  map["ratio"]  = YamlItem(YamlElement(0.1));
+  map["whole"]  = YamlItem(YamlElement(2.0));
+  map["big"]    = YamlItem(YamlElement(6.02214076e23));
+  map["tiny"]   = YamlItem(YamlElement(1.6e-19));
+  map["count"]  = YamlItem(YamlElement(-17));
+  map["thirds"] = YamlItem(YamlElement(2.0 / 3.0));
+
+  const std::string fname = "test_numberformat_roundtrip.yaml";
+  {
+    std::ofstream ofs(fname);
+    YamlPrinter::print(map, ofs);
+  }
+  YamlParser parser;
+  parser.parse(fname);
+  const auto &root = parser.root();
+  for (const char *key : {"ratio", "whole", "big", "tiny", "thirds"}) {
+    ASSERT_TRUE(root.at(key).value.isDouble()) << key;
+    EXPECT_EQ(root.at(key).value.asDouble(), map.at(key).value.asDouble()) << key;
+  }
+  ASSERT_TRUE(root.at("count").value.isInt());
+  EXPECT_EQ(root.at("count").value.asInt(), -17);
+  std::remove(fname.c_str());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "YamlOutputBuffer.hpp"
+#include "YamlException.hpp"
+#include <sstream>
+#include <string>
+
+using namespace yamlparser;
+
+// Stream buffer that counts write calls, to verify chunked output
+class CountingStreambuf : public std::stringbuf {
+public:
+  int writes = 0;
+  int syncs  = 0;
+
+protected:
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    ++writes;
+    return std::stringbuf::xsputn(s, n);
+  }
+  int sync() override {
+    ++syncs;
+    return std::stringbuf::sync();
+  }
+};
+
+class YamlOutputBufferTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(YamlOutputBufferTest, GrowableBufferCollectsAllAppends) {
+  YamlOutputBuffer out;
+  out.append("key", 3);
+  out.append(std::string(": "));
+  out.append('v');
+  out.appendIndent(3);
+  out.append('\n');
+  EXPECT_EQ(out.str(), "key: v   \n");
+  EXPECT_EQ(out.size(), 10u);
+
+  // Growth beyond the initial capacity keeps earlier content
+  std::string big(100000, 'x');
+  out.append(big);
+  EXPECT_EQ(out.size(), 10u + big.size());
+  EXPECT_EQ(out.str().substr(0, 10), "key: v   \n");
+
+  out.clear();
+  EXPECT_EQ(out.size(), 0u);
+}
+
+TEST_F(YamlOutputBufferTest, AppendIndentHandlesLargeAndNegativeCounts) {
+  YamlOutputBuffer out;
+  out.appendIndent(300);
+  EXPECT_EQ(out.str(), std::string(300, ' '));
+  out.clear();
+  out.appendIndent(-4);
+  EXPECT_EQ(out.size(), 0u);
+}
+
+TEST_F(YamlOutputBufferTest, FixedBufferWritesInPlaceAndThrowsOnOverflow) {
+  char storage[8];
+  {
+    YamlOutputBuffer out(storage, sizeof(storage));
+    out.append("abcd", 4);
+    EXPECT_EQ(out.data(), storage);
+    EXPECT_EQ(std::string(storage, out.size()), "abcd");
+    out.append("efgh", 4);
+    EXPECT_THROW(out.append('!'), OutputException);
+    EXPECT_EQ(out.size(), 8u);
+  }
+  EXPECT_EQ(std::string(storage, 8), "abcdefgh");
+}
+
+TEST_F(YamlOutputBufferTest, StreamModeWritesInChunksWithoutFlushing) {
+  CountingStreambuf sb;
+  std::ostream      os(&sb);
+  {
+    YamlOutputBuffer out(os, 16);
+    for (int i = 0; i < 10; ++i) {
+      out.append("line\n", 5); // 50 bytes total
+    }
+    EXPECT_EQ(sb.writes, 3); // 3 full chunks written so far, 5 bytes pending
+    out.flush();
+    EXPECT_EQ(sb.writes, 4);
+  }
+  EXPECT_EQ(sb.str().size(), 50u);
+  EXPECT_EQ(sb.syncs, 0);
+}
+
+TEST_F(YamlOutputBufferTest, StreamModeWritesRemainderOnDestruction) {
+  std::ostringstream os;
+  {
+    YamlOutputBuffer out(os);
+    out.append("pending");
+    EXPECT_TRUE(os.str().empty());
+  }
+  EXPECT_EQ(os.str(), "pending");
+}
+
+TEST_F(YamlOutputBufferTest, StreamModeChunkGrowsFromSmallBlock) {
+  CountingStreambuf sb;
+  std::ostream      os(&sb);
+  {
+    YamlOutputBuffer out(os);
+    out.append("key: value\n");
+    EXPECT_LT(out.capacity(), YamlOutputBuffer::DEFAULT_CHUNK_SIZE);
+
+    // Grows up to one chunk before the first write, keeping pending bytes
+    out.append(std::string(YamlOutputBuffer::DEFAULT_CHUNK_SIZE - 11, 'x'));
+    EXPECT_EQ(out.capacity(), YamlOutputBuffer::DEFAULT_CHUNK_SIZE);
+    EXPECT_EQ(sb.writes, 0);
+    out.append('y');
+    EXPECT_EQ(sb.writes, 1);
+  }
+  EXPECT_EQ(sb.str().size(), YamlOutputBuffer::DEFAULT_CHUNK_SIZE + 1);
+  EXPECT_EQ(sb.str().substr(0, 11), "key: value\n");
+}
+
+TEST_F(YamlOutputBufferTest, StreamModeLargeAppendBypassesChunk) {
+  CountingStreambuf sb;
+  std::ostream      os(&sb);
+  YamlOutputBuffer  out(os, 8);
+  out.append("ab", 2);
+  out.append(std::string(100, 'z'));
+  out.flush();
+  EXPECT_EQ(sb.str(), "ab" + std::string(100, 'z'));
+  EXPECT_EQ(sb.writes, 2);
+}
+
+TEST_F(YamlOutputBufferTest, StreamErrorThrows) {
+  std::ostringstream os;
+  os.setstate(std::ios::badbit);
+  YamlOutputBuffer out(os);
+  out.append("data");
+  EXPECT_THROW(out.flush(), OutputException);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "YamlParseCache.hpp"
+#include "YamlSnapshot.hpp"
+#include "YamlDiff.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlParseCacheTest : public ::testing::Test {
+protected:
+  // Named after the test, so tests run in parallel processes do not share entries
+  const std::string testName = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  const std::string cacheDir = "test_parse_cache_" + testName;
+  const std::string yamlName = "test_parse_cache_" + testName + "_input.yaml";
+
+  void TearDown() override {
+    YamlParseCache cache(cacheDir);
+    for (const std::string &content : written)
+      std::remove(cache.entryPath(content).c_str());
+    std::remove(yamlName.c_str());
+    std::remove(cacheDir.c_str());
+  }
+
+  void writeYaml(const std::string &content) {
+    std::ofstream ofs(yamlName, std::ios::binary);
+    ofs << content;
+    written.push_back(content);
+  }
+
+  static bool exists(const std::string &path) {
+    std::ifstream file(path);
+    return file.good();
+  }
+
+  std::vector<std::string> written;
+};
+
+TEST_F(YamlParseCacheTest, MissWritesEntryAndHitLoadsIt) {
+  writeYaml("server:\n  host: localhost\n  port: 8080\nregions:\n  - eu\n  - us\n");
+  YamlParseCache cache(cacheDir);
+
+  YamlParser first;
+  cache.parse(first, yamlName);
+  EXPECT_EQ(cache.misses(), 1u);
+  EXPECT_EQ(cache.hits(), 0u);
+  EXPECT_TRUE(exists(cache.entryPath(written.back())));
+
+  YamlParser second;
+  cache.parse(second, yamlName);
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_FALSE(second.isSequenceRoot());
+  EXPECT_EQ(second.get("server").value.asMap().at("port").value.asInt(), 8080);
+  EXPECT_EQ(YamlHashTree(second.root()).hash(), YamlHashTree(first.root()).hash());
+}
+
+TEST_F(YamlParseCacheTest, ChangedContentMisses) {
+  YamlParseCache cache(cacheDir);
+  YamlParser     parser;
+  writeYaml("value: 1\n");
+  cache.parse(parser, yamlName);
+  writeYaml("value: 2\n");
+  cache.parse(parser, yamlName);
+  EXPECT_EQ(cache.misses(), 2u);
+  EXPECT_EQ(parser.get("value").value.asInt(), 2);
+  EXPECT_NE(cache.entryPath(written[0]), cache.entryPath(written[1]));
+}
+
+TEST_F(YamlParseCacheTest, EntriesAreKeyedBySha256) {
+  YamlParseCache cache(cacheDir);
+  std::string    prefix = cacheDir + "/v7-";
+  EXPECT_EQ(cache.entryPath(""), prefix + "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855.snap");
+  EXPECT_EQ(cache.entryPath("abc"), prefix + "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad.snap");
+  // 56 bytes: the length no longer fits in the first padding block
+  EXPECT_EQ(cache.entryPath("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            prefix + "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1.snap");
+  EXPECT_EQ(cache.entryPath(std::string(1000000, 'a')),
+            prefix + "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0.snap");
+}
+
+TEST_F(YamlParseCacheTest, CorruptEntryIsRebuilt) {
+  writeYaml("- 1\n- 2\n- 3\n");
+  YamlParseCache cache(cacheDir);
+  {
+    std::ofstream bad(cache.entryPath(written.back()), std::ios::binary);
+    bad << "not a snapshot";
+  }
+  YamlParser parser;
+  cache.parse(parser, yamlName);
+  EXPECT_EQ(cache.misses(), 1u);
+  ASSERT_TRUE(parser.isSequenceRoot());
+  EXPECT_EQ(parser.sequenceRoot().size(), 3u);
+
+  YamlParser again;
+  cache.parse(again, yamlName);
+  EXPECT_EQ(cache.hits(), 1u);
+  ASSERT_TRUE(again.isSequenceRoot());
+  EXPECT_EQ(again.sequenceRoot()[2].value.asInt(), 3);
+}
+
+TEST_F(YamlParseCacheTest, EnsureReturnsMappableEntry) {
+  writeYaml("name: demo\nlimits:\n  cpu: 2\n");
+  YamlParseCache cache(cacheDir);
+  std::string    path = cache.ensure(yamlName);
+  EXPECT_EQ(cache.misses(), 1u);
+  EXPECT_EQ(cache.ensure(yamlName), path);
+  EXPECT_EQ(cache.hits(), 1u);
+
+  YamlSnapshotView view(path);
+  EXPECT_EQ(view.get("limits").at("cpu").asInt(), 2);
+}
+
+TEST_F(YamlParseCacheTest, MissingFileThrows) {
+  YamlParseCache cache(cacheDir);
+  YamlParser     parser;
+  EXPECT_THROW(cache.parse(parser, "no_such_input.yaml"), FileException);
+  EXPECT_THROW(cache.ensure("no_such_input.yaml"), FileException);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "YamlParser.hpp"
+#include "YamlParseLimits.hpp"
+#include "YamlParseStats.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlParseLimitsTest : public ::testing::Test {
+protected:
+  const std::string fileName = "test_limits_input.yaml";
+
+  void TearDown() override {
+    std::remove(fileName.c_str());
+  }
+
+  static const char *document() {
+    return "defaults: &defaults\n"
+           "  timeout: 30\n"
+           "  retries: 2\n"
+           "service:\n"
+           "  <<: *defaults\n"
+           "  name: api\n"
+           "  ports: [80, [443, 8443]]\n"
+           "  hosts:\n"
+           "    - a\n"
+           "    - name: b\n"
+           "      weight: 2\n"
+           "copy: *defaults\n"
+           "notes: |\n"
+           "  line one\n";
+  }
+
+  // Each anchor holds two aliases of the previous one: 2^levels copies of the first
+  static std::string aliasBomb(size_t levels) {
+    std::string doc = "a0: &a0\n  x: 1\n  y: 2\n";
+    for (size_t i = 1; i <= levels; ++i) {
+      std::string prev = "*a" + std::to_string(i - 1);
+      doc += "a" + std::to_string(i) + ": &a" + std::to_string(i) + "\n  p: " + prev + "\n  q: " + prev + "\n";
+    }
+    return doc;
+  }
+
+  // Expects the parse to throw LimitException for the named limit
+  static void expectLimit(YamlParser &parser, const std::string &doc, const std::string &limit) {
+    try {
+      parser.parseString(doc);
+      ADD_FAILURE() << "no LimitException for " << limit;
+    } catch (const LimitException &e) {
+      EXPECT_EQ(e.limit(), limit) << e.what();
+    }
+  }
+};
+
+TEST_F(YamlParseLimitsTest, DefaultsAreUnlimited) {
+  YamlParser parser;
+  EXPECT_TRUE(parser.limits().unlimited());
+  EXPECT_FALSE(ParseLimits::untrusted().unlimited());
+  parser.parseString(document());
+
+  YamlParser limited(ParseLimits::untrusted());
+  EXPECT_EQ(limited.limits().maxDepth, 64u);
+  limited.parseString(document());
+  EXPECT_EQ(limited.root().at("service").value.asMap().at("timeout").value.asInt(), 30);
+}
+
+TEST_F(YamlParseLimitsTest, InputBytes) {
+  std::string doc = document();
+  ParseLimits limits;
+  limits.maxInputBytes = doc.size();
+  YamlParser parser(limits);
+  parser.parseString(doc);
+  expectLimit(parser, doc + "extra: 1\n", "input bytes");
+}
+
+TEST_F(YamlParseLimitsTest, OversizedFileIsRejected) {
+  {
+    std::ofstream ofs(fileName);
+    ofs << document();
+  }
+  ParseLimits limits;
+  limits.maxInputBytes = 16;
+  YamlParser parser(limits);
+  EXPECT_THROW(parser.parse(fileName), LimitException);
+  limits.maxInputBytes = 4096;
+  parser.setLimits(limits);
+  parser.parse(fileName);
+  EXPECT_TRUE(parser.root().count("copy"));
+}
+
+TEST_F(YamlParseLimitsTest, DepthMatchesParseStats) {
+  YamlParser parser;
+  ParseStats stats;
+  parser.parseString(document(), stats);
+  ASSERT_EQ(stats.maxDepth, 4u);
+
+  ParseLimits limits;
+  limits.maxDepth = stats.maxDepth;
+  parser.setLimits(limits);
+  parser.parseString(document());
+  limits.maxDepth = stats.maxDepth - 1;
+  parser.setLimits(limits);
+  expectLimit(parser, document(), "nesting depth");
+}
+
+TEST_F(YamlParseLimitsTest, DeepInlineSequenceIsRejectedBeforeParsing) {
+  YamlParser parser(ParseLimits::untrusted());
+  expectLimit(parser, "a: " + std::string(100000, '[') + std::string(100000, ']') + "\n", "nesting depth");
+  // Brackets inside quotes do not nest
+  parser.parseString("a: [\"[[[[\", x]\n");
+}
+
+TEST_F(YamlParseLimitsTest, DeepBlockNestingReportsTheLine) {
+  std::string doc;
+  for (size_t depth = 0; depth < 100; ++depth)
+    doc += std::string(depth, ' ') + "k:\n";
+  doc += std::string(100, ' ') + "leaf: 1\n";
+  ParseLimits limits;
+  limits.maxDepth = 10;
+  YamlParser parser(limits);
+  try {
+    parser.parseString(doc);
+    FAIL() << "no LimitException";
+  } catch (const LimitException &e) {
+    EXPECT_NE(std::string(e.what()).find("nesting depth (maximum 10) at line 11"), std::string::npos) << e.what();
+  }
+}
+
+TEST_F(YamlParseLimitsTest, NodeCountMatchesParseStats) {
+  YamlParser parser;
+  ParseStats stats;
+  parser.parseString(document(), stats);
+
+  ParseLimits limits;
+  limits.maxNodes = stats.totalNodes();
+  parser.setLimits(limits);
+  parser.parseString(document());
+  limits.maxNodes = stats.totalNodes() - 1;
+  parser.setLimits(limits);
+  expectLimit(parser, document(), "node count");
+}
+
+TEST_F(YamlParseLimitsTest, ScalarBytes) {
+  ParseLimits limits;
+  limits.maxScalarBytes = 8;
+  YamlParser parser(limits);
+  parser.parseString("key: 12345678\nseq:\n  - abc\n");
+  expectLimit(parser, "key: 123456789\n", "scalar bytes");
+  expectLimit(parser, "a_long_key_name: 1\n", "scalar bytes");
+  expectLimit(parser, "seq:\n  - 123456789\n", "scalar bytes");
+  expectLimit(parser, "text: |\n  1234\n  5678\n", "scalar bytes");
+  expectLimit(parser, "list: [1, 2, 3, 4]\n", "scalar bytes");
+}
+
+TEST_F(YamlParseLimitsTest, AliasBombFailsFast) {
+  YamlParser parser(ParseLimits::untrusted());
+  ParseStats stats;
+  try {
+    parser.parseString(aliasBomb(40), stats);
+    FAIL() << "no LimitException";
+  } catch (const LimitException &e) {
+    EXPECT_EQ(e.limit(), "alias expansion nodes");
+  }
+  // The exponential copy was never made
+  EXPECT_LT(stats.allocatedBytes, 4u * 1024 * 1024);
+}
+
+TEST_F(YamlParseLimitsTest, MergeKeysCountOnlyCopiedEntries) {
+  const std::string doc = "base: &base\n"
+                          "  a: 1\n"
+                          "  b: 2\n"
+                          "  c: [3, 4]\n"
+                          "one:\n"
+                          "  <<: *base\n"
+                          "two:\n"
+                          "  a: 0\n"
+                          "  <<: *base\n";
+  // one copies a, b and the sequence c with its two items; two copies b and c
+  ParseLimits limits;
+  limits.maxAliasNodes = 9;
+  YamlParser parser(limits);
+  parser.parseString(doc);
+  EXPECT_EQ(parser.root().at("two").value.asMap().at("a").value.asInt(), 0);
+  limits.maxAliasNodes = 8;
+  parser.setLimits(limits);
+  expectLimit(parser, doc, "alias expansion nodes");
+}
+
+TEST_F(YamlParseLimitsTest, AliasCopiesCountTowardsDepth) {
+  const std::string doc = "deep: &deep\n"
+                          "  a:\n"
+                          "    b: 1\n"
+                          "outer:\n"
+                          "  inner: *deep\n";
+  ParseLimits limits;
+  limits.maxDepth = 4;
+  YamlParser parser(limits);
+  parser.parseString(doc);
+  limits.maxDepth = 3;
+  parser.setLimits(limits);
+  expectLimit(parser, doc, "nesting depth");
+}
+
+TEST_F(YamlParseLimitsTest, AnchorsDoNotCarryOverBetweenDocuments) {
+  YamlParser parser;
+  parser.parseString("a: &x\n  k: 1\n");
+  EXPECT_THROW(parser.parseString("b: *x\n"), KeyException);
+}
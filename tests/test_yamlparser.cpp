@@ -344,3 +344,65 @@ TEST_F(YamlParserTest, InlineArrayInNestedSequence) {
   // Cleanup
   std::remove("test_inline_matrix.yaml");
 }
+
+TEST_F(YamlParserTest, ParseStringMatchesParseFile) {
+  std::string yaml = "name: demo\nitems:\n  - 1\n  - two\nnested:\n  flag: true\n";
+  {
+    std::ofstream ofs("test_parse_string.yaml");
+    ofs << yaml;
+  }
+  parser.parse("test_parse_string.yaml");
+  YamlParser fromString;
+  fromString.parseString(yaml);
+  EXPECT_EQ(YamlPrinter::toString(fromString.root()), YamlPrinter::toString(parser.root()));
+
+  // A missing final newline and a sequence root are handled like files
+  fromString.parseString("- a\n- b");
+  ASSERT_TRUE(fromString.isSequenceRoot());
+  EXPECT_EQ(fromString.sequenceRoot().size(), 2u);
+  EXPECT_EQ(fromString.sequenceRoot()[1].value.asString(), "b");
+  std::remove("test_parse_string.yaml");
+}
+
+TEST_F(YamlParserTest, QuotedScalarEscapes) {
+  parser.parseString("tab: \"a\\tb\"\n"
+                     "quote: \"say \\\"hi\\\"\"\n"
+                     "euro: \"\\u20ac\"\n"
+                     "single: 'it''s \\n'\n"
+                     "list: [\"a\\\"b, c\", 'd''e', \"x\\\\\"]\n"
+                     "map: {\"k\\u0041\": 'v'}\n");
+  EXPECT_EQ(parser.root().at("tab").value.asString(), "a\tb");
+  EXPECT_EQ(parser.root().at("quote").value.asString(), "say \"hi\"");
+  EXPECT_EQ(parser.root().at("euro").value.asString(), "\xE2\x82\xAC");
+  EXPECT_EQ(parser.root().at("single").value.asString(), "it's \\n");
+  const YamlSeq &list = parser.root().at("list").value.asSeq();
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[0].value.asString(), "a\"b, c");
+  EXPECT_EQ(list[1].value.asString(), "d'e");
+  EXPECT_EQ(list[2].value.asString(), "x\\");
+  EXPECT_EQ(parser.root().at("map").value.asMap().at("kA").value.asString(), "v");
+
+  // Decoded control characters are printed as escapes, so the output parses back to the same value
+  std::string printed = YamlPrinter::toString(parser.root());
+  EXPECT_NE(printed.find("tab: \"a\\tb\""), std::string::npos) << printed;
+  YamlParser reparsed;
+  reparsed.parseString(printed);
+  EXPECT_EQ(reparsed.root().at("tab").value.asString(), "a\tb");
+
+  EXPECT_THROW(parser.parseString("path: \"C:\\Users\"\n"), SyntaxException);
+
+  // Invalid escapes report the line of the scalar
+  const char *documents[] = {"a: 1\nb: 2\npath: \"C:\\Users\"\n", "a: 1\nb: 2\nlist:\n  - \"\\q\"\n",
+                             "a: 1\nb: 2\nc:\n  - k: \"\\x4\"\n    z: 1\n", "a: 1\nb: 2\nm: {\"\\q\": 1}\n"};
+  const size_t lines[]     = {3, 4, 4, 3};
+  for (size_t i = 0; i < 4; ++i) {
+    try {
+      parser.parseString(documents[i]);
+      ADD_FAILURE() << documents[i];
+    } catch (const SyntaxException &e) {
+      EXPECT_EQ(e.line(), lines[i]) << documents[i];
+      EXPECT_NE(std::string(e.what()).find("at line " + std::to_string(lines[i]) + ":"), std::string::npos)
+          << e.what();
+    }
+  }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "YamlParser.hpp"
+#include "YamlParseStats.hpp"
+#include "YamlException.hpp"
+#include "YamlPrinter.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace yamlparser;
+
+class YamlParseStatsTest : public ::testing::Test {
+protected:
+  YamlParser parser;
+  ParseStats stats;
+
+  static const char *document() {
+    return "defaults: &defaults\n"
+           "  timeout: 30\n"
+           "  ratio: 0.5\n"
+           "service:\n"
+           "  <<: *defaults\n"
+           "  name: api\n"
+           "  ports: [80, 443]\n"
+           "  hosts:\n"
+           "    - a\n"
+           "    - b\n"
+           "copy: *defaults\n"
+           "notes: |\n"
+           "  line one\n"
+           "  line two\n"
+           "enabled: true\n";
+  }
+};
+
+TEST_F(YamlParseStatsTest, CountsLinesNodesAndReferences) {
+  parser.parseString(document(), stats);
+
+  EXPECT_EQ(stats.lines, 15u);
+  EXPECT_EQ(stats.anchors, 1u);
+  EXPECT_EQ(stats.aliases, 1u);
+  EXPECT_EQ(stats.mergeKeys, 1u);
+  // service.hosts[0] is the deepest node
+  EXPECT_EQ(stats.maxDepth, 3u);
+
+  // Root, defaults, service and copy are maps; merged and aliased keys are copies
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::MAP), 4u);
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::SEQ), 2u);
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::INT), 5u);    // 3x timeout, 80, 443
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::DOUBLE), 3u); // 3x ratio
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::STRING), 4u); // name, a, b, notes
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::BOOL), 1u);
+  EXPECT_EQ(stats.totalNodes(), 19u);
+
+  // "30" "0.5" "api" "[80, 443]" "a" "b" "true" plus the literal's "line one\nline two\n"
+  EXPECT_EQ(stats.scalarBytes, 2u + 3u + 3u + 9u + 1u + 1u + 4u + 18u);
+}
+
+TEST_F(YamlParseStatsTest, SequenceRootIsCounted) {
+  parser.parseString("- 1\n- x: 2\n  y: 3\n", stats);
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::SEQ), 1u);
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::MAP), 1u);
+  EXPECT_EQ(stats.nodeCount(YamlElement::ElementType::INT), 3u);
+  EXPECT_EQ(stats.maxDepth, 2u);
+}
+
+TEST_F(YamlParseStatsTest, PhasesAreTimed) {
+  {
+    std::ofstream ofs("test_parse_stats.yaml");
+    ofs << document();
+  }
+  parser.parse("test_parse_stats.yaml", stats);
+  std::remove("test_parse_stats.yaml");
+
+  EXPECT_GT(stats.readSeconds, 0.0);
+  EXPECT_GT(stats.scanSeconds, 0.0);
+  EXPECT_GE(stats.buildSeconds, 0.0);
+  EXPECT_GT(stats.scalarSeconds, 0.0);
+  EXPECT_DOUBLE_EQ(stats.totalSeconds(),
+                   stats.readSeconds + stats.scanSeconds + stats.buildSeconds + stats.scalarSeconds);
+
+  // parseString has no read phase
+  parser.parseString(document(), stats);
+  EXPECT_EQ(stats.readSeconds, 0.0);
+}
+
+TEST_F(YamlParseStatsTest, StatsDoNotChangeTheResult) {
+  YamlParser plain;
+  plain.parseString(document());
+  parser.parseString(document(), stats);
+  EXPECT_EQ(YamlPrinter::toString(parser.root()), YamlPrinter::toString(plain.root()));
+}
+
+TEST_F(YamlParseStatsTest, StatsAreResetAndDetached) {
+  parser.parseString(document(), stats);
+  parser.parseString("a: 1\n", stats);
+  EXPECT_EQ(stats.lines, 1u);
+  EXPECT_EQ(stats.anchors, 0u);
+  EXPECT_EQ(stats.totalNodes(), 2u);
+
+  // A later parse without stats leaves the previous ones untouched
+  parser.parseString(document());
+  EXPECT_EQ(stats.lines, 1u);
+}
+
+TEST_F(YamlParseStatsTest, FailedParseDetachesStats) {
+  EXPECT_THROW(parser.parseString("a: *missing\n", stats), KeyException);
+  parser.parseString(document());
+  EXPECT_EQ(stats.aliases, 0u);
+  EXPECT_THROW(parser.parse("no_such_file.yaml", stats), FileException);
+}
+
+TEST_F(YamlParseStatsTest, NestedCollectionsAreNotCopiedPerLevel) {
+  // Mappings nested in mappings and in sequence items, 40 levels deep
+  std::string doc;
+  size_t      indent = 0;
+  for (size_t depth = 0; depth < 40; ++depth) {
+    std::string pad(indent, ' ');
+    if (depth % 2) {
+      doc += pad + "items:\n" + pad + "  - id: " + std::to_string(depth) + "\n";
+      indent += 4;
+    } else {
+      doc += pad + "value: " + std::to_string(depth) + "\n" + pad + "level:\n";
+      indent += 2;
+    }
+  }
+  doc += std::string(indent, ' ') + "leaf: end\n";
+  parser.parseString(doc, stats);
+  EXPECT_EQ(stats.maxDepth, 61u);
+  // Each subtree is moved into its parent; copying it per level would allocate quadratically
+  EXPECT_LE(stats.allocations, 3 * stats.totalNodes());
+}
+
+TEST_F(YamlParseStatsTest, ReportListsAllCounters) {
+  parser.parseString(document(), stats);
+  std::string report = stats.toString();
+  EXPECT_NE(report.find("lines: 15\n"), std::string::npos);
+  EXPECT_NE(report.find("nodes: 19 (null 0, string 4, double 3, int 5, bool 1, seq 2, map 4)"), std::string::npos);
+  EXPECT_NE(report.find("merge keys: 1\n"), std::string::npos);
+  EXPECT_NE(report.find("time: "), std::string::npos);
+}
@@ -221,4 +221,44 @@ TEST_F(YamlPrinterTest, PrintDeeplyNestedStructure) {
   EXPECT_NE(out.find("level2:"), std::string::npos);
   EXPECT_NE(out.find("- deep"), std::string::npos);
   EXPECT_NE(out.find("- 42"), std::string::npos);
-}
\ No newline at end of file
+}
+
+TEST_F(YamlPrinterTest, BufferAndStreamOutputMatchExactly) {
+  YamlMap nested;
+  nested["c"] = YamlItem(YamlElement(std::string("x")));
+  YamlSeq seq;
+  seq.push_back(YamlItem(YamlElement(1)));
+  seq.push_back(YamlItem(YamlElement(-2)));
+  YamlMap map;
+  map["a"] = YamlItem(YamlElement(1.5));
+  map["b"] = YamlItem(YamlElement(nested));
+  map["s"] = YamlItem(YamlElement(seq));
+  map["q"] = YamlItem(YamlElement(std::string("it's: here")));
+
+  const std::string expected = "a: 1.5\nb: \n    c: x\nq: 'it''s: here'\ns: \n    - 1\n    - -2\n";
+
+  std::stringstream ss;
+  YamlPrinter::print(map, ss);
+  EXPECT_EQ(ss.str(), expected);
+
+  YamlOutputBuffer out;
+  YamlPrinter::print(map, out);
+  EXPECT_EQ(out.str(), expected);
+
+  EXPECT_EQ(YamlPrinter::toString(map), expected);
+  EXPECT_EQ(YamlPrinter::toString(seq), "- 1\n- -2\n");
+}
+
+TEST_F(YamlPrinterTest, PrintIntoFixedBuffer) {
+  YamlMap map;
+  map["key"] = YamlItem(YamlElement(std::string("value")));
+
+  char             storage[64];
+  YamlOutputBuffer out(storage, sizeof(storage));
+  YamlPrinter::print(map, out);
+  EXPECT_EQ(std::string(storage, out.size()), "key: value\n");
+
+  char             tiny[4];
+  YamlOutputBuffer small(tiny, sizeof(tiny));
+  EXPECT_THROW(YamlPrinter::print(map, small), OutputException);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "YamlScanner.hpp"
+#include "YamlParser.hpp"
+#include <string>
+
+using namespace yamlparser;
+
+class YamlScannerTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(YamlScannerTest, ClassifiesLines) {
+  std::string text = "a: 1\n"
+                     "\n"
+                     "  \t\n"
+                     "  # note: x\n"
+                     "  - item\n"
+                     "plain text\n";
+  YamlScanner scanner(text);
+  ASSERT_EQ(scanner.size(), 6u);
+  EXPECT_EQ(scanner[0].kind, YamlTokenKind::Entry);
+  EXPECT_EQ(scanner[1].kind, YamlTokenKind::Blank);
+  EXPECT_EQ(scanner[2].kind, YamlTokenKind::Blank);
+  EXPECT_EQ(scanner[3].kind, YamlTokenKind::Comment);
+  EXPECT_EQ(scanner[4].kind, YamlTokenKind::SequenceItem);
+  EXPECT_EQ(scanner[4].indent, 2u);
+  EXPECT_EQ(scanner[4].line, 5u);
+  EXPECT_TRUE(scanner.text(scanner[1]).empty());
+  EXPECT_EQ(scanner[5].kind, YamlTokenKind::Entry);
+  EXPECT_FALSE(scanner[5].hasColon);
+}
+
+TEST_F(YamlScannerTest, FinalNewlineDoesNotStartALine) {
+  std::string empty;
+  EXPECT_EQ(YamlScanner(empty).size(), 0u);
+  std::string one = "a: 1\n";
+  EXPECT_EQ(YamlScanner(one).size(), 1u);
+  std::string unterminated = "a: 1\nb: 2";
+  EXPECT_EQ(YamlScanner(unterminated).size(), 2u);
+  std::string trailingBlank = "a: 1\n\n";
+  EXPECT_EQ(YamlScanner(trailingBlank).size(), 2u);
+}
+
+TEST_F(YamlScannerTest, SplitsAtTheFirstColonAndTrims) {
+  std::string text = "  key \t:  http://host:80  \t\n";
+  YamlScanner scanner(text);
+  const YamlToken &token = scanner[0];
+  EXPECT_TRUE(token.hasColon);
+  EXPECT_EQ(token.indent, 2u);
+  EXPECT_EQ(scanner.str(scanner.key(token)), "key");
+  EXPECT_EQ(scanner.str(scanner.value(token)), "http://host:80");
+  EXPECT_EQ(scanner.str(scanner.text(token)), "key \t:  http://host:80");
+  EXPECT_EQ(scanner.str(scanner.content(token)), "key \t:  http://host:80  \t");
+  EXPECT_EQ(scanner.key(token).offset, 2u);
+}
+
+TEST_F(YamlScannerTest, SequenceItems) {
+  std::string text = "- name: b\n"
+                     "-   plain  \n"
+                     "-\n"
+                     "- : x\n";
+  YamlScanner scanner(text);
+  EXPECT_EQ(scanner.str(scanner.item(scanner[0])), "name: b");
+  EXPECT_EQ(scanner.str(scanner.itemKey(scanner[0])), "name");
+  EXPECT_EQ(scanner.str(scanner.value(scanner[0])), "b");
+  EXPECT_EQ(scanner.str(scanner.key(scanner[0])), "- name");
+  EXPECT_EQ(scanner.str(scanner.item(scanner[1])), "plain");
+  EXPECT_TRUE(scanner.item(scanner[2]).empty());
+  EXPECT_TRUE(scanner.itemKey(scanner[3]).empty());
+  EXPECT_EQ(scanner.str(scanner.value(scanner[3])), "x");
+}
+
+TEST_F(YamlScannerTest, RootDetectionSkipsBlankAndCommentLines) {
+  std::string seq = "\n# header\n  \n- a\n";
+  EXPECT_TRUE(YamlScanner(seq).startsWithSequence());
+  std::string map = "# - not an item\nkey: - a\n";
+  EXPECT_FALSE(YamlScanner(map).startsWithSequence());
+  std::string none = "\n# only comments\n";
+  EXPECT_FALSE(YamlScanner(none).startsWithSequence());
+}
+
+TEST_F(YamlScannerTest, NextNonBlank) {
+  std::string text = "a:\n\n \n  b: 1\n";
+  YamlScanner scanner(text);
+  EXPECT_EQ(scanner.nextNonBlank(0), 0u);
+  EXPECT_EQ(scanner.nextNonBlank(1), 3u);
+  EXPECT_EQ(scanner.nextNonBlank(4), 4u);
+}
+
+TEST_F(YamlScannerTest, ParserSkipsBlankLinesBeforeNestedBlocks) {
+  // These used to index past a blank line and throw std::out_of_range
+  YamlParser parser;
+  parser.parseString("key:\n\n  a: 1\nother: 2\n");
+  EXPECT_EQ(parser.root().at("key").value.asMap().at("a").value.asInt(), 1);
+  EXPECT_EQ(parser.root().at("other").value.asInt(), 2);
+
+  parser.parseString("key:\n\nother: 2\n");
+  EXPECT_EQ(parser.root().at("key").value.asString(), "");
+
+  parser.parseString("list:\n\n  - x\n  - y\n");
+  EXPECT_EQ(parser.root().at("list").value.asSeq().size(), 2u);
+
+  parser.parseString("a: 1\n\n  - x\nb: 2\n");
+  EXPECT_EQ(parser.root().at("a").value.asInt(), 1);
+  EXPECT_EQ(parser.root().at("b").value.asInt(), 2);
+}
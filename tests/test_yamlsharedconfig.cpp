@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "YamlSharedConfig.hpp"
+#include "YamlException.hpp"
+#include <string>
+
+#if defined(__linux__)
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace yamlparser;
+
+class YamlSharedConfigTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    name = "yamlparser-test-" + std::to_string(static_cast<long>(::getpid()));
+    YamlSharedPublisher::remove(name);
+  }
+
+  void TearDown() override {
+    YamlSharedPublisher::remove(name);
+  }
+
+  static YamlMap makeConfig(int port) {
+    YamlMap server;
+    server["host"] = YamlItem(YamlElement(std::string("localhost")));
+    server["port"] = YamlItem(YamlElement(port));
+    YamlMap root;
+    root["server"] = YamlItem(YamlElement(server));
+    return root;
+  }
+
+  // Creates the control segment the way a publisher does before it writes the header
+  void createControl(const char *magic) {
+    std::string path = "/" + name;
+    int         fd   = ::shm_open(path.c_str(), O_CREAT | O_RDWR, 0644);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::ftruncate(fd, 16), 0);
+    if (magic) {
+      ASSERT_EQ(::write(fd, magic, 8), 8);
+    }
+    ::close(fd);
+  }
+
+  std::string name;
+};
+
+TEST_F(YamlSharedConfigTest, SubscriberBeforePublisherSeesNothing) {
+  YamlSharedSubscriber subscriber(name);
+  EXPECT_EQ(subscriber.current(), nullptr);
+  EXPECT_EQ(subscriber.publishedGeneration(), 0u);
+}
+
+TEST_F(YamlSharedConfigTest, PublishedDocumentIsQueryable) {
+  YamlSharedPublisher publisher(name);
+  EXPECT_EQ(publisher.generation(), 0u);
+  EXPECT_EQ(publisher.publish(makeConfig(8080)), 1u);
+
+  YamlSharedSubscriber subscriber(name);
+  auto                 doc = subscriber.current();
+  ASSERT_NE(doc, nullptr);
+  EXPECT_EQ(doc->generation(), 1u);
+  EXPECT_EQ(doc->get("server").at("port").asInt(), 8080);
+  EXPECT_EQ(doc->root().at("server").at("host").asString(), "localhost");
+  EXPECT_EQ(subscriber.current(), doc); // unchanged generation, same mapping
+}
+
+TEST_F(YamlSharedConfigTest, NewGenerationReplacesOldOne) {
+  YamlSharedPublisher  publisher(name);
+  YamlSharedSubscriber subscriber(name);
+  publisher.publish(makeConfig(1));
+  auto first = subscriber.current();
+  ASSERT_NE(first, nullptr);
+
+  publisher.publish(makeConfig(2));
+  publisher.publish(makeConfig(3));
+  auto latest = subscriber.current();
+  ASSERT_NE(latest, nullptr);
+  EXPECT_EQ(latest->generation(), 3u);
+  EXPECT_EQ(latest->get("server").at("port").asInt(), 3);
+
+  // The old mapping stays valid while it is referenced
+  EXPECT_EQ(first->get("server").at("port").asInt(), 1);
+}
+
+TEST_F(YamlSharedConfigTest, RestartedPublisherContinuesNumbering) {
+  {
+    YamlSharedPublisher publisher(name);
+    publisher.publish(makeConfig(1));
+  }
+  YamlSharedPublisher publisher(name);
+  EXPECT_EQ(publisher.generation(), 1u);
+  EXPECT_EQ(publisher.publish(makeConfig(2)), 2u);
+
+  YamlSharedSubscriber subscriber(name);
+  EXPECT_EQ(subscriber.current()->get("server").at("port").asInt(), 2);
+}
+
+TEST_F(YamlSharedConfigTest, HeaderNotWrittenYetCountsAsUnpublished) {
+  createControl(nullptr);
+  YamlSharedSubscriber subscriber(name);
+  EXPECT_EQ(subscriber.publishedGeneration(), 0u);
+  EXPECT_EQ(subscriber.current(), nullptr);
+
+  // A publisher completes the zero-filled header and the subscriber attaches
+  YamlSharedPublisher publisher(name);
+  EXPECT_EQ(publisher.publish(makeConfig(7)), 1u);
+  ASSERT_NE(subscriber.current(), nullptr);
+  EXPECT_EQ(subscriber.current()->get("server").at("port").asInt(), 7);
+}
+
+TEST_F(YamlSharedConfigTest, ForeignOrIncompatibleSegmentThrows) {
+  createControl("YAMLSHM9");
+  EXPECT_THROW(YamlSharedSubscriber(name).publishedGeneration(), SnapshotException);
+  EXPECT_THROW(YamlSharedPublisher publisher(name), SnapshotException);
+
+  YamlSharedPublisher::remove(name);
+  createControl("NOTYAML!");
+  EXPECT_THROW(YamlSharedSubscriber(name).current(), SnapshotException);
+}
+
+TEST_F(YamlSharedConfigTest, InvalidNameThrows) {
+  EXPECT_THROW(YamlSharedPublisher("bad/name"), SnapshotException);
+  EXPECT_THROW(YamlSharedSubscriber(""), SnapshotException);
+}
+#endif
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "YamlSnapshot.hpp"
+#include "YamlDiff.hpp"
+#include "YamlParser.hpp"
+#include "YamlException.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlSnapshotTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    YamlMap server;
+    server["host"]    = YamlItem(YamlElement(std::string("localhost")));
+    server["port"]    = YamlItem(YamlElement(8080));
+    server["ratio"]   = YamlItem(YamlElement(0.75));
+    server["enabled"] = YamlItem(YamlElement(true));
+    server["empty"]   = YamlItem(YamlElement(std::string()));
+    server["none"]    = YamlItem();
+
+    YamlSeq hosts;
+    hosts.push_back(YamlItem(YamlElement(std::string("a.example"))));
+    hosts.push_back(YamlItem(YamlElement(std::string("b.example"))));
+    hosts.push_back(YamlItem(YamlElement(std::string("localhost")))); // shares a pool entry
+
+    doc["server"] = YamlItem(YamlElement(server));
+    doc["hosts"]  = YamlItem(YamlElement(hosts));
+    doc["name"]   = YamlItem(YamlElement(std::string("demo")));
+  }
+
+  // Copies an image into 8-byte aligned storage, as a mapped file would be
+  static std::vector<std::uint64_t> aligned(const std::string &image) {
+    std::vector<std::uint64_t> storage((image.size() + 7) / 8);
+    std::memcpy(storage.data(), image.data(), image.size());
+    return storage;
+  }
+
+  YamlMap doc;
+};
+
+TEST_F(YamlSnapshotTest, LookupsAnswerFromImage) {
+  std::string                image   = YamlSnapshot::build(doc);
+  std::vector<std::uint64_t> storage = aligned(image);
+  YamlSnapshotView           view(storage.data(), image.size());
+
+  EXPECT_FALSE(view.isSequenceRoot());
+  EXPECT_EQ(view.get("name").asString(), "demo");
+  YamlSnapshotNode server = view.get("server");
+  ASSERT_TRUE(server.isMap());
+  EXPECT_EQ(server.size(), 6u);
+  EXPECT_STREQ(server.at("host").c_str(), "localhost");
+  EXPECT_EQ(server.at("port").asInt(), 8080);
+  EXPECT_DOUBLE_EQ(server.at("ratio").asDouble(), 0.75);
+  EXPECT_TRUE(server.at("enabled").asBool());
+  EXPECT_EQ(server.at("empty").asString(), "");
+  EXPECT_TRUE(server.at("none").isNull());
+  EXPECT_TRUE(server.contains("port"));
+  EXPECT_FALSE(server.contains("por"));
+  EXPECT_FALSE(server.contains("portx"));
+  EXPECT_EQ(server.keyAt(0), "empty"); // keys keep sorted map order
+
+  YamlSnapshotNode hosts = view.get("hosts");
+  ASSERT_TRUE(hosts.isSeq());
+  EXPECT_EQ(hosts.size(), 3u);
+  EXPECT_EQ(hosts.at(1).asString(), "b.example");
+  EXPECT_EQ(view.nodeCount(), 1u + 3u + 6u + 3u);
+}
+
+TEST_F(YamlSnapshotTest, InvalidAccessThrows) {
+  std::string                image   = YamlSnapshot::build(doc);
+  std::vector<std::uint64_t> storage = aligned(image);
+  YamlSnapshotView           view(storage.data(), image.size());
+
+  EXPECT_THROW(view.get("missing"), KeyException);
+  EXPECT_THROW(view.get("hosts").at(3), IndexException);
+  EXPECT_THROW(view.get("hosts").at("x"), TypeException);
+  EXPECT_THROW(view.get("name").asInt(), TypeException);
+  EXPECT_THROW(view.get("name").at(0), TypeException);
+}
+
+TEST_F(YamlSnapshotTest, ToItemReproducesTree) {
+  std::string                image   = YamlSnapshot::build(doc);
+  std::vector<std::uint64_t> storage = aligned(image);
+  YamlSnapshotView           view(storage.data(), image.size());
+
+  YamlItem copy = view.root().toItem();
+  ASSERT_TRUE(copy.value.isMap());
+  EXPECT_EQ(YamlHashTree(copy.value.asMap()).hash(), YamlHashTree(doc).hash());
+}
+
+TEST_F(YamlSnapshotTest, SequenceRootAndScalarRoot) {
+  YamlSeq seq;
+  seq.push_back(YamlItem(YamlElement(1)));
+  seq.push_back(YamlItem(YamlElement(doc)));
+  std::string                image   = YamlSnapshot::build(seq);
+  std::vector<std::uint64_t> storage = aligned(image);
+  YamlSnapshotView           view(storage.data(), image.size());
+  EXPECT_TRUE(view.isSequenceRoot());
+  EXPECT_EQ(view.root().at(1).at("server").at("port").asInt(), 8080);
+  EXPECT_THROW(view.get("server"), TypeException);
+
+  std::string                scalar        = YamlSnapshot::build(YamlItem(YamlElement(-3)));
+  std::vector<std::uint64_t> scalarStorage = aligned(scalar);
+  YamlSnapshotView           scalarView(scalarStorage.data(), scalar.size());
+  EXPECT_EQ(scalarView.root().asInt(), -3);
+}
+
+TEST_F(YamlSnapshotTest, SaveAndMapFile) {
+  const std::string yamlName = "test_snapshot_source.yaml";
+  const std::string snapName = "test_snapshot.snap";
+  {
+    std::ofstream ofs(yamlName);
+    ofs << "service:\n  name: api\n  replicas: 3\nregions:\n  - eu\n  - us\n";
+  }
+  YamlParser parser;
+  parser.parse(yamlName);
+  YamlSnapshot::save(parser.root(), snapName);
+
+  YamlSnapshotView view(snapName);
+  EXPECT_EQ(view.get("service").at("name").asString(), "api");
+  EXPECT_EQ(view.get("service").at("replicas").asInt(), 3);
+  EXPECT_EQ(view.get("regions").at(1).asString(), "us");
+
+  YamlSnapshotView moved(std::move(view));
+  EXPECT_EQ(moved.get("regions").size(), 2u);
+  EXPECT_THROW(view.root(), SnapshotException);
+
+  std::remove(yamlName.c_str());
+  std::remove(snapName.c_str());
+}
+
+TEST_F(YamlSnapshotTest, SaveReplacesMappedFileAtomically) {
+  const std::string snapName = "test_snapshot_replace.snap";
+  YamlSnapshot::save(doc, snapName);
+  YamlSnapshotView before(snapName);
+
+  // A much smaller image: rewriting the mapped file in place would cut the old view short
+  YamlMap next;
+  next["name"] = YamlItem(YamlElement(std::string("next")));
+  YamlSnapshot::save(next, snapName);
+
+  EXPECT_EQ(before.get("name").asString(), "demo");
+  EXPECT_EQ(before.get("server").at("host").asString(), "localhost");
+  EXPECT_EQ(before.get("server").at("port").asInt(), 8080);
+  EXPECT_EQ(before.get("hosts").at(1).asString(), "b.example");
+  YamlItem copy = before.root().toItem();
+  ASSERT_TRUE(copy.value.isMap());
+  EXPECT_EQ(YamlHashTree(copy.value.asMap()).hash(), YamlHashTree(doc).hash());
+
+  YamlSnapshotView after(snapName);
+  EXPECT_EQ(after.get("name").asString(), "next");
+  EXPECT_EQ(after.root().size(), 1u);
+
+  EXPECT_THROW(YamlSnapshot::save(next, "no_such_directory/test.snap"), OutputException);
+  std::remove(snapName.c_str());
+}
+
+TEST_F(YamlSnapshotTest, RejectsCorruptImages) {
+  std::string image = YamlSnapshot::build(doc);
+
+  std::string badMagic = image;
+  badMagic[0]          = 'X';
+
+  std::vector<std::uint64_t> s1 = aligned(badMagic);
+  EXPECT_THROW(YamlSnapshotView(s1.data(), badMagic.size()), SnapshotException);
+
+  std::vector<std::uint64_t> s2 = aligned(image);
+  EXPECT_THROW(YamlSnapshotView(s2.data(), image.size() - 1), SnapshotException);
+
+  // Point the root's first child back at the root itself
+  std::string   cyclic = image;
+  std::uint64_t self   = 0;
+  std::memcpy(&cyclic[32 + 16], &self, sizeof(self));
+  std::vector<std::uint64_t> s3 = aligned(cyclic);
+  EXPECT_THROW(YamlSnapshotView(s3.data(), cyclic.size()), SnapshotException);
+
+  // Move the root's key offset past the end of the pool
+  std::string   badKey = image;
+  std::uint32_t offset = 0xFFFFFFF0u;
+  std::memcpy(&badKey[32 + 4], &offset, sizeof(offset));
+  std::vector<std::uint64_t> s4 = aligned(badKey);
+  EXPECT_THROW(YamlSnapshotView(s4.data(), badKey.size()), SnapshotException);
+
+  EXPECT_THROW(YamlSnapshotView("no_such_snapshot.snap"), FileException);
+}
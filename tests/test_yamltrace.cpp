@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "YamlTrace.hpp"
+#include "YamlParser.hpp"
+#include "YamlPrinter.hpp"
+#include "YamlException.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace yamlparser;
+
+class YamlTraceTest : public ::testing::Test {
+protected:
+  const std::string yamlName  = "test_trace_input.yaml";
+  const std::string traceName = "test_trace_output.json";
+
+  void TearDown() override {
+    std::remove(yamlName.c_str());
+    std::remove(traceName.c_str());
+  }
+
+  // Returns the first event with the given name, failing the test if there is none
+  static YamlTraceEvent find(const YamlTracer &tracer, const std::string &name) {
+    for (const auto &event : tracer.events())
+      if (event.name == name)
+        return event;
+    ADD_FAILURE() << "no event named '" << name << "'";
+    return YamlTraceEvent();
+  }
+
+  static size_t count(const YamlTracer &tracer, const std::string &category) {
+    size_t n = 0;
+    for (const auto &event : tracer.events())
+      n += std::string(event.category) == category;
+    return n;
+  }
+
+  YamlParser parser;
+};
+
+TEST_F(YamlTraceTest, NothingRecordedWithoutScope) {
+  YamlTracer tracer;
+  parser.parseString("a: 1\n");
+  EXPECT_TRUE(tracer.events().empty());
+  EXPECT_EQ(currentTracer(), nullptr);
+}
+
+TEST_F(YamlTraceTest, ScopesNest) {
+  YamlTracer outer, inner;
+  {
+    YamlTraceScope scope(&outer);
+    {
+      YamlTraceScope nested(&inner);
+      EXPECT_EQ(currentTracer(), &inner);
+      YamlTraceScope disabled(nullptr);
+      parser.parseString("a: 1\n");
+    }
+    EXPECT_EQ(currentTracer(), &outer);
+  }
+  EXPECT_TRUE(inner.events().empty());
+  EXPECT_TRUE(outer.events().empty());
+}
+
+TEST_F(YamlTraceTest, ParseRecordsPhasesSectionsAndResolution) {
+  YamlTracer tracer;
+  {
+    YamlTraceScope scope(&tracer);
+    parser.parseString("base: &base\n"
+                       "  x: 1\n"
+                       "  y: 2\n"
+                       "\n"
+                       "copy: *base\n"
+                       "derived:\n"
+                       "  <<: *base\n"
+                       "  z: 3\n");
+  }
+  YamlTraceEvent scan = find(tracer, "tokenize");
+  EXPECT_STREQ(scan.category, "scan");
+  EXPECT_EQ(scan.lastLine, 8u);
+
+  YamlTraceEvent build = find(tracer, "parseMap");
+  EXPECT_STREQ(build.category, "build");
+  EXPECT_EQ(build.firstLine, 1u);
+  EXPECT_EQ(build.lastLine, 8u);
+
+  YamlTraceEvent base = find(tracer, "base");
+  EXPECT_STREQ(base.category, "section");
+  EXPECT_EQ(base.firstLine, 1u);
+  EXPECT_GE(base.lastLine, 3u);
+  YamlTraceEvent derived = find(tracer, "derived");
+  EXPECT_EQ(derived.firstLine, 6u);
+  EXPECT_EQ(derived.lastLine, 8u);
+  // Only top-level keys by default
+  EXPECT_EQ(count(tracer, "section"), 3u);
+
+  YamlTraceEvent alias = find(tracer, "alias");
+  EXPECT_STREQ(alias.category, "resolve");
+  EXPECT_EQ(alias.firstLine, 5u);
+  EXPECT_EQ(alias.detail, "*base");
+  YamlTraceEvent merge = find(tracer, "merge");
+  EXPECT_EQ(merge.firstLine, 7u);
+  EXPECT_EQ(merge.detail, "*base");
+
+  // Sections lie within the build phase, which follows the scan
+  EXPECT_GE(base.startMicros, build.startMicros);
+  EXPECT_LE(base.startMicros + base.durationMicros, build.startMicros + build.durationMicros);
+  EXPECT_GE(build.startMicros, scan.startMicros + scan.durationMicros);
+}
+
+TEST_F(YamlTraceTest, SectionDepthControlsNestedEvents) {
+  const std::string doc = "outer:\n"
+                          "  inner:\n"
+                          "    leaf: 1\n"
+                          "  other: 2\n";
+  YamlTracer deep(2), none(0);
+  {
+    YamlTraceScope scope(&deep);
+    parser.parseString(doc);
+  }
+  {
+    YamlTraceScope scope(&none);
+    parser.parseString(doc);
+  }
+  EXPECT_EQ(count(deep, "section"), 3u);
+  EXPECT_EQ(find(deep, "inner").firstLine, 2u);
+  EXPECT_EQ(count(none, "section"), 0u);
+  EXPECT_EQ(count(none, "build"), 1u);
+}
+
+TEST_F(YamlTraceTest, SequenceItemsAreNamedByIndex) {
+  YamlTracer tracer;
+  {
+    YamlTraceScope scope(&tracer);
+    parser.parseString("- one\n"
+                       "\n"
+                       "- name: two\n"
+                       "  size: 2\n");
+  }
+  EXPECT_STREQ(find(tracer, "parseSeq").category, "build");
+  YamlTraceEvent second = find(tracer, "[1]");
+  EXPECT_EQ(second.firstLine, 3u);
+  EXPECT_EQ(second.lastLine, 4u);
+  // The blank line is not an item
+  EXPECT_EQ(count(tracer, "section"), 2u);
+}
+
+TEST_F(YamlTraceTest, FileReadAndPrintingAreRecorded) {
+  {
+    std::ofstream ofs(yamlName);
+    ofs << "key: value\n";
+  }
+  YamlTracer tracer;
+  {
+    YamlTraceScope scope(&tracer);
+    parser.parse(yamlName);
+    std::ostringstream out;
+    YamlPrinter::print(parser.root(), out);
+    YamlPrinter::toString(parser.root());
+  }
+  YamlTraceEvent read = find(tracer, "read");
+  EXPECT_STREQ(read.category, "io");
+  EXPECT_EQ(read.detail, yamlName);
+  EXPECT_EQ(count(tracer, "print"), 2u);
+  find(tracer, "YamlPrinter::toString");
+}
+
+TEST_F(YamlTraceTest, EventsAreKeptWhenParsingFails) {
+  YamlTracer tracer;
+  {
+    YamlTraceScope scope(&tracer);
+    EXPECT_THROW(parser.parseString("a: 1\n"
+                                    "b: [1, 2\n"),
+                 SyntaxException);
+  }
+  EXPECT_EQ(count(tracer, "build"), 1u);
+  // The failing entry is recorded too
+  EXPECT_EQ(count(tracer, "section"), 2u);
+}
+
+TEST_F(YamlTraceTest, ThreadsAreNumbered) {
+  YamlTracer tracer;
+  auto       work = [&tracer]() {
+    YamlTraceScope scope(&tracer);
+    YamlParser     local;
+    local.parseString("a: 1\n");
+  };
+  work();
+  std::thread other(work);
+  other.join();
+  std::vector<unsigned> threads;
+  for (const auto &event : tracer.events())
+    if (event.name == "parseMap")
+      threads.push_back(event.thread);
+  ASSERT_EQ(threads.size(), 2u);
+  EXPECT_EQ(threads[0], 1u);
+  EXPECT_EQ(threads[1], 2u);
+}
+
+TEST_F(YamlTraceTest, WritesChromeTraceJson) {
+  YamlTracer tracer;
+  {
+    YamlTraceScope scope(&tracer);
+    parser.parseString("\"quoted\\\"key\": 1\n");
+  }
+  std::ostringstream out;
+  tracer.write(out);
+  std::string json = out.str();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"process_name\""), std::string::npos);
+  EXPECT_NE(json.find("\"first_line\":1"), std::string::npos);
+  EXPECT_NE(json.find("\"cat\":\"section\""), std::string::npos);
+  // Names are escaped
+  EXPECT_NE(json.find("\\\"key"), std::string::npos);
+
+  tracer.writeFile(traceName);
+  std::ifstream      file(traceName);
+  std::ostringstream content;
+  content << file.rdbuf();
+  EXPECT_EQ(content.str(), json);
+
+  tracer.clear();
+  EXPECT_TRUE(tracer.events().empty());
+}
+
+TEST_F(YamlTraceTest, WriteFileToMissingDirectoryThrows) {
+  YamlTracer tracer;
+  EXPECT_THROW(tracer.writeFile("no_such_directory/trace.json"), FileException);
+}
@@ -0,0 +1,80 @@
+#include "YamlLinter.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// yamlparser_lint - validate many YAML files in one pass and report every problem
+//
+// Usage: yamlparser_lint [options] FILE... | -
+//   --threads N    worker threads (default: one per hardware thread)
+//   --quiet        print the summary only
+//   -              read the file names from standard input, one per line,
+//                  e.g. git ls-files '*.yaml' '*.yml' | yamlparser_lint -
+//
+// Diagnostics are printed as "file:line: message", in the order the files
+// were given, followed by a summary with the throughput on standard error.
+// Exit status: 0 no problems, 1 problems found, 2 usage error.
+
+using namespace yamlparser;
+
+namespace {
+
+struct Options {
+  size_t                   threads = 0;
+  bool                     quiet   = false;
+  std::vector<std::string> files;
+};
+
+void usage() {
+  std::cerr << "usage: yamlparser_lint [--threads N] [--quiet] FILE... | -\n";
+}
+
+bool parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--quiet") {
+      opts.quiet = true;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      opts.threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-") {
+      std::string line;
+      while (std::getline(std::cin, line)) {
+        if (!line.empty())
+          opts.files.push_back(line);
+      }
+    } else if (arg.compare(0, 2, "--") == 0) {
+      usage();
+      return false;
+    } else {
+      opts.files.push_back(arg);
+    }
+  }
+  if (opts.files.empty()) {
+    usage();
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parseArgs(argc, argv, opts))
+    return 2;
+
+  YamlLinter     linter;
+  YamlLintReport report = linter.lintFiles(opts.files, opts.threads);
+  if (!opts.quiet) {
+    for (const YamlDiagnostic &diagnostic : report.diagnostics)
+      std::cout << diagnostic.str() << "\n";
+  }
+  std::cerr << report.files << " files, " << report.bytes << " bytes: " << report.diagnostics.size()
+            << " problems in " << report.failedFiles << " files\n"
+            << std::fixed << std::setprecision(3) << report.seconds << " s on " << report.threads << " threads, "
+            << std::setprecision(1) << report.megabytesPerSecond() << " MB/s, " << report.filesPerSecond()
+            << " files/s\n";
+  return report.ok() ? 0 : 1;
+}